@@ -0,0 +1,43 @@
+#ifndef DECLARED_CONFIG_STRUCT
+#define DECLARED_CONFIG_STRUCT
+
+// Same parameters as single_config_test.h, in an order that needs padding:
+#define DECLARED_TEST_FIELDS(FIELD, STRUCT)                                  \
+	FIELD(STRUCT, char  , parameter_char  , 1, 1, -FLT_MAX, FLT_MAX)         \
+	FIELD(STRUCT, string, parameter_string, 1, 1, -FLT_MAX, FLT_MAX)         \
+	FIELD(STRUCT, bool  , parameter_bool  , 1, 1, -FLT_MAX, FLT_MAX)         \
+	FIELD(STRUCT, float , parameter_float , 1, 1, -FLT_MAX, FLT_MAX)         \
+	FIELD(STRUCT, int   , parameter_int   , 1, 1, -FLT_MAX, FLT_MAX)
+
+DECLARE_CONFIG_STRUCT(declared_test_config_s, DECLARED_TEST_FIELDS)
+
+#else
+
+// Parameters:
+DECLARE_CONFIG_PARAMETERS(declared, declared_test_config_s, DECLARED_TEST_FIELDS)
+
+parameter_s default_parameter = 
+	{"default_parameter", none_e, 0, 0, 0.0f, 0.0f};
+
+loader_config_s loader_config = 
+{
+	.name                   = "simple_config_example",
+	.name_necessity         = required_e,
+
+	.is_superconfig         = false,
+	.has_parameters         = true,
+    .reorder                = false,
+	.min                    = 1,
+    .max                    = 1,
+	.early_exit_index       = INT32_MAX,
+
+	CONFIG_DECLARED_LAYOUT(declared, declared_test_config_s),
+	.min_inputed_parameters = 0,
+	.max_inputed_parameters = CONFIG_DECLARED_NUM_PARAMETERS(declared),
+	
+	.min_extra_parameters   = 0,
+	.max_extra_parameters   = 0,
+	.default_parameter      = default_parameter
+};
+
+#endif
@@ -0,0 +1,941 @@
+#ifndef COMPLEX_TEST_HASH_H
+#define COMPLEX_TEST_HASH_H
+
+// Generated by src/perfect_hash_generator.c from complex_test.h, do not edit,
+// rerun make perfect_hash after changing the schema.
+
+#include "io_tools/custom_types.h"
+
+static const char *complex_test_hash_0_slot_keys[] =
+{
+	"waveforms",
+	"network",
+	"examples",
+	"noise",
+	"debug"
+};
+
+static const char *complex_test_hash_0_keys[] =
+{
+	"network",
+	"waveforms",
+	"noise",
+	"examples",
+	"debug"
+};
+
+static const uint32_t complex_test_hash_0_slot_lengths[] =
+{
+	9, 7, 8, 5, 5
+};
+
+static const int32_t complex_test_hash_0_slot_indices[] =
+{
+	1, 0, 3, 2, 4
+};
+
+static const uint32_t complex_test_hash_0_displacements[] =
+{
+	0, 3, 4
+};
+
+static const char *complex_test_hash_1_slot_keys[] =
+{
+	"equatorial_radius",
+	"num_dimensions",
+	"speed_of_light",
+	"polar_radius"
+};
+
+static const char *complex_test_hash_1_keys[] =
+{
+	"speed_of_light",
+	"equatorial_radius",
+	"polar_radius",
+	"num_dimensions"
+};
+
+static const uint32_t complex_test_hash_1_slot_lengths[] =
+{
+	17, 14, 14, 12
+};
+
+static const int32_t complex_test_hash_1_slot_indices[] =
+{
+	1, 3, 0, 2
+};
+
+static const uint32_t complex_test_hash_1_displacements[] =
+{
+	5, 0
+};
+
+static const char *complex_test_hash_2_slot_keys[] =
+{
+	"detectors"
+};
+
+static const char *complex_test_hash_2_keys[] =
+{
+	"detectors"
+};
+
+static const uint32_t complex_test_hash_2_slot_lengths[] =
+{
+	9
+};
+
+static const int32_t complex_test_hash_2_slot_indices[] =
+{
+	0
+};
+
+static const uint32_t complex_test_hash_2_displacements[] =
+{
+	0
+};
+
+static const char *complex_test_hash_3_slot_keys[] =
+{
+	"name",
+	"up_direction",
+	"x_arm_bearing",
+	"y_arm_bearing",
+	"noise_profile_length",
+	"longitude",
+	"noise_profile_frequency",
+	"position_sphere",
+	"interpolated_noise_profile_length",
+	"x_arm_direction",
+	"sensitivity",
+	"noise_amplitude",
+	"noise_profile_strain",
+	"interpolated_noise_profile",
+	"active",
+	"y_arm_direction",
+	"height_above_sea_level",
+	"latitude",
+	"position"
+};
+
+static const char *complex_test_hash_3_keys[] =
+{
+	"name",
+	"position",
+	"position_sphere",
+	"latitude",
+	"longitude",
+	"noise_profile_strain",
+	"noise_profile_frequency",
+	"interpolated_noise_profile",
+	"x_arm_direction",
+	"y_arm_direction",
+	"up_direction",
+	"height_above_sea_level",
+	"sensitivity",
+	"noise_amplitude",
+	"noise_profile_length",
+	"interpolated_noise_profile_length",
+	"x_arm_bearing",
+	"y_arm_bearing",
+	"active"
+};
+
+static const uint32_t complex_test_hash_3_slot_lengths[] =
+{
+	4, 12, 13, 13, 20, 9, 23, 15, 33, 15, 11, 15, 20, 26, 6, 15, 22, 8, 8
+};
+
+static const int32_t complex_test_hash_3_slot_indices[] =
+{
+	0, 10, 16, 17, 14, 4, 6, 2, 15, 8, 12, 13, 5, 7, 18, 9, 11, 3, 1
+};
+
+static const uint32_t complex_test_hash_3_displacements[] =
+{
+	0, 9, 0, 26, 23, 6, 2, 13, 18, 0
+};
+
+static const char *complex_test_hash_4_slot_keys[] =
+{
+	"subwaveforms_per_stream_sigma",
+	"subwaveforms_per_stream_max",
+	"min_num_repeats",
+	"max_duration",
+	"subwaveforms_per_stream_min",
+	"num_subwaveforms",
+	"min_duration",
+	"max_num_repeats",
+	"sample_rate",
+	"subwaveforms_per_stream_mu",
+	"num_subwaveform_layers",
+	"name"
+};
+
+static const char *complex_test_hash_4_keys[] =
+{
+	"name",
+	"sample_rate",
+	"min_duration",
+	"max_duration",
+	"subwaveforms_per_stream_mu",
+	"subwaveforms_per_stream_sigma",
+	"subwaveforms_per_stream_min",
+	"subwaveforms_per_stream_max",
+	"num_subwaveforms",
+	"num_subwaveform_layers",
+	"min_num_repeats",
+	"max_num_repeats"
+};
+
+static const uint32_t complex_test_hash_4_slot_lengths[] =
+{
+	29, 27, 15, 12, 27, 16, 12, 15, 11, 26, 22, 4
+};
+
+static const int32_t complex_test_hash_4_slot_indices[] =
+{
+	5, 7, 10, 3, 6, 8, 2, 11, 1, 4, 9, 0
+};
+
+static const uint32_t complex_test_hash_4_displacements[] =
+{
+	1, 0, 3, 5, 14, 138
+};
+
+static const char *complex_test_hash_5_slot_keys[] =
+{
+	"iota_min",
+	"mass_2_min",
+	"distance_min",
+	"k_min",
+	"frequency_max",
+	"sigma_max",
+	"max_mass_ratio",
+	"iota_max",
+	"frequency_min",
+	"phaze_max",
+	"sigma_min",
+	"mass_1_min",
+	"a_min",
+	"active",
+	"k_max",
+	"distribution_type",
+	"mass_1_max",
+	"name",
+	"distance_max",
+	"power_min",
+	"layer",
+	"power_max",
+	"phaze_min",
+	"path",
+	"mass_2_max",
+	"a_max"
+};
+
+static const char *complex_test_hash_5_keys[] =
+{
+	"name",
+	"path",
+	"mass_1_min",
+	"mass_1_max",
+	"mass_2_min",
+	"mass_2_max",
+	"iota_min",
+	"iota_max",
+	"distance_min",
+	"distance_max",
+	"sigma_min",
+	"sigma_max",
+	"power_min",
+	"power_max",
+	"a_min",
+	"a_max",
+	"phaze_min",
+	"phaze_max",
+	"frequency_min",
+	"frequency_max",
+	"max_mass_ratio",
+	"distribution_type",
+	"k_max",
+	"k_min",
+	"layer",
+	"active"
+};
+
+static const uint32_t complex_test_hash_5_slot_lengths[] =
+{
+	8, 10, 12, 5, 13, 9, 14, 8, 13, 9, 9, 10, 5, 6, 5, 17, 10, 4, 12, 9, 5, 9, 9, 4, 10, 5
+};
+
+static const int32_t complex_test_hash_5_slot_indices[] =
+{
+	6, 4, 8, 23, 19, 11, 20, 7, 18, 17, 10, 2, 14, 25, 22, 21, 3, 0, 9, 12, 24, 13, 16, 1, 5, 15
+};
+
+static const uint32_t complex_test_hash_5_displacements[] =
+{
+	20, 2, 3, 3, 22, 1, 7, 98, 0, 0, 20, 0, 0
+};
+
+static const char *complex_test_hash_6_slot_keys[] =
+{
+	"inspiral",
+	"imrphenomd",
+	"possion_window",
+	"triangular_wave",
+	"triangular_window",
+	"welch_window",
+	"saw_wave",
+	"rectangular_window",
+	"sine_wave",
+	"tukey_window",
+	"load",
+	"gaussian_window",
+	"sine_window",
+	"power_sine_window",
+	"cosine_sum_window"
+};
+
+static const char *complex_test_hash_6_keys[] =
+{
+	"gaussian_window",
+	"triangular_window",
+	"welch_window",
+	"rectangular_window",
+	"sine_window",
+	"power_sine_window",
+	"cosine_sum_window",
+	"tukey_window",
+	"possion_window",
+	"sine_wave",
+	"triangular_wave",
+	"saw_wave",
+	"inspiral",
+	"imrphenomd",
+	"load"
+};
+
+static const uint32_t complex_test_hash_6_slot_lengths[] =
+{
+	8, 10, 14, 15, 17, 12, 8, 18, 9, 12, 4, 15, 11, 17, 17
+};
+
+static const int32_t complex_test_hash_6_slot_indices[] =
+{
+	12, 13, 8, 10, 1, 2, 11, 3, 9, 7, 14, 0, 4, 5, 6
+};
+
+static const uint32_t complex_test_hash_6_displacements[] =
+{
+	0, 1, 3, 5, 1, 7, 2, 2
+};
+
+static const char *complex_test_hash_7_slot_keys[] =
+{
+	"amplitude_sigma",
+	"type",
+	"active",
+	"amplitude_mu",
+	"name",
+	"amplitude_min",
+	"amplitude_max"
+};
+
+static const char *complex_test_hash_7_keys[] =
+{
+	"name",
+	"amplitude_sigma",
+	"amplitude_mu",
+	"amplitude_min",
+	"amplitude_max",
+	"type",
+	"active"
+};
+
+static const uint32_t complex_test_hash_7_slot_lengths[] =
+{
+	15, 4, 6, 12, 4, 13, 13
+};
+
+static const int32_t complex_test_hash_7_slot_indices[] =
+{
+	1, 5, 6, 2, 0, 3, 4
+};
+
+static const uint32_t complex_test_hash_7_displacements[] =
+{
+	0, 1, 0, 21
+};
+
+static const char *complex_test_hash_8_slot_keys[] =
+{
+	"injections",
+	"coherence_groups",
+	"snr_groups"
+};
+
+static const char *complex_test_hash_8_keys[] =
+{
+	"snr_groups",
+	"coherence_groups",
+	"injections"
+};
+
+static const uint32_t complex_test_hash_8_slot_lengths[] =
+{
+	10, 16, 10
+};
+
+static const int32_t complex_test_hash_8_slot_indices[] =
+{
+	2, 1, 0
+};
+
+static const uint32_t complex_test_hash_8_displacements[] =
+{
+	0, 1
+};
+
+static const char *complex_test_hash_9_slot_keys[] =
+{
+	"active",
+	"name",
+	"num_injection_types",
+	"label",
+	"num_streams",
+	"add_injections",
+	"add_noise",
+	"noise_type"
+};
+
+static const char *complex_test_hash_9_keys[] =
+{
+	"name",
+	"label",
+	"num_injection_types",
+	"num_streams",
+	"noise_type",
+	"active",
+	"add_injections",
+	"add_noise"
+};
+
+static const uint32_t complex_test_hash_9_slot_lengths[] =
+{
+	6, 4, 19, 5, 11, 14, 9, 10
+};
+
+static const int32_t complex_test_hash_9_slot_indices[] =
+{
+	5, 0, 2, 1, 3, 6, 7, 4
+};
+
+static const uint32_t complex_test_hash_9_displacements[] =
+{
+	2, 10, 2, 0
+};
+
+static const char *complex_test_hash_10_slot_keys[] =
+{
+	"back_padding",
+	"injections_per_stream_sigma",
+	"center_time_min",
+	"subinjections_per_stream_max",
+	"injections_per_stream_min",
+	"num_unique_snr_groups",
+	"subinjections_per_stream_sigma",
+	"num_streams",
+	"name",
+	"num_injection_types",
+	"snr_min",
+	"injections_per_stream_max",
+	"num_coherence_groups",
+	"snr_distribution",
+	"snr_mu",
+	"num_snr_groups",
+	"num_unique_coherence_groups",
+	"num_detectors",
+	"stream_sample_rate",
+	"subinjections_per_stream_min",
+	"snr_sigma",
+	"debug_directory_path",
+	"center_time_max",
+	"injections_per_stream_mu",
+	"snr_max",
+	"subinjections_per_stream_mu",
+	"front_padding",
+	"stream_length",
+	"num_segments",
+	"segment_length",
+	"num_injections"
+};
+
+static const char *complex_test_hash_10_keys[] =
+{
+	"name",
+	"debug_directory_path",
+	"snr_mu",
+	"snr_sigma",
+	"snr_min",
+	"snr_max",
+	"injections_per_stream_mu",
+	"injections_per_stream_sigma",
+	"injections_per_stream_min",
+	"injections_per_stream_max",
+	"subinjections_per_stream_mu",
+	"subinjections_per_stream_sigma",
+	"subinjections_per_stream_min",
+	"subinjections_per_stream_max",
+	"front_padding",
+	"back_padding",
+	"stream_sample_rate",
+	"center_time_min",
+	"center_time_max",
+	"stream_length",
+	"num_streams",
+	"num_detectors",
+	"num_injections",
+	"num_injection_types",
+	"num_coherence_groups",
+	"num_unique_coherence_groups",
+	"num_snr_groups",
+	"num_unique_snr_groups",
+	"num_segments",
+	"segment_length",
+	"snr_distribution"
+};
+
+static const uint32_t complex_test_hash_10_slot_lengths[] =
+{
+	12, 27, 15, 28, 25, 21, 30, 11, 4, 19, 7, 25, 20, 16, 6, 14, 27, 13, 18, 28, 9, 20, 15, 24, 7, 27, 13, 13, 12, 14, 14
+};
+
+static const int32_t complex_test_hash_10_slot_indices[] =
+{
+	15, 7, 17, 13, 8, 27, 11, 20, 0, 23, 4, 9, 24, 30, 2, 26, 25, 21, 16, 12, 3, 1, 18, 6, 5, 10, 14, 19, 28, 29, 22
+};
+
+static const uint32_t complex_test_hash_10_displacements[] =
+{
+	2, 6, 0, 0, 0, 37, 7, 8, 46, 0, 1, 0, 6, 1, 0, 0
+};
+
+static const char *complex_test_hash_11_slot_keys[] =
+{
+	"waveform_index",
+	"snr_group",
+	"name",
+	"snr_adjust",
+	"source_type",
+	"used_in_snr",
+	"coherence_group",
+	"add_time_difference",
+	"simulate_detector_response",
+	"active",
+	"simulate_orientation_response",
+	"use_network_snr",
+	"simulate_polarisation_response"
+};
+
+static const char *complex_test_hash_11_keys[] =
+{
+	"name",
+	"waveform_index",
+	"coherence_group",
+	"snr_group",
+	"source_type",
+	"active",
+	"add_time_difference",
+	"simulate_detector_response",
+	"simulate_polarisation_response",
+	"simulate_orientation_response",
+	"snr_adjust",
+	"used_in_snr",
+	"use_network_snr"
+};
+
+static const uint32_t complex_test_hash_11_slot_lengths[] =
+{
+	14, 9, 4, 10, 11, 11, 15, 19, 26, 6, 29, 15, 30
+};
+
+static const int32_t complex_test_hash_11_slot_indices[] =
+{
+	1, 3, 0, 10, 4, 11, 2, 6, 7, 5, 9, 12, 8
+};
+
+static const uint32_t complex_test_hash_11_displacements[] =
+{
+	0, 1, 3, 0, 1, 1, 16
+};
+
+static const char *complex_test_hash_12_slot_keys[] =
+{
+	"name",
+	"snr_min",
+	"snr_max",
+	"snr_mu",
+	"snr_sigma"
+};
+
+static const char *complex_test_hash_12_keys[] =
+{
+	"name",
+	"snr_mu",
+	"snr_sigma",
+	"snr_min",
+	"snr_max"
+};
+
+static const uint32_t complex_test_hash_12_slot_lengths[] =
+{
+	4, 7, 7, 6, 9
+};
+
+static const int32_t complex_test_hash_12_slot_indices[] =
+{
+	0, 3, 4, 1, 2
+};
+
+static const uint32_t complex_test_hash_12_displacements[] =
+{
+	0, 9, 9
+};
+
+static const char *complex_test_hash_13_slot_keys[] =
+{
+	"name",
+	"source_type",
+	"config_index"
+};
+
+static const char *complex_test_hash_13_keys[] =
+{
+	"name",
+	"source_type",
+	"config_index"
+};
+
+static const uint32_t complex_test_hash_13_slot_lengths[] =
+{
+	4, 11, 12
+};
+
+static const int32_t complex_test_hash_13_slot_indices[] =
+{
+	0, 1, 2
+};
+
+static const uint32_t complex_test_hash_13_displacements[] =
+{
+	1, 4
+};
+
+static const char *complex_test_hash_14_slot_keys[] =
+{
+	"active",
+	"plot_metrics",
+	"write_interpolation",
+	"write_locations",
+	"plot_psd",
+	"write",
+	"num_write",
+	"print_memory",
+	"plot_snr",
+	"write_snr",
+	"write_samples",
+	"plot_predictions",
+	"num_plot",
+	"plot",
+	"plot_locations",
+	"write_psd",
+	"print_depth",
+	"plot_samples",
+	"num_print",
+	"print",
+	"write_predictions",
+	"plot_interpolation"
+};
+
+static const char *complex_test_hash_14_keys[] =
+{
+	"num_plot",
+	"num_write",
+	"num_print",
+	"print_depth",
+	"active",
+	"plot",
+	"plot_samples",
+	"plot_locations",
+	"plot_psd",
+	"plot_snr",
+	"plot_interpolation",
+	"plot_predictions",
+	"plot_metrics",
+	"write",
+	"write_samples",
+	"write_locations",
+	"write_psd",
+	"write_snr",
+	"write_interpolation",
+	"write_predictions",
+	"print",
+	"print_memory"
+};
+
+static const uint32_t complex_test_hash_14_slot_lengths[] =
+{
+	6, 12, 19, 15, 8, 5, 9, 12, 8, 9, 13, 16, 8, 4, 14, 9, 11, 12, 9, 5, 17, 18
+};
+
+static const int32_t complex_test_hash_14_slot_indices[] =
+{
+	4, 12, 18, 15, 8, 13, 1, 21, 9, 17, 14, 11, 0, 5, 7, 16, 3, 6, 2, 20, 19, 10
+};
+
+static const uint32_t complex_test_hash_14_displacements[] =
+{
+	0, 2, 2, 1, 5, 0, 1, 1, 4, 10, 27
+};
+
+static const char *complex_test_hash_15_slot_keys[] =
+{
+	"localisation",
+	"waveform",
+	"snr",
+	"physicalisation",
+	"detector",
+	"noise"
+};
+
+static const char *complex_test_hash_15_keys[] =
+{
+	"detector",
+	"noise",
+	"waveform",
+	"localisation",
+	"snr",
+	"physicalisation"
+};
+
+static const uint32_t complex_test_hash_15_slot_lengths[] =
+{
+	12, 8, 3, 15, 8, 5
+};
+
+static const int32_t complex_test_hash_15_slot_indices[] =
+{
+	3, 2, 4, 5, 0, 1
+};
+
+static const uint32_t complex_test_hash_15_displacements[] =
+{
+	15, 7, 0
+};
+
+static const perfect_hash_s complex_test_hashes[] =
+{
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_0_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_0_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x3607404839ce94a6ull,
+		.displacements = complex_test_hash_0_displacements,
+		.slot_keys     = complex_test_hash_0_slot_keys,
+		.slot_lengths  = complex_test_hash_0_slot_lengths,
+		.slot_indices  = complex_test_hash_0_slot_indices,
+		.keys          = complex_test_hash_0_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_1_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_1_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x3cbab6ff79d7e194ull,
+		.displacements = complex_test_hash_1_displacements,
+		.slot_keys     = complex_test_hash_1_slot_keys,
+		.slot_lengths  = complex_test_hash_1_slot_lengths,
+		.slot_indices  = complex_test_hash_1_slot_indices,
+		.keys          = complex_test_hash_1_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_2_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_2_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xc8057a6826f7717bull,
+		.displacements = complex_test_hash_2_displacements,
+		.slot_keys     = complex_test_hash_2_slot_keys,
+		.slot_lengths  = complex_test_hash_2_slot_lengths,
+		.slot_indices  = complex_test_hash_2_slot_indices,
+		.keys          = complex_test_hash_2_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_3_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_3_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x11a0b1da9afcad99ull,
+		.displacements = complex_test_hash_3_displacements,
+		.slot_keys     = complex_test_hash_3_slot_keys,
+		.slot_lengths  = complex_test_hash_3_slot_lengths,
+		.slot_indices  = complex_test_hash_3_slot_indices,
+		.keys          = complex_test_hash_3_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_4_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_4_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xf8bc5d1d7dd978fdull,
+		.displacements = complex_test_hash_4_displacements,
+		.slot_keys     = complex_test_hash_4_slot_keys,
+		.slot_lengths  = complex_test_hash_4_slot_lengths,
+		.slot_indices  = complex_test_hash_4_slot_indices,
+		.keys          = complex_test_hash_4_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_5_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_5_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xa97535550d831fdeull,
+		.displacements = complex_test_hash_5_displacements,
+		.slot_keys     = complex_test_hash_5_slot_keys,
+		.slot_lengths  = complex_test_hash_5_slot_lengths,
+		.slot_indices  = complex_test_hash_5_slot_indices,
+		.keys          = complex_test_hash_5_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_6_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_6_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xbc4e00282087c36cull,
+		.displacements = complex_test_hash_6_displacements,
+		.slot_keys     = complex_test_hash_6_slot_keys,
+		.slot_lengths  = complex_test_hash_6_slot_lengths,
+		.slot_indices  = complex_test_hash_6_slot_indices,
+		.keys          = complex_test_hash_6_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_7_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_7_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x36fd48fab0a6086aull,
+		.displacements = complex_test_hash_7_displacements,
+		.slot_keys     = complex_test_hash_7_slot_keys,
+		.slot_lengths  = complex_test_hash_7_slot_lengths,
+		.slot_indices  = complex_test_hash_7_slot_indices,
+		.keys          = complex_test_hash_7_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_8_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_8_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xf08c6aa291a07d0eull,
+		.displacements = complex_test_hash_8_displacements,
+		.slot_keys     = complex_test_hash_8_slot_keys,
+		.slot_lengths  = complex_test_hash_8_slot_lengths,
+		.slot_indices  = complex_test_hash_8_slot_indices,
+		.keys          = complex_test_hash_8_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_9_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_9_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xdc55ba8e2b633024ull,
+		.displacements = complex_test_hash_9_displacements,
+		.slot_keys     = complex_test_hash_9_slot_keys,
+		.slot_lengths  = complex_test_hash_9_slot_lengths,
+		.slot_indices  = complex_test_hash_9_slot_indices,
+		.keys          = complex_test_hash_9_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_10_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_10_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xbb400225ce9b9dfcull,
+		.displacements = complex_test_hash_10_displacements,
+		.slot_keys     = complex_test_hash_10_slot_keys,
+		.slot_lengths  = complex_test_hash_10_slot_lengths,
+		.slot_indices  = complex_test_hash_10_slot_indices,
+		.keys          = complex_test_hash_10_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_11_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_11_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x68aad028bbd4c0b9ull,
+		.displacements = complex_test_hash_11_displacements,
+		.slot_keys     = complex_test_hash_11_slot_keys,
+		.slot_lengths  = complex_test_hash_11_slot_lengths,
+		.slot_indices  = complex_test_hash_11_slot_indices,
+		.keys          = complex_test_hash_11_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_12_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_12_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x7ec6aa50f341d03aull,
+		.displacements = complex_test_hash_12_displacements,
+		.slot_keys     = complex_test_hash_12_slot_keys,
+		.slot_lengths  = complex_test_hash_12_slot_lengths,
+		.slot_indices  = complex_test_hash_12_slot_indices,
+		.keys          = complex_test_hash_12_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_13_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_13_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x828f405ecd32ed37ull,
+		.displacements = complex_test_hash_13_displacements,
+		.slot_keys     = complex_test_hash_13_slot_keys,
+		.slot_lengths  = complex_test_hash_13_slot_lengths,
+		.slot_indices  = complex_test_hash_13_slot_indices,
+		.keys          = complex_test_hash_13_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_14_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_14_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x739dc7443d921285ull,
+		.displacements = complex_test_hash_14_displacements,
+		.slot_keys     = complex_test_hash_14_slot_keys,
+		.slot_lengths  = complex_test_hash_14_slot_lengths,
+		.slot_indices  = complex_test_hash_14_slot_indices,
+		.keys          = complex_test_hash_14_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(complex_test_hash_15_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(complex_test_hash_15_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x705121dfc910cf1eull,
+		.displacements = complex_test_hash_15_displacements,
+		.slot_keys     = complex_test_hash_15_slot_keys,
+		.slot_lengths  = complex_test_hash_15_slot_lengths,
+		.slot_indices  = complex_test_hash_15_slot_indices,
+		.keys          = complex_test_hash_15_keys
+	}
+};
+
+__attribute__((constructor)) static void complex_test_registerHashes(void)
+{
+	registerPerfectHashes(
+		complex_test_hashes,
+		(int32_t) (sizeof(complex_test_hashes) / sizeof(perfect_hash_s))
+	);
+}
+
+#endif
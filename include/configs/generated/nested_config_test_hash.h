@@ -0,0 +1,310 @@
+#ifndef NESTED_CONFIG_TEST_HASH_H
+#define NESTED_CONFIG_TEST_HASH_H
+
+// Generated by src/perfect_hash_generator.c from nested_config_test.h, do not edit,
+// rerun make perfect_hash after changing the schema.
+
+#include "io_tools/custom_types.h"
+
+static const char *nested_config_test_hash_0_slot_keys[] =
+{
+	"parameter_float",
+	"parameter_string",
+	"parameter_bool",
+	"parameter_char",
+	"parameter_int"
+};
+
+static const char *nested_config_test_hash_0_keys[] =
+{
+	"parameter_string",
+	"parameter_float",
+	"parameter_int",
+	"parameter_bool",
+	"parameter_char"
+};
+
+static const uint32_t nested_config_test_hash_0_slot_lengths[] =
+{
+	15, 16, 14, 14, 13
+};
+
+static const int32_t nested_config_test_hash_0_slot_indices[] =
+{
+	1, 0, 3, 4, 2
+};
+
+static const uint32_t nested_config_test_hash_0_displacements[] =
+{
+	1, 0, 0
+};
+
+static const char *nested_config_test_hash_1_slot_keys[] =
+{
+	"config_test_1",
+	"config_test_3",
+	"config_test_0",
+	"config_test_4",
+	"config_test_2"
+};
+
+static const char *nested_config_test_hash_1_keys[] =
+{
+	"config_test_0",
+	"config_test_1",
+	"config_test_2",
+	"config_test_3",
+	"config_test_4"
+};
+
+static const uint32_t nested_config_test_hash_1_slot_lengths[] =
+{
+	13, 13, 13, 13, 13
+};
+
+static const int32_t nested_config_test_hash_1_slot_indices[] =
+{
+	1, 3, 0, 4, 2
+};
+
+static const uint32_t nested_config_test_hash_1_displacements[] =
+{
+	2, 0, 0
+};
+
+static const char *nested_config_test_hash_2_slot_keys[] =
+{
+	"nested_config_test_3",
+	"nested_config_test_2",
+	"nested_config_test_1",
+	"nested_config_test_0",
+	"nested_config_test_4"
+};
+
+static const char *nested_config_test_hash_2_keys[] =
+{
+	"nested_config_test_0",
+	"nested_config_test_1",
+	"nested_config_test_2",
+	"nested_config_test_3",
+	"nested_config_test_4"
+};
+
+static const uint32_t nested_config_test_hash_2_slot_lengths[] =
+{
+	20, 20, 20, 20, 20
+};
+
+static const int32_t nested_config_test_hash_2_slot_indices[] =
+{
+	3, 2, 1, 0, 4
+};
+
+static const uint32_t nested_config_test_hash_2_displacements[] =
+{
+	0, 0, 0
+};
+
+static const char *nested_config_test_hash_3_slot_keys[] =
+{
+	"parameter_int",
+	"parameter_string",
+	"parameter_float"
+};
+
+static const char *nested_config_test_hash_3_keys[] =
+{
+	"parameter_string",
+	"parameter_float",
+	"parameter_int"
+};
+
+static const uint32_t nested_config_test_hash_3_slot_lengths[] =
+{
+	13, 16, 15
+};
+
+static const int32_t nested_config_test_hash_3_slot_indices[] =
+{
+	2, 0, 1
+};
+
+static const uint32_t nested_config_test_hash_3_displacements[] =
+{
+	0, 0
+};
+
+static const char *nested_config_test_hash_4_slot_keys[] =
+{
+	"parameter_string"
+};
+
+static const char *nested_config_test_hash_4_keys[] =
+{
+	"parameter_string"
+};
+
+static const uint32_t nested_config_test_hash_4_slot_lengths[] =
+{
+	16
+};
+
+static const int32_t nested_config_test_hash_4_slot_indices[] =
+{
+	0
+};
+
+static const uint32_t nested_config_test_hash_4_displacements[] =
+{
+	0
+};
+
+static const char *nested_config_test_hash_5_slot_keys[] =
+{
+	"parameter_bool",
+	"parameter_int"
+};
+
+static const char *nested_config_test_hash_5_keys[] =
+{
+	"parameter_int",
+	"parameter_bool"
+};
+
+static const uint32_t nested_config_test_hash_5_slot_lengths[] =
+{
+	14, 13
+};
+
+static const int32_t nested_config_test_hash_5_slot_indices[] =
+{
+	1, 0
+};
+
+static const uint32_t nested_config_test_hash_5_displacements[] =
+{
+	2
+};
+
+static const char *nested_config_test_hash_6_slot_keys[] =
+{
+	"parameter_char"
+};
+
+static const char *nested_config_test_hash_6_keys[] =
+{
+	"parameter_char"
+};
+
+static const uint32_t nested_config_test_hash_6_slot_lengths[] =
+{
+	14
+};
+
+static const int32_t nested_config_test_hash_6_slot_indices[] =
+{
+	0
+};
+
+static const uint32_t nested_config_test_hash_6_displacements[] =
+{
+	0
+};
+
+static const perfect_hash_s nested_config_test_hashes[] =
+{
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_0_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_0_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x730e3312e9c14eacull,
+		.displacements = nested_config_test_hash_0_displacements,
+		.slot_keys     = nested_config_test_hash_0_slot_keys,
+		.slot_lengths  = nested_config_test_hash_0_slot_lengths,
+		.slot_indices  = nested_config_test_hash_0_slot_indices,
+		.keys          = nested_config_test_hash_0_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_1_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_1_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x5b530cf49a9933f4ull,
+		.displacements = nested_config_test_hash_1_displacements,
+		.slot_keys     = nested_config_test_hash_1_slot_keys,
+		.slot_lengths  = nested_config_test_hash_1_slot_lengths,
+		.slot_indices  = nested_config_test_hash_1_slot_indices,
+		.keys          = nested_config_test_hash_1_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_2_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_2_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xcab13b1e1f322fefull,
+		.displacements = nested_config_test_hash_2_displacements,
+		.slot_keys     = nested_config_test_hash_2_slot_keys,
+		.slot_lengths  = nested_config_test_hash_2_slot_lengths,
+		.slot_indices  = nested_config_test_hash_2_slot_indices,
+		.keys          = nested_config_test_hash_2_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_3_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_3_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xf2502868f8636bc4ull,
+		.displacements = nested_config_test_hash_3_displacements,
+		.slot_keys     = nested_config_test_hash_3_slot_keys,
+		.slot_lengths  = nested_config_test_hash_3_slot_lengths,
+		.slot_indices  = nested_config_test_hash_3_slot_indices,
+		.keys          = nested_config_test_hash_3_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_4_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_4_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xee5b0550e1948d5aull,
+		.displacements = nested_config_test_hash_4_displacements,
+		.slot_keys     = nested_config_test_hash_4_slot_keys,
+		.slot_lengths  = nested_config_test_hash_4_slot_lengths,
+		.slot_indices  = nested_config_test_hash_4_slot_indices,
+		.keys          = nested_config_test_hash_4_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_5_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_5_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x31fe98299e7c6c04ull,
+		.displacements = nested_config_test_hash_5_displacements,
+		.slot_keys     = nested_config_test_hash_5_slot_keys,
+		.slot_lengths  = nested_config_test_hash_5_slot_lengths,
+		.slot_indices  = nested_config_test_hash_5_slot_indices,
+		.keys          = nested_config_test_hash_5_keys
+	},
+	{
+		.num_keys      = (int32_t) (sizeof(nested_config_test_hash_6_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(nested_config_test_hash_6_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0xeea12dbede540707ull,
+		.displacements = nested_config_test_hash_6_displacements,
+		.slot_keys     = nested_config_test_hash_6_slot_keys,
+		.slot_lengths  = nested_config_test_hash_6_slot_lengths,
+		.slot_indices  = nested_config_test_hash_6_slot_indices,
+		.keys          = nested_config_test_hash_6_keys
+	}
+};
+
+__attribute__((constructor)) static void nested_config_test_registerHashes(void)
+{
+	registerPerfectHashes(
+		nested_config_test_hashes,
+		(int32_t) (sizeof(nested_config_test_hashes) / sizeof(perfect_hash_s))
+	);
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SINGLE_CONFIG_TEST_HASH_H
+#define SINGLE_CONFIG_TEST_HASH_H
+
+// Generated by src/perfect_hash_generator.c from single_config_test.h, do not edit,
+// rerun make perfect_hash after changing the schema.
+
+#include "io_tools/custom_types.h"
+
+static const char *single_config_test_hash_0_slot_keys[] =
+{
+	"parameter_float",
+	"parameter_string",
+	"parameter_bool",
+	"parameter_char",
+	"parameter_int"
+};
+
+static const char *single_config_test_hash_0_keys[] =
+{
+	"parameter_string",
+	"parameter_float",
+	"parameter_int",
+	"parameter_bool",
+	"parameter_char"
+};
+
+static const uint32_t single_config_test_hash_0_slot_lengths[] =
+{
+	15, 16, 14, 14, 13
+};
+
+static const int32_t single_config_test_hash_0_slot_indices[] =
+{
+	1, 0, 3, 4, 2
+};
+
+static const uint32_t single_config_test_hash_0_displacements[] =
+{
+	1, 0, 0
+};
+
+static const perfect_hash_s single_config_test_hashes[] =
+{
+	{
+		.num_keys      = (int32_t) (sizeof(single_config_test_hash_0_keys)
+			/ sizeof(char*)),
+		.num_buckets   = (int32_t) (sizeof(single_config_test_hash_0_displacements)
+			/ sizeof(uint32_t)),
+		.fingerprint   = 0x730e3312e9c14eacull,
+		.displacements = single_config_test_hash_0_displacements,
+		.slot_keys     = single_config_test_hash_0_slot_keys,
+		.slot_lengths  = single_config_test_hash_0_slot_lengths,
+		.slot_indices  = single_config_test_hash_0_slot_indices,
+		.keys          = single_config_test_hash_0_keys
+	}
+};
+
+__attribute__((constructor)) static void single_config_test_registerHashes(void)
+{
+	registerPerfectHashes(
+		single_config_test_hashes,
+		(int32_t) (sizeof(single_config_test_hashes) / sizeof(perfect_hash_s))
+	);
+}
+
+#endif
@@ -24,6 +24,15 @@ parameter_s defined_parameters[] =
 	{"parameter_char"  , char_e  , 1, 1, -FLT_MAX, FLT_MAX}	
 };
 
+size_t parameter_offsets[] = 
+{
+	offsetof(test_config_s, parameter_string),
+	offsetof(test_config_s, parameter_float ),
+	offsetof(test_config_s, parameter_int   ),
+	offsetof(test_config_s, parameter_bool  ),
+	offsetof(test_config_s, parameter_char  )
+};
+
 parameter_s default_parameter = 
 	{"default_parameter", none_e, 0, 0, 0.0f, 0.0f};
 
@@ -43,6 +52,7 @@ loader_config_s loader_config =
 	.min_inputed_parameters = 0,
 	.max_inputed_parameters = num_defined_parameters,
 	.defined_parameters     = defined_parameters,
+	.parameter_offsets      = parameter_offsets,
 	
 	.min_extra_parameters   = 0,
 	.max_extra_parameters   = 0,
@@ -0,0 +1,377 @@
+#ifndef IO_ARENA_H
+#define IO_ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <inttypes.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t) 64*1024)
+#define ARENA_ALIGNMENT          ((size_t) 16)
+
+typedef struct ArenaBlock {
+
+	/**
+     * Structure to hold one contiguous block of arena memory. Blocks are
+	 * chained newest first.
+     */
+
+	struct ArenaBlock *previous_block;
+	size_t             size;
+	size_t             used;
+
+	_Alignas(16) uint8_t data[];
+
+} arena_block_s;
+
+typedef struct Arena {
+
+	/**
+     * Structure to hold a bump allocator. Allocations are never freed one
+	 * at a time, the whole arena is released at once with freeArena().
+     */
+
+	arena_block_s *block;
+	size_t         block_size;
+
+	// Last allocation, which arenaRealloc() can grow in place:
+	void          *last_allocation;
+
+	size_t         num_allocations;
+	size_t         total_allocated;
+
+} arena_s;
+
+// Optional callback run on every allocation, for instance to count them:
+typedef void (*arena_hook_f)(const size_t size);
+
+static arena_hook_f arena_allocation_hook = NULL;
+
+static inline void runArenaAllocationHook(
+	const size_t size
+	) {
+
+	if (arena_allocation_hook != NULL)
+	{
+		arena_allocation_hook(size);
+	}
+}
+
+arena_s *createArena(
+	const size_t block_size
+	) {
+
+	/**
+     * Create an empty arena.
+     * @param
+     *     const size_t block_size: bytes in each block, 0 for the default.
+     * @see arenaAlloc(), freeArena().
+     * @return arena_s *arena: new arena.
+     */
+
+	arena_s *arena = malloc(sizeof(arena_s));
+
+	*arena = (arena_s)
+	{
+		.block           = NULL,
+		.block_size      =
+			(block_size > 0) ? block_size : ARENA_DEFAULT_BLOCK_SIZE,
+		.last_allocation = NULL,
+		.num_allocations = 0,
+		.total_allocated = 0
+	};
+
+	return arena;
+}
+
+void *arenaAlloc(
+	      arena_s *arena,
+	const size_t   size
+	) {
+
+	/**
+     * Allocate size bytes, aligned for any type, from arena. If arena is
+	 * NULL falls back to malloc, so callers can be written once for both.
+     * @param
+     *     arena_s      *arena: arena to allocate from, or NULL.
+     *     const size_t  size : number of bytes.
+     * @see arenaCalloc(), arenaRealloc().
+     * @return void *pointer: allocated memory.
+     */
+
+	runArenaAllocationHook(size);
+
+	if (arena == NULL)
+	{
+		return malloc(size);
+	}
+
+	const size_t aligned_size =
+		(size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+	arena_block_s *block = arena->block;
+
+	if ((block == NULL) || (block->used + aligned_size > block->size))
+	{
+		// Oversized requests get a block of their own:
+		const size_t block_size =
+			(aligned_size > arena->block_size)
+			? aligned_size
+			: arena->block_size;
+
+		block = malloc(sizeof(arena_block_s) + block_size);
+
+		block->previous_block = arena->block;
+		block->size           = block_size;
+		block->used           = 0;
+
+		arena->block = block;
+	}
+
+	void *pointer = &block->data[block->used];
+	block->used  += aligned_size;
+
+	arena->last_allocation  = pointer;
+	arena->num_allocations++;
+	arena->total_allocated += aligned_size;
+
+	return pointer;
+}
+
+void *arenaCalloc(
+	      arena_s *arena,
+	const size_t   num_elements,
+	const size_t   size
+	) {
+
+	/**
+     * Allocate zeroed memory for num_elements of size bytes from arena, or
+	 * with calloc if arena is NULL.
+     */
+
+	if (arena == NULL)
+	{
+		runArenaAllocationHook(num_elements*size);
+		return calloc(num_elements, size);
+	}
+
+	void *pointer = arenaAlloc(arena, num_elements*size);
+	memset(pointer, 0, num_elements*size);
+
+	return pointer;
+}
+
+void *arenaRealloc(
+	      arena_s *arena,
+	      void    *pointer,
+	const size_t   old_size,
+	const size_t   new_size
+	) {
+
+	/**
+     * Resize an arena allocation. The most recent allocation is grown in
+	 * place when its block has room, others are copied. If arena is NULL
+	 * falls back to realloc.
+     * @param
+     *     arena_s      *arena   : arena pointer was allocated from, or NULL.
+     *     void         *pointer : allocation to resize, may be NULL.
+     *     const size_t  old_size: current size of allocation.
+     *     const size_t  new_size: requested size.
+     * @see arenaAlloc().
+     * @return void *pointer: resized allocation.
+     */
+
+	if (arena == NULL)
+	{
+		runArenaAllocationHook(new_size);
+		return realloc(pointer, new_size);
+	}
+
+	if (pointer == NULL)
+	{
+		return arenaAlloc(arena, new_size);
+	}
+
+	arena_block_s *block = arena->block;
+
+	if ((pointer == arena->last_allocation) && (block != NULL))
+	{
+		const size_t start        = (size_t) ((uint8_t*) pointer - block->data);
+		const size_t aligned_size =
+			(new_size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+		if (start + aligned_size <= block->size)
+		{
+			arena->total_allocated += aligned_size;
+			arena->total_allocated -= block->used - start;
+			block->used             = start + aligned_size;
+
+			return pointer;
+		}
+	}
+
+	if (new_size <= old_size)
+	{
+		return pointer;
+	}
+
+	void *new_pointer = arenaAlloc(arena, new_size);
+	memcpy(new_pointer, pointer, old_size);
+
+	return new_pointer;
+}
+
+char *arenaStrndup(
+	      arena_s *arena,
+	const char    *string,
+	const size_t   length
+	) {
+
+	/**
+     * Copy at most length characters of string into arena, null terminated.
+	 * Uses strndup if arena is NULL.
+     */
+
+	if (arena == NULL)
+	{
+		runArenaAllocationHook(length + 1);
+		return strndup(string, length);
+	}
+
+	const size_t  copy_length = strnlen(string, length);
+	      char   *copy        = arenaAlloc(arena, copy_length + 1);
+
+	memcpy(copy, string, copy_length);
+	copy[copy_length] = '\0';
+
+	return copy;
+}
+
+char *arenaStrdup(
+	      arena_s *arena,
+	const char    *string
+	) {
+
+	return arenaStrndup(arena, string, strlen(string));
+}
+
+void arenaFree(
+	arena_s *arena,
+	void    *pointer
+	) {
+
+	/**
+     * Free pointer if it came from malloc. Arena allocations are left for
+	 * freeArena().
+     */
+
+	if (arena == NULL)
+	{
+		free(pointer);
+	}
+}
+
+void mergeArena(
+	arena_s *arena,
+	arena_s *child
+	) {
+
+	/**
+     * Move every block of child into arena, leaving child empty. Lets 
+	 * threads allocate from private arenas and hand the results to a shared
+	 * one afterwards. Neither arena may be in use by another thread.
+     * @param
+     *     arena_s *arena: arena to receive the blocks.
+     *     arena_s *child: arena to take blocks from.
+     * @see createArena(), freeArena().
+     * @return none
+     */
+
+	if (child->block == NULL)
+	{
+		return;
+	}
+
+	// Child blocks go behind the current block, so it stays the bump target:
+	arena_block_s *oldest = child->block;
+	while (oldest->previous_block != NULL)
+	{
+		oldest = oldest->previous_block;
+	}
+
+	if (arena->block == NULL)
+	{
+		arena->block = child->block;
+	}
+	else
+	{
+		oldest->previous_block       = arena->block->previous_block;
+		arena->block->previous_block = child->block;
+	}
+
+	arena->num_allocations += child->num_allocations;
+	arena->total_allocated += child->total_allocated;
+
+	child->block           = NULL;
+	child->last_allocation = NULL;
+	child->num_allocations = 0;
+	child->total_allocated = 0;
+}
+
+void resetArena(
+	arena_s *arena
+	) {
+
+	/**
+     * Release every allocation in arena but keep its newest block for reuse.
+     * @param
+     *     arena_s *arena: arena to reset.
+     * @see freeArena().
+     * @return none
+     */
+
+	arena_block_s *block = arena->block;
+
+	if (block != NULL)
+	{
+		arena_block_s *previous = block->previous_block;
+		while (previous != NULL)
+		{
+			arena_block_s *next = previous->previous_block;
+			free(previous);
+			previous = next;
+		}
+
+		block->previous_block = NULL;
+		block->used           = 0;
+	}
+
+	arena->last_allocation = NULL;
+	arena->num_allocations = 0;
+	arena->total_allocated = 0;
+}
+
+void freeArena(
+	arena_s *arena
+	) {
+
+	/**
+     * Release an arena and everything allocated from it. Costs one free per
+	 * block, independent of the number of allocations.
+     * @param
+     *     arena_s *arena: arena to free.
+     * @see createArena().
+     * @return none
+     */
+
+	if (arena != NULL)
+	{
+		resetArena(arena);
+		free(arena->block);
+		free(arena);
+	}
+}
+
+#endif
@@ -0,0 +1,869 @@
+#ifndef IO_ASYNC_IO_H
+#define IO_ASYNC_IO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <inttypes.h>
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) \
+	&& __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define ASYNC_IO_HAS_URING 1
+#else
+#define ASYNC_IO_HAS_URING 0
+#endif
+
+#define ASYNC_BLOCK_SIZE  ((size_t) 1 << 22)
+#define ASYNC_NUM_BLOCKS  3
+
+typedef enum AsyncBackend {
+
+	/**
+     * Enum to hold how an async reader gets its blocks from the kernel.
+     */
+
+	async_auto_e,
+	async_uring_e,
+	async_thread_e
+} async_backend_e;
+
+typedef struct AsyncUring {
+
+	/**
+     * Structure to hold an io_uring instance set up with raw system calls,
+	 * and the views of its shared submission and completion rings.
+     */
+
+	int                  ring_descriptor;
+
+	void                *sq_pointer;
+	size_t               sq_size;
+	void                *cq_pointer;
+	size_t               cq_size;
+	void                *sqes_pointer;
+	size_t               sqes_size;
+
+	#if ASYNC_IO_HAS_URING
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+	#endif
+
+	unsigned            *sq_head;
+	unsigned            *sq_tail;
+	unsigned            *sq_mask;
+	unsigned            *sq_array;
+	unsigned            *cq_head;
+	unsigned            *cq_tail;
+	unsigned            *cq_mask;
+
+	struct iovec        *vectors;
+
+} async_uring_s;
+
+typedef struct AsyncReader {
+
+	/**
+     * Structure to hold a sequential file reader that keeps num_blocks
+	 * fixed size blocks in flight, so the caller parses one block while the
+	 * next are read. Blocks are handed out in file order and each is
+	 * recycled when the following one is asked for.
+     */
+
+	int              file_descriptor;
+	const char      *file_name;
+	async_backend_e  backend;
+
+	char            *buffers;
+	size_t           block_size;
+	int32_t          num_blocks;
+
+	// Per slot, block k of the file lives in slot k % num_blocks:
+	size_t          *lengths;
+	int64_t         *ready_blocks;
+
+	int64_t          file_size;
+	int64_t          next_submit;
+	int64_t          next_consume;
+	int64_t          num_released;
+	int64_t          end_block;
+	bool             failed;
+
+	async_uring_s    uring;
+
+	pthread_t        thread;
+	pthread_mutex_t  mutex;
+	pthread_cond_t   ready_condition;
+	pthread_cond_t   free_condition;
+	bool             stop;
+
+	// Times the caller found its next block still being read:
+	int64_t          num_stalls;
+	uint64_t         bytes_read;
+
+} async_reader_s;
+
+const char *asyncBackendToString(
+	const async_backend_e backend
+	) {
+
+	const char *string = "auto";
+	switch (backend)
+	{
+		case (async_auto_e  ): string = "auto"    ; break;
+		case (async_uring_e ): string = "io_uring"; break;
+		case (async_thread_e): string = "thread"  ; break;
+	}
+
+	return string;
+}
+
+#if ASYNC_IO_HAS_URING
+
+bool setupAsyncUring(
+	      async_uring_s *uring,
+	const int32_t        num_entries
+	) {
+
+	/**
+     * Create an io_uring with io_uring_setup and map its rings, without
+	 * liburing.
+     * @param
+     *     async_uring_s *uring      : ring to set up.
+     *     const int32_t  num_entries: submission queue entries wanted.
+     * @see submitAsyncUring(), freeAsyncUring().
+     * @return bool success: false if the kernel refuses io_uring.
+     */
+
+	struct io_uring_params parameters;
+	memset(&parameters, 0, sizeof(parameters));
+
+	const long ring_descriptor =
+		syscall(__NR_io_uring_setup, (unsigned) num_entries, &parameters);
+
+	if (ring_descriptor < 0)
+	{
+		return false;
+	}
+
+	uring->ring_descriptor = (int) ring_descriptor;
+
+	uring->sq_size =
+		parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+	uring->cq_size =
+		parameters.cq_off.cqes
+		+ parameters.cq_entries * sizeof(struct io_uring_cqe);
+
+	const bool single_map =
+		(parameters.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single_map)
+	{
+		uring->sq_size =
+			(uring->sq_size > uring->cq_size) ? uring->sq_size : uring->cq_size;
+		uring->cq_size = uring->sq_size;
+	}
+
+	uring->sq_pointer =
+		mmap(
+			NULL, uring->sq_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, uring->ring_descriptor,
+			IORING_OFF_SQ_RING
+		);
+	uring->cq_pointer = single_map
+		? uring->sq_pointer
+		: mmap(
+			NULL, uring->cq_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, uring->ring_descriptor,
+			IORING_OFF_CQ_RING
+		);
+
+	uring->sqes_size    =
+		parameters.sq_entries * sizeof(struct io_uring_sqe);
+	uring->sqes_pointer =
+		mmap(
+			NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, uring->ring_descriptor,
+			IORING_OFF_SQES
+		);
+
+	if (   (uring->sq_pointer   == MAP_FAILED)
+		|| (uring->cq_pointer   == MAP_FAILED)
+		|| (uring->sqes_pointer == MAP_FAILED)
+	) {
+		if (uring->sq_pointer != MAP_FAILED)
+		{
+			munmap(uring->sq_pointer, uring->sq_size);
+		}
+		if (!single_map && (uring->cq_pointer != MAP_FAILED))
+		{
+			munmap(uring->cq_pointer, uring->cq_size);
+		}
+		if (uring->sqes_pointer != MAP_FAILED)
+		{
+			munmap(uring->sqes_pointer, uring->sqes_size);
+		}
+		close(uring->ring_descriptor);
+
+		return false;
+	}
+
+	uint8_t *sq = uring->sq_pointer;
+	uint8_t *cq = uring->cq_pointer;
+
+	uring->sq_head  = (unsigned*) &sq[parameters.sq_off.head        ];
+	uring->sq_tail  = (unsigned*) &sq[parameters.sq_off.tail        ];
+	uring->sq_mask  = (unsigned*) &sq[parameters.sq_off.ring_mask   ];
+	uring->sq_array = (unsigned*) &sq[parameters.sq_off.array       ];
+	uring->cq_head  = (unsigned*) &cq[parameters.cq_off.head        ];
+	uring->cq_tail  = (unsigned*) &cq[parameters.cq_off.tail        ];
+	uring->cq_mask  = (unsigned*) &cq[parameters.cq_off.ring_mask   ];
+	uring->cqes     = (struct io_uring_cqe*) &cq[parameters.cq_off.cqes];
+	uring->sqes     = uring->sqes_pointer;
+
+	uring->vectors  = calloc((size_t) num_entries, sizeof(struct iovec));
+
+	return true;
+}
+
+void freeAsyncUring(
+	async_uring_s *uring
+	) {
+
+	if (uring->sqes_pointer != NULL)
+	{
+		munmap(uring->sqes_pointer, uring->sqes_size);
+	}
+	if ((uring->cq_pointer != NULL) && (uring->cq_pointer != uring->sq_pointer))
+	{
+		munmap(uring->cq_pointer, uring->cq_size);
+	}
+	if (uring->sq_pointer != NULL)
+	{
+		munmap(uring->sq_pointer, uring->sq_size);
+	}
+	close(uring->ring_descriptor);
+	free(uring->vectors);
+
+	memset(uring, 0, sizeof(*uring));
+	uring->ring_descriptor = -1;
+}
+
+void submitAsyncUring(
+	      async_reader_s *reader,
+	const int32_t         slot,
+	const int64_t         block,
+	const size_t          done,
+	const size_t          length
+	) {
+
+	/**
+     * Queue a read of the rest of a slot's block and tell the kernel, with
+	 * one io_uring_enter per read.
+     * @param
+     *     async_reader_s *reader: reader owning the ring.
+     *     const int32_t   slot  : slot to read into.
+     *     const int64_t   block : block of the file to read.
+     *     const size_t    done  : bytes of the block already read.
+     *     const size_t    length: bytes of the block still wanted.
+     * @see reapAsyncUring().
+     * @return none
+     */
+
+	async_uring_s *uring = &reader->uring;
+
+	const size_t offset = (size_t) block * reader->block_size + done;
+
+	// Pending slots hold -block - 2 until their read completes:
+	reader->ready_blocks[slot] = -block - 2;
+
+	uring->vectors[slot] = (struct iovec)
+	{
+		&reader->buffers[(size_t) slot * reader->block_size + done],
+		length
+	};
+
+	const unsigned tail  = *uring->sq_tail;
+	const unsigned index = tail & *uring->sq_mask;
+
+	struct io_uring_sqe *entry = &uring->sqes[index];
+	memset(entry, 0, sizeof(*entry));
+
+	entry->opcode    = IORING_OP_READV;
+	entry->fd        = reader->file_descriptor;
+	entry->addr      = (uint64_t) (uintptr_t) &uring->vectors[slot];
+	entry->len       = 1;
+	entry->off       = (uint64_t) offset;
+	entry->user_data = (__u64) slot;
+
+	uring->sq_array[index] = index;
+	__atomic_store_n(uring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	long submitted;
+	do
+	{
+		submitted = syscall(
+			__NR_io_uring_enter, uring->ring_descriptor, 1, 0, 0, NULL, 0
+		);
+	}
+	while ((submitted < 0) && (errno == EINTR));
+
+	// Nothing will complete for a read the kernel never took:
+	if (submitted < 0)
+	{
+		reader->ready_blocks[slot] = -1;
+		reader->failed             = true;
+	}
+}
+
+bool reapAsyncUring(
+	async_reader_s *reader
+	) {
+
+	/**
+     * Wait for at least one completion and account for every one available.
+	 * Short reads are resubmitted for the rest of their block, failed ones
+	 * free their slot and mark the reader failed.
+     * @see submitAsyncUring().
+     * @return bool success: false if the ring itself could not be waited on.
+     */
+
+	async_uring_s *uring = &reader->uring;
+
+	if (   (syscall(
+				__NR_io_uring_enter, uring->ring_descriptor, 0, 1,
+				IORING_ENTER_GETEVENTS, NULL, 0
+			) < 0)
+		&& (errno != EINTR)
+	) {
+		reader->failed = true;
+		return false;
+	}
+
+	unsigned       head = *uring->cq_head;
+	const unsigned tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+
+	for (; head != tail; head++)
+	{
+		const struct io_uring_cqe *completion =
+			&uring->cqes[head & *uring->cq_mask];
+
+		const int32_t slot   = (int32_t) completion->user_data;
+		const int32_t result = completion->res;
+
+		const int64_t block    = -reader->ready_blocks[slot] - 2;
+		const size_t  offset   = (size_t) block * reader->block_size;
+		const size_t  expected =
+			((size_t) reader->file_size - offset < reader->block_size)
+			? (size_t) reader->file_size - offset
+			: reader->block_size;
+
+		if ((result == -EINTR) || (result == -EAGAIN))
+		{
+			submitAsyncUring(
+				reader, slot, block, reader->lengths[slot],
+				expected - reader->lengths[slot]
+			);
+		}
+		else if (result < 0)
+		{
+			reader->ready_blocks[slot] = -1;
+			reader->failed             = true;
+		}
+		else
+		{
+			reader->lengths[slot] += (size_t) result;
+
+			// Kernel returned less than asked for, a 0 means the file shrank:
+			if ((result > 0) && (reader->lengths[slot] < expected))
+			{
+				submitAsyncUring(
+					reader, slot, block, reader->lengths[slot],
+					expected - reader->lengths[slot]
+				);
+			}
+			else
+			{
+				reader->ready_blocks[slot] = block;
+			}
+		}
+	}
+
+	__atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+
+	return true;
+}
+
+#endif
+
+void submitAsyncBlock(
+	async_reader_s *reader
+	) {
+
+	/**
+     * Start reading the next block of the file into its slot, if it lies
+	 * inside the file.
+     */
+
+	const int64_t block = reader->next_submit;
+	if ((size_t) block * reader->block_size >= (size_t) reader->file_size)
+	{
+		return;
+	}
+
+	const int32_t slot = (int32_t) (block % reader->num_blocks);
+	reader->next_submit++;
+
+	#if ASYNC_IO_HAS_URING
+	const size_t offset = (size_t) block * reader->block_size;
+	const size_t length =
+		((size_t) reader->file_size - offset < reader->block_size)
+		? (size_t) reader->file_size - offset
+		: reader->block_size;
+
+	reader->lengths[slot] = 0;
+	submitAsyncUring(reader, slot, block, 0, length);
+	#else
+	(void) slot;
+	#endif
+}
+
+void *readAsyncBlocks(
+	void *argument
+	) {
+
+	/**
+     * Body of the fallback reader thread. Reads blocks in order with pread,
+	 * or read for pipes, waiting whenever every slot is full.
+     */
+
+	async_reader_s *reader = argument;
+
+	struct stat file_stat;
+	const bool seekable =
+		   (fstat(reader->file_descriptor, &file_stat) == 0)
+		&& S_ISREG(file_stat.st_mode);
+
+	for (int64_t block = 0; ; block++)
+	{
+		const int32_t slot = (int32_t) (block % reader->num_blocks);
+
+		pthread_mutex_lock(&reader->mutex);
+		// Slot is free once the block num_blocks back has been handed back:
+		while (
+			   !reader->stop
+			&& (block >= reader->num_released + reader->num_blocks)
+		) {
+			pthread_cond_wait(&reader->free_condition, &reader->mutex);
+		}
+		const bool stop = reader->stop;
+		pthread_mutex_unlock(&reader->mutex);
+
+		if (stop)
+		{
+			break;
+		}
+
+		char   *buffer = &reader->buffers[(size_t) slot * reader->block_size];
+		size_t  length = 0;
+		bool    failed = false;
+		bool    ended  = false;
+
+		while (!ended && !failed && (length < reader->block_size))
+		{
+			const ssize_t result = seekable
+				? pread(
+					reader->file_descriptor, &buffer[length],
+					reader->block_size - length,
+					(off_t) ((size_t) block * reader->block_size + length)
+				)
+				: read(
+					reader->file_descriptor, &buffer[length],
+					reader->block_size - length
+				);
+
+			if (result < 0)
+			{
+				failed = (errno != EINTR);
+			}
+			else if (result == 0)
+			{
+				ended = true;
+			}
+			else
+			{
+				length += (size_t) result;
+			}
+		}
+
+		pthread_mutex_lock(&reader->mutex);
+		reader->lengths[slot]      = length;
+		reader->ready_blocks[slot] = block;
+		reader->failed             = reader->failed || failed;
+		if (ended || failed)
+		{
+			reader->end_block = block + 1;
+		}
+		pthread_cond_broadcast(&reader->ready_condition);
+		pthread_mutex_unlock(&reader->mutex);
+
+		if (ended || failed)
+		{
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+bool openAsyncReader(
+	const int32_t          verbosity,
+	const char            *file_name,
+	const async_backend_e  backend,
+	const size_t           block_size,
+	const int32_t          num_blocks,
+	      async_reader_s  *ret_reader
+	) {
+
+	/**
+     * Open a file for sequential reading with read ahead. io_uring is used
+	 * for regular files when the kernel allows it, otherwise a reader
+	 * thread fills the blocks with pread, or read for pipes. Files that 
+	 * report no size, as in procfs and sysfs, are read by the thread until
+	 * end of file.
+     * @param
+     *     const int32_t          verbosity : verbosity level of warnings.
+     *     const char            *file_name : path of file to read.
+     *     const async_backend_e  backend   : async_auto_e to pick, or a
+	 *                                        backend to force, io_uring
+	 *                                        still falling back if refused.
+     *     const size_t           block_size: bytes per block, 0 for
+	 *                                        ASYNC_BLOCK_SIZE.
+     *     const int32_t          num_blocks: blocks in flight, at least 2,
+	 *                                        0 for ASYNC_NUM_BLOCKS.
+     *           async_reader_s  *ret_reader: opened reader.
+     * @see nextAsyncBlock(), closeAsyncReader().
+     * @return bool success: true if the file was opened.
+     */
+
+	const int file_descriptor = open(file_name, O_RDONLY);
+	struct stat file_stat;
+
+	if ((file_descriptor < 0) || (fstat(file_descriptor, &file_stat) != 0))
+	{
+		if (verbosity >= 1)
+		{
+			fprintf(
+				stderr,
+				"openAsyncReader: \nWarning! Could not open file \"%s\": %s.\n",
+				file_name,
+				strerror(errno)
+			);
+		}
+		if (file_descriptor >= 0)
+		{
+			close(file_descriptor);
+		}
+
+		return false;
+	}
+
+	posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+	const size_t  block_bytes =
+		(block_size > 0) ? block_size : ASYNC_BLOCK_SIZE;
+	const int32_t block_count =
+		(num_blocks > 1) ? num_blocks : ASYNC_NUM_BLOCKS;
+
+	*ret_reader = (async_reader_s)
+	{
+		.file_descriptor = file_descriptor,
+		.file_name       = file_name,
+		.backend         = async_thread_e,
+		.buffers         = malloc(block_bytes * (size_t) block_count),
+		.block_size      = block_bytes,
+		.num_blocks      = block_count,
+		.lengths         = calloc((size_t) block_count, sizeof(size_t)),
+		.ready_blocks    = malloc(sizeof(int64_t) * (size_t) block_count),
+		.file_size       =
+			S_ISREG(file_stat.st_mode) ? (int64_t) file_stat.st_size : -1,
+		.next_submit     = 0,
+		.next_consume    = 0,
+		.num_released    = 0,
+		.end_block       = INT64_MAX,
+		.failed          = false,
+		.uring           = {.ring_descriptor = -1},
+		.stop            = false,
+		.num_stalls      = 0,
+		.bytes_read      = 0
+	};
+
+	for (int32_t slot = 0; slot < block_count; slot++)
+	{
+		ret_reader->ready_blocks[slot] = -1;
+	}
+
+	#if ASYNC_IO_HAS_URING
+	if (   (backend != async_thread_e)
+		&& (ret_reader->file_size > 0)
+		&& setupAsyncUring(&ret_reader->uring, block_count)
+	) {
+		ret_reader->backend = async_uring_e;
+
+		for (int32_t block = 0; block < block_count; block++)
+		{
+			submitAsyncBlock(ret_reader);
+		}
+
+		return true;
+	}
+	#endif
+
+	pthread_mutex_init(&ret_reader->mutex, NULL);
+	pthread_cond_init(&ret_reader->ready_condition, NULL);
+	pthread_cond_init(&ret_reader->free_condition, NULL);
+
+	if (pthread_create(&ret_reader->thread, NULL, readAsyncBlocks, ret_reader)
+		!= 0
+	) {
+		if (verbosity >= 1)
+		{
+			fprintf(
+				stderr,
+				"openAsyncReader: \nWarning! Could not start reader thread "
+				"for \"%s\".\n",
+				file_name
+			);
+		}
+		pthread_mutex_destroy(&ret_reader->mutex);
+		pthread_cond_destroy(&ret_reader->ready_condition);
+		pthread_cond_destroy(&ret_reader->free_condition);
+		free(ret_reader->buffers);
+		free(ret_reader->lengths);
+		free(ret_reader->ready_blocks);
+		close(file_descriptor);
+
+		return false;
+	}
+
+	return true;
+}
+
+const char *nextAsyncBlock(
+	async_reader_s *reader,
+	size_t         *ret_length
+	) {
+
+	/**
+     * Hand out the next block of the file, waiting only if it is still
+	 * being read. The block given out by the previous call is recycled for
+	 * read ahead, so must no longer be used.
+     * @param
+     *     async_reader_s *reader    : reader to take a block from.
+     *     size_t         *ret_length: bytes in the block.
+     * @see openAsyncReader(), closeAsyncReader().
+     * @return const char *block: block contents, or NULL at the end of the
+	 *                            file or on error.
+     */
+
+	*ret_length = 0;
+
+	const int64_t block = reader->next_consume;
+	const int32_t slot  = (int32_t) (block % reader->num_blocks);
+
+	const char *data   = &reader->buffers[(size_t) slot * reader->block_size];
+	size_t      length = 0;
+
+	#if ASYNC_IO_HAS_URING
+	if (reader->backend == async_uring_e)
+	{
+		// Previous block's slot reads ahead once it is handed back:
+		if (block > 0)
+		{
+			submitAsyncBlock(reader);
+		}
+
+		if ((size_t) block * reader->block_size >= (size_t) reader->file_size)
+		{
+			return NULL;
+		}
+
+		if (reader->ready_blocks[slot] != block)
+		{
+			reader->num_stalls++;
+		}
+		while (!reader->failed && (reader->ready_blocks[slot] != block))
+		{
+			reapAsyncUring(reader);
+		}
+
+		if (reader->failed)
+		{
+			return NULL;
+		}
+
+		length = reader->lengths[slot];
+		reader->next_consume++;
+	}
+	else
+	#endif
+	{
+		pthread_mutex_lock(&reader->mutex);
+
+		// Previous block's slot is free for the reader thread:
+		reader->num_released = block;
+		pthread_cond_signal(&reader->free_condition);
+
+		if (   (reader->ready_blocks[slot] != block)
+			&& (block < reader->end_block)
+		) {
+			reader->num_stalls++;
+		}
+		while (
+			   (reader->ready_blocks[slot] != block)
+			&& (block < reader->end_block)
+		) {
+			pthread_cond_wait(&reader->ready_condition, &reader->mutex);
+		}
+
+		const bool ready = (reader->ready_blocks[slot] == block);
+		length = ready ? reader->lengths[slot] : 0;
+		reader->next_consume = block + 1;
+
+		pthread_mutex_unlock(&reader->mutex);
+	}
+
+	reader->bytes_read += length;
+	*ret_length         = length;
+
+	return (length > 0) ? data : NULL;
+}
+
+void closeAsyncReader(
+	async_reader_s *reader
+	) {
+
+	/**
+     * Stop any read ahead, close the file and free the blocks.
+     * @see openAsyncReader().
+     * @return none
+     */
+
+	#if ASYNC_IO_HAS_URING
+	if (reader->backend == async_uring_e)
+	{
+		// Buffers may only go once the kernel is done with them:
+		bool waiting = true;
+		for (int32_t slot = 0; waiting && (slot < reader->num_blocks); slot++)
+		{
+			while (waiting && (reader->ready_blocks[slot] < -1))
+			{
+				waiting = reapAsyncUring(reader);
+			}
+		}
+		freeAsyncUring(&reader->uring);
+	}
+	else
+	#endif
+	{
+		pthread_mutex_lock(&reader->mutex);
+		reader->stop = true;
+		pthread_cond_broadcast(&reader->free_condition);
+		pthread_mutex_unlock(&reader->mutex);
+
+		pthread_join(reader->thread, NULL);
+
+		pthread_mutex_destroy(&reader->mutex);
+		pthread_cond_destroy(&reader->ready_condition);
+		pthread_cond_destroy(&reader->free_condition);
+	}
+
+	close(reader->file_descriptor);
+	free(reader->buffers);
+	free(reader->lengths);
+	free(reader->ready_blocks);
+
+	reader->file_descriptor = -1;
+	reader->buffers         = NULL;
+	reader->lengths         = NULL;
+	reader->ready_blocks    = NULL;
+}
+
+char *readFileAsync(
+	const int32_t  verbosity,
+	const char    *file_name,
+	      size_t  *ret_length
+	) {
+
+	/**
+     * Read a whole file, of any kind, into one buffer through an async
+	 * reader. Used where a file cannot be mapped, such as a pipe.
+     * @param
+     *     const int32_t  verbosity : verbosity level of warnings.
+     *     const char    *file_name : path of file to read.
+     *           size_t  *ret_length: bytes read.
+     * @see openAsyncReader(), mapFile().
+     * @return char *buffer: null terminated contents, caller must free, or
+	 *                       NULL if the file could not be read.
+     */
+
+	*ret_length = 0;
+
+	async_reader_s reader;
+	if (!openAsyncReader(verbosity, file_name, async_auto_e, 0, 0, &reader))
+	{
+		return NULL;
+	}
+
+	size_t  capacity = reader.block_size + 1;
+	size_t  length   = 0;
+	char   *buffer   = malloc(capacity);
+
+	size_t      block_length;
+	const char *block;
+	while ((block = nextAsyncBlock(&reader, &block_length)) != NULL)
+	{
+		if (length + block_length + 1 > capacity)
+		{
+			capacity = 2*(length + block_length) + 1;
+			buffer   = realloc(buffer, capacity);
+		}
+
+		memcpy(&buffer[length], block, block_length);
+		length += block_length;
+	}
+	buffer[length] = '\0';
+
+	const bool failed = reader.failed;
+	closeAsyncReader(&reader);
+
+	if (failed)
+	{
+		if (verbosity >= 1)
+		{
+			fprintf(
+				stderr,
+				"readFileAsync: \nWarning! Could not read file \"%s\".\n",
+				file_name
+			);
+		}
+		free(buffer);
+
+		return NULL;
+	}
+
+	*ret_length = length;
+
+	return buffer;
+}
+
+#endif
@@ -10,9 +10,20 @@
 #include "float.h"
 
 #include "io_tools/text.h"
+#include "io_tools/async_io.h"
 #include "io_tools/strings.h"
+#include "io_tools/arena.h"
 #include "io_tools/custom_types.h"
 #include "io_tools/structures.h"
+#include "io_tools/config_declare.h"
+#include "io_tools/config_stats.h"
+#include "io_tools/console.h"
+#include "io_tools/lexer.h"
+
+// Smallest config buffer whose top level blocks are parsed in parallel:
+#ifndef CONFIG_PARALLEL_MIN_BYTES
+#define CONFIG_PARALLEL_MIN_BYTES ((size_t) 1 << 20)
+#endif
 
 typedef struct construct_s {
 	
@@ -22,63 +33,62 @@ typedef struct construct_s {
 	
 } construct_s;
 
-size_t getTotalTypeArraySize(
-    const type_e   *types, 
-    const int32_t   num_elements
+size_t getParameterOffsets(
+    const parameter_s *parameters, 
+    const size_t      *declared_offsets,
+    const int32_t      num_parameters,
+          size_t      *ret_offsets
     ) {
 
-	size_t total_size = 0u;
+	/**
+     * Fill the byte offset of each parameter within its output struct. 
+	 * Declared offsets, from offsetof(), are used as is. Otherwise each
+	 * parameter follows the previous one with the padding the compiler 
+	 * would insert.
+     * @param
+     *     const parameter_s *parameters      : parameters in struct order.
+     *     const size_t      *declared_offsets: offsetof() table, or NULL.
+     *     const int32_t      num_parameters  : number of parameters.
+     *           size_t      *ret_offsets     : num_parameters offsets.
+     * @see getAlignmentOfType().
+     * @return size_t struct_size: size of the struct including trailing
+     *                             padding.
+     */
+
+	size_t end_position      = 0u;
+	size_t largest_alignment = 1u;
 
-	for (int32_t index = 0; index < num_elements; index++) 
+	for (int32_t index = 0; index < num_parameters; index++) 
 	{	
-		total_size += getSizeOfType(types[index]);
-	}
-	
-	return total_size;
-} 
+		const type_e type      = parameters[index].type;
+		const size_t alignment = getAlignmentOfType(type);
+		      size_t offset    = 0u;
 
-bool checkTypeOrder(
-	const int32_t  verbosity,
-    const type_e  *types, 
-    const int32_t  num_elements
-   ) {
-	
-	bool return_value = true;
-	
-	size_t value      = 0u;
-	size_t last_value = 0u;
-	
-	if (num_elements > 0)
-	{
-		last_value = getSizeOfType(types[0]);
-	}
+		if (declared_offsets != NULL)
+		{
+			offset = declared_offsets[index];
+		}
+		else
+		{
+			offset = (end_position + alignment - 1u) / alignment * alignment;
+		}
 
-	for (int32_t index = 1; index < num_elements - 1; index++)
-	{
-        value = getSizeOfType(types[index]);
+		ret_offsets[index] = offset;
 		
-		if(value > last_value) 
+		if (offset + getSizeOfType(type) > end_position)
 		{
-			return_value = false;
-			
-			if (verbosity > 0) 
-			{
-				fprintf(stderr, 
-					"checkTypeOrder: \nError! Struture elements must be aranged"
-					" in decreasing size to ensure no padding is added!"
-					" Exiting. Types: %s: %zu > %s: %zu. \n", 
-					typeToString(types[index]), 
-					getSizeOfType(types[index]), 
-					typeToString(types[index - 1]), 
-					last_value
-				);
-			}
+			end_position = offset + getSizeOfType(type);
+		}
+		if (alignment > largest_alignment)
+		{
+			largest_alignment = alignment;
 		}
-        last_value = value;
 	}
 	
-	return return_value; 
-}
+	return 
+		(end_position + largest_alignment - 1u) 
+		/ largest_alignment * largest_alignment;
+} 
 
 bool checkStructSize( 
 	const int32_t  verbosity,
@@ -246,17 +256,28 @@ multi_s clipParameter(
 	return data;
 }
 
-void castToVoid(
+int32_t castToVoid(
 	const int32_t      verbosity,
 	const char        *string,
 	const parameter_s  parameter,
-	      void         *structure
+	      void         *structure,
+	      arena_s      *arena
 	) {
+	
+	/**
+     * Convert string to the type of parameter and write it into structure.
+	 * Strings and arrays are allocated from arena, or with malloc if NULL.
+	 * Returns the number of elements written, which the structure itself 
+	 * does not record for arrays.
+     */
 		
 	const type_e type        = parameter.type;
 	const size_t size = getSizeOfType(type);
 	
-	void *value = NULL;
+	void    *value        = NULL;
+	int32_t  num_elements = 0;
+	multi_s  value_m;
+	array_s  array_m;
 	
 	switch(type)
 	{	
@@ -268,18 +289,29 @@ void castToVoid(
 		case(float_e ):
 		case(char_e  ):
 		case(string_e): 
-			;multi_s value_m = StringToMultiS(verbosity, string, type);
-			         value_m = clipParameter(verbosity, value_m, parameter);
-			           value = (void*) &value_m;
+			value_m = StringToMultiSArena(verbosity, string, type, arena);
+			value_m = clipParameter(verbosity, value_m, parameter);
+			value   = (void*) &value_m;
+			
+			num_elements = 1;
 		break;
 		
 		case(bool_array_e  ):
 		case(int_array_e   ):
 		case(float_array_e ):
+			array_m = 
+				parseArrayArena(verbosity, string, strlen(string), type, arena);
+			value   = (void*) &array_m.data.ff.elements;
+			
+			num_elements = array_m.data.ff.num_elements;
+		break;
+		
 		case(char_array_e  ):
 		case(string_array_e): 
-			;array_s array_m = stringToArrayS(verbosity, string, type);
-			           value = (void*) &array_m.data.ff.elements;
+			array_m = stringToArraySArena(verbosity, string, type, arena);
+			value   = (void*) &array_m.data.ff.elements;
+			
+			num_elements = array_m.data.ff.num_elements;
 		break;
 		
 		
@@ -296,135 +328,32 @@ void castToVoid(
 	}
 	
 	
-	memcpy(structure, value, size);
+	if (value != NULL)
+	{
+		memcpy(structure, value, size);
+	}
+	
+	return num_elements;
 }
 
-void castToVoidArray(
+int32_t castToVoidArray(
 	const int32_t     verbosity,
 	const char       *value_string,
-    const type_e     *types, 
 	const parameter_s parameter,
-    const int32_t     index, 
-          void       *structure
+    const size_t      offset, 
+          void       *structure,
+          arena_s    *arena
     ){
 	
-	const size_t structure_position = 
-		getTotalTypeArraySize(types, index);	
-	
-	castToVoid(
+	return castToVoid(
 		verbosity,
 		value_string, 
 		parameter, 
-		(uint8_t*) &((char*) structure)[structure_position]
+		(uint8_t*) &((char*) structure)[offset],
+		arena
 	);
 }
 
-char *separateString(
-	      char *string,
-	const char *separator,
-	const char *name
-	) {
-	strtok(string, separator);
-	string = strtok(NULL, separator);
-
-	if (string == NULL) {
-
-		fprintf(
-            stderr, 
-            "separateString: Error! Could not find closing %s, for parameter"
-			" %s. \n", 
-            separator, 
-            name
-        );
-		
-		string = "";
-	}
-	
-	return string;
-}
-
-char* pullValueFromLine(
-	const char            *parameter_start,              
-	const loader_syntax_s  syntax,
-	const char            *parameter_name,
-	const type_e           type
-	) {
-	//Splits string from value indicator onwards until new line symbol.
-	char *parameter_copy = strdup(parameter_start);
-	char *value_string   = strtok(parameter_copy, syntax.new_line);
-	
-	switch (type) 
-	{	
-		case (none_e):
-		
-			strtok(value_string, syntax.string_separator);
-			char* string_c = strtok(NULL, syntax.string_separator);
-			
-            if (string_c == NULL) 
-            {	
-                strtok(value_string, syntax.char_separator);
-				string_c = strtok(NULL, syntax.string_separator);
-				
-                if (string_c == NULL) 
-                {
-					removeStringChars(
-                        value_string, 
-                        " =", 
-                        &value_string
-                    );
-				} 
-                else 
-                {
-					value_string = string_c;
-				}
-			} 
-            else 
-            {
-				value_string = string_c;
-			} 
-		break;
-	
-		case (string_e):
-			value_string = 
-				separateString(
-                    value_string, 
-                    syntax.string_separator, 
-                    parameter_name
-                );
-		break;
-		
-		case (char_e):
-			value_string =
-				separateString(
-                    value_string, 
-                    syntax.char_separator, 
-                    parameter_name
-                );	
-		break; 
-		
-		default:
-			removeStringChars(
-                value_string, 
-                " =", 
-                &value_string
-            );
-			removeStringChars(
-				value_string, 
-				syntax.start_array, 
-				&value_string
-			);
-			removeStringChars(
-				value_string, 
-				syntax.end_array, 
-				&value_string
-			);
-
-		break;
-	}
-	
-	return value_string;
-}
-
 bool checkNumParameters(
 	const int32_t  verbosity,
 	const int32_t *num_read,
@@ -608,6 +537,8 @@ bool checkNumExtraParameters(
 		}
 	} 
 	
+	free(entries);
+	
 	return pass;
 }
 
@@ -727,6 +658,8 @@ bool checkExtraParameterRequirments(
 			 total_max
 		);
 	
+	free(entries);
+	
 	return pass;
 }
 
@@ -966,19 +899,27 @@ void addExtraParameter(
 	      char    *value_string
 	) {
 	
-	char* extra_parameter_name = name;
+	// Numbered names only live until insertDictEntry copies them:
+	char extra_parameter_name[strlen(name) + 16];
 	if (num_read > start_index) 
 	{
-		asprintf(
-			&extra_parameter_name, 
+		snprintf(
+			extra_parameter_name, 
+			sizeof(extra_parameter_name),
 			"%s_%i", 
 			name, 
 			index - start_index
 		);
 	} 
+	else
+	{
+		strcpy(extra_parameter_name, name);
+	}
 	
 	multi_s data = 
-		StringToMultiS(verbosity, value_string, type);
+		StringToMultiSArena(
+			verbosity, value_string, type, extra_parameters->arena
+		);
 	insertDictEntry(extra_parameters, data, extra_parameter_name);
 }
 
@@ -1173,38 +1114,35 @@ bool checkLoaderConfig(
     const loader_config_s *defined_subconfigs       = 
 		config.defined_subconfigs;
     
-    // Calculate struct size from types list:
-    
-    type_e  types[num_defined_parameters];
-    for (int32_t index = 0; index < num_defined_parameters; index++) 
-    {	
-        types[index]           = defined_parameters[index].type;
-    }
-    
-	const size_t struct_size = 
-		getTotalTypeArraySize(types, num_defined_parameters);
-    
     bool pass = true;
     
     loader_config_s default_config 
 		= setupDefaultConfig( config);
-    	
-	pass = pass &&
-        checkStructSize(
-            verbosity, 
-            struct_size, 
-            compiled_struct_size, 
-            largest_memory_alignment,
-            config.name
-        );
-
-	pass = pass &&
-        checkTypeOrder(
-            verbosity, 
-            types, 
-            num_defined_parameters
-        );
     
+    // Calculate struct size, with padding, from parameter list, unless the
+    // struct was declared from the parameters:
+    if (!config.layout_declared)
+    {
+        size_t offsets[num_defined_parameters + 1];
+        
+        const size_t struct_size = 
+            getParameterOffsets(
+                defined_parameters, 
+                config.parameter_offsets,
+                num_defined_parameters, 
+                offsets
+            );
+        
+        pass = pass &&
+            checkStructSize(
+                verbosity, 
+                struct_size, 
+                compiled_struct_size, 
+                largest_memory_alignment,
+                config.name
+            );
+    }
+
 	pass = pass && 
         checkDefaultParameter(
             verbosity,
@@ -1238,7 +1176,8 @@ bool checkLoaderConfig(
 
 map_s createParameterMap(
     const int32_t      num_parameters,
-    const parameter_s *parameters
+    const parameter_s *parameters,
+          arena_s     *arena
     ) {
 
 	char   *names[num_parameters];
@@ -1249,7 +1188,7 @@ map_s createParameterMap(
     
     // Create parameter name maping:
 	map_s map = 
-        createMap(names, num_parameters);
+        createMapArena(names, num_parameters, arena);
     
     return map;
 }
@@ -1257,14 +1196,13 @@ map_s createParameterMap(
 map_s createConfigMap(
     const loader_config_s *subconfigs,
     const int32_t          num_subconfigs,
-    const loader_config_s  config
+    const loader_config_s  config,
+          arena_s         *arena
     ) {
     
-     char **names;
+     char *names[(num_subconfigs > 0) ? num_subconfigs : 1];
      if (config.is_superconfig == true) 
      {   
-        names = malloc(sizeof(char*) * (size_t) num_subconfigs);
-        
         for (int32_t index = 0; index < num_subconfigs; index++) 
         {	
             names[index] = subconfigs[index].name;
@@ -1272,13 +1210,12 @@ map_s createConfigMap(
     }
     else
     {
-        names = malloc(sizeof(char*));
         *names = config.name;
     }
     
     // Create config name maping:
     map_s map = 
-        createMap(names, num_subconfigs);
+        createMapArena(names, num_subconfigs, arena);
     
     return map;
 }
@@ -1286,68 +1223,317 @@ map_s createConfigMap(
 parameter_s *overwriteParameters(
     const parameter_s*     default_parameters,
     const map_s            default_parameter_map,
-    const loader_config_s  priority_config
+    const loader_config_s  priority_config,
+          arena_s         *arena,
+          int32_t         *ret_unmatched_index
     ) {
     
+	/**
+     * Copy the default parameters with the priority config's parameters 
+	 * written over those of the same name. Stops at the first priority 
+	 * parameter with no match, which is left for warnUnmatchedParameter() 
+	 * to report when a block actually uses the result.
+     * @param
+     *     const parameter_s     *default_parameters   : base parameters.
+     *     const map_s            default_parameter_map: names of base.
+     *     const loader_config_s  priority_config      : inheriting config.
+     *           arena_s         *arena                : arena, or NULL.
+     *           int32_t         *ret_unmatched_index  : index of unmatched
+	 *                                                   parameter, else -1.
+     * @see warnUnmatchedParameter().
+     * @return parameter_s *new_parameters: merged parameters.
+     */
+	
     const int32_t      num_priority_parameters  = 
 		priority_config.num_defined_parameters;
     const parameter_s *priority_parameters      = 
 		priority_config.defined_parameters;
     
     parameter_s *new_parameters = 
-		malloc(sizeof(parameter_s) * (size_t) default_parameter_map.length);
+		arenaAlloc(
+			arena, 
+			sizeof(parameter_s) * (size_t) default_parameter_map.length
+		);
     memcpy(
 		new_parameters, 
 		default_parameters, 
 		sizeof(parameter_s) * (size_t) default_parameter_map.length
 	);
 	
-    // Create config lists:    
-    map_s priority_name_map = 
-        createParameterMap(
-            num_priority_parameters,
-            priority_parameters
-        );
-
+	*ret_unmatched_index = -1;
+	
     for (int32_t index = 0; index < num_priority_parameters; index++) 
     {
-        const char *parameter_name = getMapKey(priority_name_map, index);
-
-        if (parameter_name != NULL) 
-        {
-            int32_t default_index = 
-				getMapIndex(default_parameter_map, parameter_name);
+        const char *parameter_name = priority_parameters[index].name;
+		
+		const int32_t default_index = (parameter_name != NULL)
+			? getMapIndex(default_parameter_map, parameter_name)
+			: -1;
 
-            if (default_index > -1) 
-            {
-                new_parameters[default_index] = priority_parameters[index];
-            } 
-            else
-            {
-                fprintf(
-					stderr, 
-					"overwriteParameters: \nWarning! Parameter \"%s\" name not"
-					" found in defined parameters! \n", 
-					parameter_name
-				);
-                break;
-            }
-        }
-        else
-        {
-            fprintf(
-				stderr, 
-				"overwriteParameters: \nWarning! Parameter name at index (%i)"
-				" not found, check num defined parameters \n", 
-				index
-			);
-            break;
-        }
+		if (default_index < 0) 
+		{
+			*ret_unmatched_index = index;
+			break;
+		}
+		
+		new_parameters[default_index] = priority_parameters[index];
     }
     
     return new_parameters;
 }
 
+void warnUnmatchedParameter(
+    const int32_t   verbosity,
+    const schema_s *schema
+    ) {
+	
+	/**
+     * Warn that a block is parsed with an inheriting config that names a 
+	 * parameter its base does not define.
+     * @see overwriteParameters().
+     */
+	
+	if ((schema->unmatched_index < 0) || (verbosity < 1))
+	{
+		return;
+	}
+	
+	if (schema->unmatched_name != NULL)
+	{
+		fprintf(
+			stderr, 
+			"overwriteParameters: \nWarning! Parameter \"%s\" name not"
+			" found in defined parameters! \n", 
+			schema->unmatched_name
+		);
+	}
+	else
+	{
+		fprintf(
+			stderr, 
+			"overwriteParameters: \nWarning! Parameter name at index (%i)"
+			" not found, check num defined parameters \n", 
+			schema->unmatched_index
+		);
+	}
+}
+
+void compileSchemaNode(
+          schema_s        *schema,
+          loader_config_s  config,
+    const schema_s        *base,
+          arena_s         *arena
+    ) {
+
+	/**
+     * Compile a single config into schema, and recursively the configs that 
+	 * can be opened inside it.
+     * @param
+     *           schema_s        *schema: schema to fill.
+     *           loader_config_s  config: config to compile.
+     *     const schema_s        *base  : schema an inheriting config takes 
+	 *                                    its parameters from, or NULL.
+     *           arena_s         *arena : arena to allocate from, or NULL.
+     * @see compileSchema(), overwriteParameters().
+     * @return none
+     */
+
+	*schema = (schema_s) 
+	{
+		.owns_parameters = false, 
+		.unmatched_index = -1,
+		.unmatched_name  = NULL,
+		.arena           = arena
+	};
+
+	if ((base != NULL) && config.inherit)
+	{
+		const parameter_s *priority_parameters = config.defined_parameters;
+		
+		config.defined_parameters = 
+			overwriteParameters(
+				base->config.defined_parameters,
+				base->parameter_name_map,
+				config,
+				arena,
+				&schema->unmatched_index
+			);
+		
+		if (schema->unmatched_index > -1)
+		{
+			schema->unmatched_name = 
+				priority_parameters[schema->unmatched_index].name;
+		}
+		config.num_defined_parameters = base->config.num_defined_parameters;
+		config.parameter_offsets      = base->parameter_offsets;
+		config.layout_declared        = base->config.layout_declared;
+
+		schema->owns_parameters = true;
+	}
+
+	schema->config             = config;
+	schema->parameter_name_map = 
+		createParameterMap(
+			config.num_defined_parameters,
+			config.defined_parameters,
+			arena
+		);
+	schema->subconfig_name_map = 
+		createConfigMap(
+			config.defined_subconfigs,
+			config.num_defined_subconfigs,
+			config,
+			arena
+		);
+
+	schema->parameter_offsets = 
+		arenaAlloc(
+			arena, 
+			sizeof(size_t) * (size_t) (config.num_defined_parameters + 1)
+		);
+	getParameterOffsets(
+		config.defined_parameters, 
+		config.parameter_offsets,
+		config.num_defined_parameters, 
+		schema->parameter_offsets
+	);
+
+	if (config.is_superconfig && (config.default_subconfig != NULL))
+	{
+		schema->default_subconfig = arenaAlloc(arena, sizeof(schema_s));
+		compileSchemaNode(
+			schema->default_subconfig, 
+			*config.default_subconfig, 
+			schema,
+			arena
+		);
+
+		schema->num_subconfigs = config.num_defined_subconfigs;
+		schema->subconfigs     = 
+			arenaCalloc(
+				arena, 
+				(size_t) config.num_defined_subconfigs, 
+				sizeof(schema_s)
+			);
+
+		for (int32_t index = 0; index < schema->num_subconfigs; index++)
+		{
+			compileSchemaNode(
+				&schema->subconfigs[index], 
+				config.defined_subconfigs[index], 
+				schema->default_subconfig,
+				arena
+			);
+		}
+	}
+}
+
+schema_s *compileSchemaArena(
+    const loader_config_s  config,
+          arena_s         *arena
+    ) {
+
+	/**
+     * Compile a loader_config_s tree once, so that name maps, offset tables 
+	 * and inherited parameters can be shared by every block of a parse, or 
+	 * by many parses of files with the same layout.
+     * @param
+     *     const loader_config_s  config: top level config to compile.
+     *           arena_s         *arena : arena to compile into, or NULL.
+     * @see readConfigSchema(), freeSchema().
+     * @return schema_s *schema: compiled schema. Free with freeSchema(), or
+	 *                           with the arena it was compiled into.
+     */
+
+	schema_s *schema = arenaAlloc(arena, sizeof(schema_s));
+	compileSchemaNode(schema, config, NULL, arena);
+
+	return schema;
+}
+
+schema_s *compileSchema(
+    const loader_config_s config
+    ) {
+
+	return compileSchemaArena(config, NULL);
+}
+
+void freeSchemaNode(
+    schema_s *schema
+    ) {
+
+	freeMap(schema->parameter_name_map);
+	freeMap(schema->subconfig_name_map);
+	free(schema->parameter_offsets);
+
+	if (schema->owns_parameters)
+	{
+		free(schema->config.defined_parameters);
+	}
+
+	for (int32_t index = 0; index < schema->num_subconfigs; index++)
+	{
+		freeSchemaNode(&schema->subconfigs[index]);
+	}
+	free(schema->subconfigs);
+
+	if (schema->default_subconfig != NULL)
+	{
+		freeSchemaNode(schema->default_subconfig);
+		free(schema->default_subconfig);
+	}
+}
+
+void freeSchema(
+    schema_s *schema
+    ) {
+
+	/**
+     * Deallocate a schema created by compileSchema().
+     * @param
+     *     schema_s *schema: schema to free.
+     * @see compileSchema().
+     * @return none
+     */
+
+	// Arena schemas are released with their arena:
+	if ((schema != NULL) && (schema->arena == NULL))
+	{
+		freeSchemaNode(schema);
+		free(schema);
+	}
+}
+
+const schema_s *findNamedSchema(
+    const schema_s *superschema,
+    const char     *name
+    ) {
+
+	/**
+     * Find the schema a block named name switches to, if any.
+     * @param
+     *     const schema_s *superschema: schema of the enclosing config.
+     *     const char     *name       : block name read from file.
+     * @see compileSchemaNode().
+     * @return const schema_s *schema: named schema, or NULL if not defined.
+     */
+
+	const schema_s *schema = NULL;
+
+	if (name != NULL)
+	{
+		const int32_t index = 
+			getMapIndex(superschema->subconfig_name_map, name);
+
+		if ((index > -1) && (index < superschema->num_subconfigs))
+		{
+			schema = &superschema->subconfigs[index];
+		}
+	}
+
+	return schema;
+}
+
 void freeConfigData(
     loader_data_s config_data
     ) {
@@ -1359,26 +1545,34 @@ void freeConfigData(
 	) {
         if (config_data.subconfigs[index].structure != NULL) 
         {
-            free(config_data.subconfigs[index].structure);
+            arenaFree(
+				config_data.output_arena, 
+				config_data.subconfigs[index].structure
+			);
         }
         if( config_data.subconfigs[index].name != NULL)
         {
-            free(config_data.subconfigs[index].name);
+            arenaFree(config_data.arena, config_data.subconfigs[index].name);
         }
     }
     
     if (config_data.extra_parameters != NULL)
     {
-        free(config_data.extra_parameters);
+        arenaFree(config_data.arena, config_data.extra_parameters);
 		config_data.extra_parameters = NULL;
     }
 	
 	if (config_data.subconfigs != NULL)
     {
-		free(config_data.subconfigs);
+		arenaFree(config_data.arena, config_data.subconfigs);
 		config_data.subconfigs = NULL;
     }
     
+    if (config_data.schema != NULL)
+    {
+		freeSchema(config_data.schema);
+		config_data.schema = NULL;
+    }
 }
 
 void **reorderConfigs(
@@ -1395,12 +1589,14 @@ void **reorderConfigs(
 		config_data.total_num_subconfigs_read;
     const loader_data_s    *subconfig_data = config_data.subconfigs;
     
-    void **config_structs = calloc((size_t) total_num_read, sizeof(void*));
+    void **config_structs = 
+		arenaCalloc(
+			config_data.output_arena, (size_t) total_num_read, sizeof(void*)
+		);
     
     int32_t unique_defined_read = 0;
 	
-    int32_t *cumulative_missing = 
-		malloc(sizeof(int32_t) * (size_t) (num_defined + 1));
+    int32_t cumulative_missing[num_defined + 1];
     cumulative_missing[0] = 0;
 
     for (int32_t index = 0; index < num_defined; index++)
@@ -1444,7 +1640,10 @@ void **keepConfigs(
     const int32_t        total_num_read = config_data.total_num_subconfigs_read;
     const loader_data_s *subconfig_data = config_data.subconfigs;
     
-    void **config_structs = calloc((size_t) total_num_read, sizeof(void*));
+    void **config_structs = 
+		arenaCalloc(
+			config_data.output_arena, (size_t) total_num_read, sizeof(void*)
+		);
     
     for (int32_t index = 0; index < total_num_read; index++) 
     {
@@ -1479,7 +1678,8 @@ void **setConfigStructs(
     }
     else
     {
-        config_structs = calloc((size_t) 1, sizeof(void*));
+        config_structs = 
+			arenaCalloc(config_data.output_arena, (size_t) 1, sizeof(void*));
         config_structs[0] = config_data.structure; 
     }
     
@@ -1487,65 +1687,61 @@ void **setConfigStructs(
 }
 
 loader_data_s setupConfigData(
-    const loader_config_s config,
-    const int32_t         num_configs
+    const schema_s *schema,
+    const int32_t   num_configs,
+          arena_s  *arena,
+          arena_s  *output_arena
     ) {
     
     //Derived Parameters:
-    const size_t       compiled_struct_size   = config.struct_size;
+    const loader_config_s config                 = schema->config;
+    const size_t          compiled_struct_size   = config.struct_size;
     
-    const int32_t      num_defined_parameters = config.num_defined_parameters;
-          parameter_s *defined_parameters     = config.defined_parameters;
-		  int32_t      num_defined_subconfigs = config.num_defined_subconfigs;
+    const int32_t         num_defined_parameters = 
+		config.num_defined_parameters;
+	const int32_t         num_defined_subconfigs = 
+		config.num_defined_subconfigs;
     
+    // Maps and offsets are shared with the schema, not copied:
     loader_data_s config_data = 
 	{
-       .name       = NULL,
-       .subconfigs = NULL,
-       .config     = config
+       .name                      = NULL,
+       .subconfigs                = NULL,
+       .config                    = config,
+       .schema                    = NULL,
+       .parameter_name_map        = schema->parameter_name_map,
+       .parameter_offsets         = schema->parameter_offsets,
+       .subconfig_name_map        = schema->subconfig_name_map,
+       .total_num_subconfigs_read = 0,
+       .arena                     = arena,
+       .output_arena              = output_arena
     };
-       
-    // Create config lists:    
-    config_data.subconfig_name_map = 
-        createConfigMap(
-            config.defined_subconfigs,
-            config.num_defined_subconfigs,
-            config
-        ); 
       
     // Allocate memory for subconfigs:
     config_data.subconfigs = 
-        calloc((size_t) num_configs, sizeof(loader_data_s));
+        arenaCalloc(arena, (size_t) num_configs, sizeof(loader_data_s));
         
-    // Create bins to hold number of each parameter name read:
+    // Create bins to hold number of each parameter and subconfig name read:
+    config_data.num_parameters_read = 
+        arenaCalloc(arena, (size_t) num_defined_parameters, sizeof(int32_t));
+    config_data.parameter_lengths   = 
+        arenaCalloc(arena, (size_t) num_defined_parameters, sizeof(int32_t));
     config_data.num_subconfigs_read = 
-        calloc((size_t) config.num_defined_subconfigs, sizeof(int32_t));
+        arenaCalloc(arena, (size_t) num_defined_subconfigs, sizeof(int32_t));
     
     config_data.structure = 
-        calloc(1, compiled_struct_size);
-
-    // Create parameter name maping:
-    config_data.parameter_name_map = 
-        createParameterMap(
-            num_defined_parameters,
-            defined_parameters
-        );
-
-    config_data.num_parameters_read = 
-        calloc((size_t) num_defined_parameters, sizeof(int32_t));
-    
-    config_data.total_num_subconfigs_read = 0;
+        arenaCalloc(output_arena, 1, compiled_struct_size);
     
     config_data.extra_parameters = 
-        makeDictionary((1+num_defined_parameters)*100);   
+        makeDictionaryArena(0, arena);
 
     // Create dictionary to count instances of extra parameters:
     config_data.num_extra_parameters = 
-        makeDictionary((1+num_defined_parameters)*100);
+        makeDictionaryArena(0, arena);
 	
 	// Create dictionary to count instances of extra subconfigs:
 	config_data.num_extra_configs = 
-        makeDictionary((1+num_defined_subconfigs)*100);
+        makeDictionaryArena(0, arena);
 
     return config_data;
 }
@@ -1554,44 +1750,21 @@ bool checkAllParameterRequirments(
     const int32_t         verbosity,
     const loader_data_s   config_data,
     const loader_config_s default_config,
-    const loader_config_s superconfig
+    const schema_s       *superschema
     ) {
     
     bool pass = true;
     
     loader_config_s config = default_config;
 
-    const char *name = config_data.name;
-	
-    if (name != NULL)
-    {
-        const map_s subconfig_name_map =
-            createConfigMap(
-                superconfig.defined_subconfigs,
-                superconfig.num_defined_subconfigs,
-                superconfig
-            );
-
-        const int32_t config_name_index = 
-                getMapIndex(subconfig_name_map, name);
-
-        if (config_name_index > -1) 
-        {
-			if (config.inherit) 
-			{
-				config = superconfig.defined_subconfigs[config_name_index];
+    // Inheriting configs are checked against their named parameters:
+	const schema_s *named_schema = 
+		findNamedSchema(superschema, config_data.name);
 
-				config.defined_parameters = overwriteParameters(
-					config_data.config.defined_parameters,
-					config_data.parameter_name_map,
-					config
-				);
-				
-				config.num_defined_parameters = 
-					config_data.config.num_defined_parameters;
-			}
-        }
-    }
+	if ((named_schema != NULL) && config.inherit) 
+	{
+		config = named_schema->config;
+	}
 
     // Check neccesity requirements:
     if (!checkParameterRequirements(
@@ -1625,9 +1798,11 @@ bool checkAllRequirements(
     const int32_t         verbosity,
     const loader_data_s   config_data,
     const loader_config_s config,
-    const loader_config_s superconfig
+    const schema_s       *superschema
     ) {
     
+    CONFIG_STATS_BEGIN(requirements);
+    
     bool pass = true;
     
     if (config.is_superconfig)
@@ -1651,122 +1826,325 @@ bool checkAllRequirements(
             verbosity,
             config_data,
             config,
-            superconfig
+            superschema
             ))
         {
             pass = false;
         }
     }
     
+    CONFIG_STATS_END(requirements);
+    
     return pass;
 }
 
-loader_config_s allocateNewConfig(
-          loader_data_s   *config_data,
-          loader_config_s *config,
-    const loader_config_s  superconfig,
-          loader_config_s  default_config,
-    const int32_t          config_name_index
+void allocateNewConfig(
+          loader_data_s  *config_data,
+    const schema_s       *schema
     ) { 
     
-    const int32_t num_defined_subconfigs = 
-        config->num_defined_subconfigs;
+	/**
+     * Switch a block being read over to the non inheriting config its name
+	 * selected, keeping any values and counts already read.
+     * @param
+     *           loader_data_s *config_data: data of block being read.
+     *     const schema_s      *schema     : compiled schema of named config.
+     * @see findNamedSchema().
+     * @return none
+     */
+	
+    const loader_config_s *config = &schema->config;
 
+    const int32_t num_defined_subconfigs = 
+        config_data->config.num_defined_subconfigs;
     const int32_t num_defined_parameters = 
-        config->num_defined_parameters;
-
-    *config = 
-        superconfig.defined_subconfigs[config_name_index];
-
-    if (config->inherit)
-    {
-        config->defined_parameters = overwriteParameters(
-            config_data->config.defined_parameters,
-            config_data->parameter_name_map,
-            *config
+        config_data->config.num_defined_parameters;
+    const size_t  old_struct_size        = 
+		config_data->config.struct_size;
+        
+    config_data->config             = *config;
+    config_data->parameter_name_map = schema->parameter_name_map;
+    config_data->parameter_offsets  = schema->parameter_offsets;
+    config_data->subconfig_name_map = schema->subconfig_name_map;
+
+    config_data->num_subconfigs_read = 
+        arenaRealloc(
+            config_data->arena,
+            config_data->num_subconfigs_read, 
+            (size_t) num_defined_subconfigs * sizeof(int32_t),
+            (size_t) config->num_defined_subconfigs
+            * sizeof(int32_t)
         );
-
-        config->num_defined_parameters = 
-            config_data->config.num_defined_parameters;
+        
+    for (
+        int32_t index = num_defined_subconfigs; 
+        index < config->num_defined_subconfigs;
+        index++
+        ) {
+        
+        config_data->num_subconfigs_read[index] = 0;        
     }
-    else
-    {
-        config_data->config = *config;
-        config_data->parameter_name_map = 
-            createParameterMap(
-                config->num_defined_parameters,
-                config->defined_parameters
-            );
-
-        config_data->num_subconfigs_read = 
-            realloc(
-                config_data->num_subconfigs_read, 
-                (size_t) config->num_defined_subconfigs
-                * sizeof(int32_t)
-            );
-            
-        for (
-            int32_t index = num_defined_subconfigs; 
-            index < config->num_defined_subconfigs;
-            index++
-            ) {
-            
-            config_data->num_subconfigs_read[index] = 0;        
-        }
+    
+    config_data->num_parameters_read = 
+        arenaRealloc(
+            config_data->arena,
+            config_data->num_parameters_read,
+            (size_t) num_defined_parameters * sizeof(int32_t),
+            (size_t) config->num_defined_parameters 
+            * sizeof(int32_t)
+        );
         
-        config_data->num_parameters_read = 
-            realloc(
-                config_data->num_parameters_read,
-                (size_t) config->num_defined_parameters 
-                * sizeof(int32_t)
-            );
-            
-        for (
-            int32_t index = num_defined_parameters; 
-            index < config->num_defined_parameters;
-            index++
-            ) {
-            
-            config_data->num_parameters_read[index] = 0;        
-        }
-
-        if (config->is_superconfig)
-        {
-            config_data->subconfig_name_map = 
-                createConfigMap(
-                    config->defined_subconfigs,
-                    config->num_defined_subconfigs,
-                    *config
-                ); 
-        }
+    config_data->parameter_lengths = 
+        arenaRealloc(
+            config_data->arena,
+            config_data->parameter_lengths,
+            (size_t) num_defined_parameters * sizeof(int32_t),
+            (size_t) config->num_defined_parameters 
+            * sizeof(int32_t)
+        );
         
-        default_config = setupDefaultConfig(*config);
+    for (
+        int32_t index = num_defined_parameters; 
+        index < config->num_defined_parameters;
+        index++
+        ) {
+        
+        config_data->num_parameters_read[index] = 0;        
+        config_data->parameter_lengths[index]   = 0;        
     }
     
-    return default_config;
+    // Named config may be larger than the default it was set up with:
+    if (config->struct_size > old_struct_size)
+    {
+        config_data->structure = 
+            arenaRealloc(
+                config_data->output_arena,
+                config_data->structure, 
+                old_struct_size,
+                config->struct_size
+            );
+        memset(
+            &((uint8_t*) config_data->structure)[old_struct_size], 
+            0, 
+            config->struct_size - old_struct_size
+        );
+    }
+}
+
+type_e guessTypeFromToken(
+	const token_e  token_type,
+	const char    *value_string
+	) {
+
+	/**
+     * Guess the type of an undefined parameter from the token its value was
+     * read from.
+     * @param
+     *     const token_e  token_type  : type of first value token.
+     *     const char    *value_string: value text with separators removed.
+     * @see guessDataTypeFromString().
+     * @return type_e estimated_type: guessed type.
+     */
+
+	type_e estimated_type = none_e;
+
+	switch (token_type)
+	{
+		case (token_string_e):
+			estimated_type = string_e;
+		break;
+
+		case (token_char_e):
+			estimated_type = char_e;
+		break;
+
+		case (token_array_e):
+			switch (guessDataTypeFromString(value_string))
+			{
+				case bool_e  : estimated_type = bool_array_e  ; break;
+				case int_e   : estimated_type = int_array_e   ; break;
+				case float_e : estimated_type = float_array_e ; break;
+				case char_e  : estimated_type = char_array_e  ; break;
+				case string_e: estimated_type = string_array_e; break;
+				default      : estimated_type = none_e        ; break;
+			}
+		break;
+
+		default:
+			estimated_type = guessDataTypeFromString(value_string);
+		break;
+	}
+
+	return estimated_type;
+}
+
+const char *pullValueFromTokens(
+	      token_stream_s  *stream,
+	const loader_syntax_s  syntax,
+	const char            *parameter_name,
+	const type_e           type,
+	      token_e         *ret_token_type
+	) {
+
+	/**
+     * Consume the value tokens following a value indicator up to the end of
+     * the statement and return the value text for the entered type.
+     * @param
+     *           token_stream_s  *stream        : stream positioned after the
+     *                                            value indicator.
+     *     const loader_syntax_s  syntax        : config syntax.
+     *     const char            *parameter_name: name used in warnings.
+     *     const type_e           type          : type of parameter.
+     *           token_e         *ret_token_type: type of token the value was
+     *                                            taken from.
+     * @see tokeniseBuffer(), copyTokenText().
+     * @return const char *value_string: null terminated value, valid until 
+     *                                   the next value is pulled.
+     */
+
+	const token_s *first        = NULL;
+	const token_s *last         = NULL;
+	const token_s *first_string = NULL;
+	const token_s *first_char   = NULL;
+
+	while (stream->index < stream->num_tokens)
+	{
+		const token_s *token = &stream->tokens[stream->index];
+
+		if (token->type == token_new_line_e)
+		{
+			stream->index++;
+			break;
+		}
+		else if (
+			   (token->type == token_value_e )
+			|| (token->type == token_string_e)
+			|| (token->type == token_char_e  )
+			|| (token->type == token_array_e )
+		) {
+			if (first == NULL)
+			{
+				first = token;
+			}
+			if ((first_string == NULL) && (token->type == token_string_e))
+			{
+				first_string = token;
+			}
+			if ((first_char == NULL) && (token->type == token_char_e))
+			{
+				first_char = token;
+			}
+			last = token;
+		}
+		else if (token->type != token_comment_e)
+		{
+			// Structural tokens end the value but belong to the caller:
+			break;
+		}
+		
+		stream->index++;
+	}
+
+	const token_s *separated = NULL;
+	const char    *separator = NULL;
+
+	switch (type)
+	{
+		case (string_e):
+			separated = first_string;
+			separator = syntax.string_separator;
+		break;
+
+		case (char_e):
+			separated = first_char;
+			separator = syntax.char_separator;
+		break;
+
+		case (none_e):
+			separated = (first_string != NULL) ? first_string : first_char;
+		break;
+
+		default:
+		break;
+	}
+
+	const char *value_string = "";
+	*ret_token_type          = (first != NULL) ? first->type : token_none_e;
+
+	if (separated != NULL)
+	{
+		*ret_token_type = separated->type;
+		value_string    = 
+			copyTokenText(
+				&stream->value_scratch,
+				separated->start,
+				separated->length,
+				false,
+				NULL
+			);
+	}
+	else if (separator != NULL)
+	{
+		fprintf(
+			stderr, 
+			"separateString: Error! Could not find closing %s, for parameter"
+			" %s. \n", 
+			separator, 
+			parameter_name
+		);
+	}
+	else if (first != NULL)
+	{
+		// Whole value span with whitespace and array brackets removed, bar 
+		// numeric arrays which parseArrayArena() reads as they are:
+		char remove[3] = {*syntax.start_array, *syntax.end_array, '\0'};
+
+		const bool keep_span = 
+			   (type == bool_array_e) 
+			|| (type == int_array_e) 
+			|| (type == float_array_e);
+
+		value_string = 
+			copyTokenText(
+				&stream->value_scratch,
+				first->start,
+				(size_t) (last->start - first->start) + last->length,
+				!keep_span,
+				keep_span ? NULL : remove
+			);
+	}
+
+	return value_string;
 }
 
 loader_data_s readSubconfig(
     const int32_t            verbosity,
           loader_syntax_s    syntax,
-          loader_config_s    config,
-          loader_config_s    superconfig,
-          FILE              *file
+    const schema_s          *schema,
+    const schema_s          *superschema,
+          token_stream_s    *stream,
+          arena_s           *arena,
+          arena_s           *output_arena,
+          parsed_block_s    *blocks,
+    const int32_t            num_blocks
     ) {
     
     //Derived Parameters:
-    const bool         is_superconfig         = config.is_superconfig;
-
-    const int32_t      num_defined_parameters = config.num_defined_parameters;
-          parameter_s *defined_parameters     = config.defined_parameters;
-          parameter_s  default_parameter      = config.default_parameter;
+          loader_config_s  config                 = schema->config;
+    const bool             is_superconfig         = config.is_superconfig;
+          parameter_s      default_parameter      = config.default_parameter;
+    
+    // Schema config_data is currently laid out with, changes if the block's 
+    // name selects a non inheriting config:
+    const schema_s        *data_schema            = schema;
     
     int32_t num_configs  = 1;
     int32_t config_index = 0;
+    int32_t block_index  = 0;
     
     //Setup config_data:
     loader_data_s config_data = 
-        setupConfigData(config, num_configs);
+        setupConfigData(schema, num_configs, arena, output_arena);
     
     if (!checkLoaderConfig(verbosity, config) ) 
     {	
@@ -1778,109 +2156,105 @@ loader_data_s readSubconfig(
 	} 
 	else 
 	{
-        // Setup Default Configs:
-        loader_config_s default_config = 
-            setupDefaultConfig(config);
-        
-        // Create parameter lists:
-        type_e  types[num_defined_parameters];
-        for (int32_t index = 0; index < num_defined_parameters; index++) 
-        {	
-            types[index]           = defined_parameters[index].type;
-        }
-
+		warnUnmatchedParameter(verbosity, schema);
+		
 		// Setup and reset config wide parameters:
         bool             name_read    = false;
-		size_t           line_length  = 1; 
-		// String which will contain the read in line:
-		char            *line_string  = NULL; 
-		int32_t          line_index   = 0;
         char            *config_name  = NULL;
 
-		// Reading file, loop over lines:
-		while (getline(&line_string, &line_length, file) != EOF) 
+		// Reading token stream, loop over tokens:
+		while (stream->index < stream->num_tokens) 
 		{
-			line_index++;
-			
-			// Setup and reset line wide parameters:
-			bool     parameter_read       = false;
-            bool     parameter_end        = false;
-			bool     get_value            = false;
-			int32_t  parameter_start      = 0;
-
-			int32_t  parameter_index      = 0;
-			type_e   parameter_type       = bool_e;
-			char    *parameter_name       = calloc(line_length, sizeof(char));
-			bool     parameter_recognised = false;
-
-			int32_t  char_index = 0;
-			
-			// Reading Line, loop over characters:
-			while(line_string[char_index] != 0) 
-			{                 
-				// Checks for config closing anywhere in line:
-				if (strchr(syntax.end_config, line_string[char_index])) 
-				{				
+			const token_s token = stream->tokens[stream->index];
+			stream->index++;
+
+			switch (token.type)
+			{
+				// Checks for config closing:
+				case (token_close_config_e):
+				{
 					config_data.total_num_subconfigs_read = config_index;
-                                                            
-                    if (!checkAllRequirements(
-                        verbosity,
-                        config_data,
-                        config,
-                        superconfig))
-                    {
-                        config_data.total_num_subconfigs_read = -1;
-                    }
-                                        
-                    return config_data;
-				} 
-
-				// Checks for new config opening anywhere in line:
-				if (
-					   (strchr(syntax.start_config, line_string[char_index])) 
-					&& is_superconfig
-				) {                      
+															
+					if (!checkAllRequirements(
+						verbosity,
+						config_data,
+						config,
+						superschema))
+					{
+						config_data.total_num_subconfigs_read = -1;
+					}
+										
+					return config_data;
+				}
+
+				// Checks for new config opening:
+				case (token_open_config_e):
+				{
+					if (!is_superconfig)
+					{
+						fprintf(
+							stderr, 
+							"readSubconfig: \nWarning! Unexpected config opening:"
+							" '{' in config \"%s\". Exiting read attempt! \n", 
+							config_data.name
+						); 
+
+						config_data.total_num_subconfigs_read = -1;
+						return config_data;
+					}
+
                     // If number of configs greater than allocated in memory,
                     // allocate more memory:
                     if ((config_index >= num_configs))
                     {
+                        const int32_t old_num_configs = num_configs;
+                        
                         num_configs = 
                             (int32_t) ceil((float) num_configs * 1.5f);
                         config_data.subconfigs = 
-                            realloc(
-								config_data.subconfigs, 
-								sizeof(loader_data_s) * (size_t) num_configs
-							);
+                            arenaRealloc(
+									arena,
+									config_data.subconfigs, 
+									sizeof(loader_data_s) 
+									* (size_t) old_num_configs,
+									sizeof(loader_data_s) * (size_t) num_configs
+								);
                     }
 
-                    // Intilise subconfig to default:
-                    loader_config_s old_config = config;
-                                    config     = default_config;
-						
-					if (config.inherit)
-					{
-						// Set default parameters:    
-						config.defined_parameters = overwriteParameters(
-							config_data.config.defined_parameters,
-							config_data.parameter_name_map,
-							config
-						);
-
-						config.num_defined_parameters = 
-							config_data.config.num_defined_parameters;
-					}
-                                        
-                    config_data.subconfigs[config_index].config = config;
-					
-                    config_data.subconfigs[config_index] = readSubconfig(
-                        verbosity,
-                        syntax,
-                        config,
-                        config_data.config,
-                        file
-                    );  
-					
-					char_index = 0;
+                    // Take the block's result from the parallel pre-pass if 
+                    // it has one:
+                    parsed_block_s *block = NULL;
+                    if (
+                           (block_index < num_blocks)
+                        && (blocks[block_index].open_index 
+                            == stream->index - 1)
+                    ) {
+                        block = &blocks[block_index];
+                        block_index++;
+                    }
+                    
+                    if ((block != NULL) && block->consumed)
+                    {
+                        config_data.subconfigs[config_index] = block->data;
+                        stream->index = block->close_index + 1;
+                        block->used   = true;
+                    }
+                    else
+                    {
+                        // Intilise subconfig to default, with any inherited 
+                        // parameters already applied by the schema:
+                        config_data.subconfigs[config_index] = readSubconfig(
+                            verbosity,
+                            syntax,
+                            data_schema->default_subconfig,
+                            data_schema,
+                            stream,
+                            arena,
+                            output_arena,
+                            NULL,
+                            0
+                        );  
+                    }
 
                     if (config_data.subconfigs[config_index]
                         .total_num_subconfigs_read < 0)
@@ -1894,8 +2268,13 @@ loader_data_s readSubconfig(
 					
                     if (name != NULL)
                     {
+                        CONFIG_STATS_BEGIN(lookup);
+                        
                         const int32_t config_name_index = 
                             getMapIndex(config_data.subconfig_name_map, name);
+                        
+                        CONFIG_STATS_END(lookup);
+                        CONFIG_STATS_COUNT(lookups, 1);
 						
                         if (config_name_index > -1) 
                         {
@@ -1921,8 +2300,6 @@ loader_data_s readSubconfig(
                                     data, 
                                     name
                                 );		
-
-                                data.value.i++;	
                             }
                             else
                             {
@@ -1931,7 +2308,6 @@ loader_data_s readSubconfig(
                         }   
                     }
                     
-                    config = old_config;
 					config_index++; 
 					
 					// Checks for new segment character returns if found:
@@ -1943,60 +2319,40 @@ loader_data_s readSubconfig(
 							verbosity,
 							config_data,
 							config,
-							superconfig))
+							superschema))
 						{
 							config_data.total_num_subconfigs_read = -1;
 						}
 
 						return config_data;
 					}
-					                    
-                    break;	
-				}                 
-				else if (strchr(syntax.start_config, line_string[char_index]))
-				{
-                    fprintf(
-						stderr, 
-						"readSubconfig: \nWarning! Unexpected config opening:"
-						" '{' in config \"%s\". Exiting read attempt! \n", 
-						config_data.name
-					); 
-
-                    config_data.total_num_subconfigs_read = -1;
-                    return config_data;
 				}
+				break;
                 
-                // Checks for config name character and reads name if found:
-                if (strchr(syntax.start_name, line_string[char_index])) 
-				{ 	
+                // Checks for config name and reads name if found:
+				case (token_name_e):
+				{
                     if (name_read == false) 
                     {
-                        config_name = 
-							strtok(
-                                &line_string[char_index + 1], syntax.end_name
-                            );
-                        config_data.name = strdup(config_name);
+                        config_data.name = 
+                            arenaStrndup(arena, token.start, token.length);
+						config_name      = config_data.name;
 						
-                        const map_s subconfig_name_map =
-                        createConfigMap(
-                            superconfig.defined_subconfigs,
-                            superconfig.num_defined_subconfigs,
-                            superconfig
-                        );
-                        
-                        const int32_t config_name_index = 
-                                getMapIndex(subconfig_name_map, config_name);
+                        const schema_s *named_schema = 
+                            findNamedSchema(superschema, config_name);
 								
-                        if (config_name_index > -1) 
+                        if (named_schema != NULL) 
                         {
-                        
-                            default_config = allocateNewConfig(
-                                &config_data,
-                                &config,
-                                superconfig,
-                                default_config,
-                                config_name_index
-                            );
+                            config = named_schema->config;
+                            
+                            warnUnmatchedParameter(verbosity, named_schema);
+                            
+                            // Inheriting configs keep the current layout:
+                            if (!config.inherit)
+                            {
+                                allocateNewConfig(&config_data, named_schema);
+                                data_schema = named_schema;
+                            }
                         }
 												                        
                         name_read = true;
@@ -2014,43 +2370,35 @@ loader_data_s readSubconfig(
 						config_data.total_num_subconfigs_read = -1;
 						return config_data;
                     }
-					break; 
-				}
-    
-				// Checks for comment character and starts a new line if found:
-				if (strchr(syntax.comment, line_string[char_index])) 
-				{ 	
-					break; 
 				}
+				break;
 
-				// Finding start parameter names in line:
-				if (!isspace(line_string[char_index]) && !parameter_read) 
-				{ 	
-					parameter_start = char_index;
-					parameter_read = !parameter_read;
-				}
-                
-				// Recording parameter name into string:
-				if (parameter_read && !isspace(line_string[char_index])) 
-				{	
-					parameter_name[char_index - parameter_start] = 
-						line_string[char_index];
-				}
-				
-				// On parameter name end:
-				else if (
-					   isspace(line_string[char_index]) 
-					&& (!parameter_end && parameter_read)
-				) {                
-                    parameter_end = true;
-                    
+				// Reads parameter name and value if found:
+				case (token_identifier_e):
+				{
+					bool        parameter_recognised = false;
+					int32_t     parameter_index      = 0;
+					type_e      parameter_type       = bool_e;
+					const char *parameter_name       = NULL;
+
+					// Look up the name view directly in the mapped buffer:
+					CONFIG_STATS_BEGIN(lookup);
+					
 					parameter_index = 
-						getMapIndex(
-                            config_data.parameter_name_map, parameter_name
+						getMapIndexN(
+                            config_data.parameter_name_map, 
+							token.start,
+							token.length
                         );
+					
+					CONFIG_STATS_END(lookup);
+					CONFIG_STATS_COUNT(lookups, 1);
                         										
 					if (parameter_index > -1) 
 					{
+						parameter_name = 
+							config_data.config
+                                .defined_parameters[parameter_index].name;
 						parameter_type = 
 							config_data.config
                                 .defined_parameters[parameter_index].type;
@@ -2060,6 +2408,15 @@ loader_data_s readSubconfig(
 					} 
 					else 
 					{	
+						// Unrecognised names are kept, so need a copy:
+						parameter_name = 
+							copyTokenText(
+								&stream->name_scratch, 
+								token.start, 
+								token.length, 
+								false, 
+								NULL
+							);
 						parameter_type = default_parameter.type;
 						
 						dict_entry_s* entry = 
@@ -2078,9 +2435,7 @@ loader_data_s readSubconfig(
 								config_data.num_extra_parameters, 
 								data, 
 								parameter_name
-							);		
-							
-							data.value.i++;	
+							);
 						}
 						else
 						{
@@ -2102,29 +2457,33 @@ loader_data_s readSubconfig(
 							);
 						}
 					}
-					
-					get_value = true;
-				}
 
-				//Finds the value after detecting value indicatior character
-				if (
-					   get_value
-					&& strchr(syntax.value_indicator, line_string[char_index])
-				) {	
-					char *value_string = 
-						pullValueFromLine(
-							&line_string[char_index],
+					// Finds the value if followed by value indicator:
+					if (
+						   (stream->index >= stream->num_tokens)
+						|| (stream->tokens[stream->index].type 
+							!= token_value_indicator_e)
+					) {
+						break;
+					}
+					stream->index++;
+
+					CONFIG_STATS_BEGIN(convert);
+
+					token_e     value_token_type = token_none_e;
+					const char *value_string     = 
+						pullValueFromTokens(
+							stream,
 							syntax,
 							parameter_name,
-							parameter_type 
+							parameter_type,
+							&value_token_type
 						);
 					
 					if (parameter_type == none_e) 
 					{
-						parameter_type = guessTypeFromConfigContext(
-							value_string, 
-							syntax
-						);
+						parameter_type = 
+							guessTypeFromToken(value_token_type, value_string);
 					}
 					
 					if (value_string != NULL) 
@@ -2144,13 +2503,14 @@ loader_data_s readSubconfig(
 						if (   (parameter_recognised) 
 							&& (config_data.num_parameters_read[parameter_index] < 2)
 						) {
+							config_data.parameter_lengths[parameter_index] = 
 							castToVoidArray(
 								verbosity,
 								value_string, 
-								types, 
 								config.defined_parameters[parameter_index],
-								parameter_index, 
-								config_data.structure
+								config_data.parameter_offsets[parameter_index], 
+								config_data.structure,
+								output_arena
 							);
 						}
 						else 
@@ -2158,15 +2518,17 @@ loader_data_s readSubconfig(
 							addExtraParameter(
 								verbosity,
 								config_data.extra_parameters,
-								parameter_name,
+								(char*) parameter_name,
 								parameter_type,
 								parameter_index, 
 								extra_parameter_start_index, 
 								config_data
                                     .num_parameters_read[parameter_index],
-								value_string
+								(char*) value_string
 							);
 						}
+						
+						CONFIG_STATS_COUNT(conversions, 1);
 					} 
                     else 
                     {
@@ -2180,14 +2542,14 @@ loader_data_s readSubconfig(
                             );
                         }
 					}
-
-					//Resets parameter name:
-					memset(parameter_name, 0, strlen(parameter_name));
-
-					get_value = false;
+					
+					CONFIG_STATS_END(convert);
 				}
+				break;
 
-				char_index++; 
+				// Comments and stray tokens are skipped:
+				default:
+				break;
 			}
 		}
         
@@ -2197,8 +2559,8 @@ loader_data_s readSubconfig(
     if (!checkAllRequirements(
 			verbosity,
 			config_data,
-			superconfig,
-			superconfig
+			superschema->config,
+			superschema
 		)
 	) {
         config_data.total_num_subconfigs_read = -1;
@@ -2207,40 +2569,376 @@ loader_data_s readSubconfig(
     return config_data;
 }
 
-void* readConfig(
+parsed_block_s *findTopLevelBlocks(
+    const token_stream_s *stream,
+    const int32_t         max_num_blocks,
+          int32_t        *ret_num_blocks
+    ) {
+    
+	/**
+     * Find the token span of each top level config block by brace matching,
+	 * so the blocks can be parsed independently.
+     * @param
+     *     const token_stream_s *stream        : token stream of whole buffer.
+     *     const int32_t         max_num_blocks: stop after this many blocks.
+     *           int32_t        *ret_num_blocks: number of blocks found.
+     * @see parseBlocksParallel().
+     * @return parsed_block_s *blocks: closed blocks in file order, or NULL if
+	 *                                 the top level names itself, which can
+	 *                                 change the schema of the blocks.
+     */
+	
+	int32_t         num_blocks     = 0;
+	int32_t         max_num_found  = 16;
+	parsed_block_s *blocks         = 
+		malloc(sizeof(parsed_block_s) * (size_t) max_num_found);
+	
+	int32_t depth      = 0;
+	int32_t open_index = 0;
+	
+	for (
+		int32_t index = stream->index; 
+		(index < stream->num_tokens) && (num_blocks < max_num_blocks); 
+		index++
+	) {
+		switch (stream->tokens[index].type)
+		{
+			case (token_open_config_e):
+				if (depth == 0)
+				{
+					open_index = index;
+				}
+				depth++;
+			break;
+			
+			case (token_close_config_e):
+				depth--;
+				if (depth == 0)
+				{
+					if (num_blocks >= max_num_found)
+					{
+						max_num_found *= 2;
+						blocks = 
+							realloc(
+								blocks, 
+								sizeof(parsed_block_s) * (size_t) max_num_found
+							);
+					}
+					
+					blocks[num_blocks] = (parsed_block_s) 
+					{
+						.open_index  = open_index,
+						.close_index = index,
+						.consumed    = false,
+						.used        = false,
+						.arena       = NULL
+					};
+					num_blocks++;
+				}
+				// Stray closing brace ends the top level read:
+				else if (depth < 0)
+				{
+					index = stream->num_tokens;
+				}
+			break;
+			
+			case (token_name_e):
+				if (depth == 0)
+				{
+					free(blocks);
+					*ret_num_blocks = 0;
+					
+					return NULL;
+				}
+			break;
+			
+			default:
+			break;
+		}
+	}
+	
+	*ret_num_blocks = num_blocks;
+	
+	return blocks;
+}
+
+void setConfigDataArenas(
+    loader_data_s *config_data,
+    arena_s       *arena,
+    arena_s       *output_arena
+    ) {
+	
+	/**
+     * Point a parsed block, and the blocks inside it, at the arenas its
+	 * memory was merged into.
+     */
+	
+	config_data->arena        = arena;
+	config_data->output_arena = output_arena;
+	
+	config_data->extra_parameters->arena     = arena;
+	config_data->num_extra_parameters->arena = arena;
+	config_data->num_extra_configs->arena    = arena;
+	
+	for (
+		int32_t index = 0; 
+		index < config_data->total_num_subconfigs_read; 
+		index++
+	) {
+		setConfigDataArenas(&config_data->subconfigs[index], arena, output_arena);
+	}
+}
+
+void parseBlocksParallel(
+    const int32_t          verbosity,
+    const loader_syntax_s  syntax,
+    const schema_s        *schema,
+    const token_stream_s  *stream,
+          parsed_block_s  *blocks,
+    const int32_t          num_blocks,
+          arena_s         *arena,
+          arena_s         *output_arena
+    ) {
+	
+	/**
+     * Parse top level config blocks concurrently, each into its own 
+	 * loader_data_s. The schema is shared read only. With an arena, each 
+	 * block allocates from a private arena that is merged afterwards.
+     * @param
+     *     const int32_t          verbosity   : verbosity level of warnings.
+     *     const loader_syntax_s  syntax      : syntax of config file.
+     *     const schema_s        *schema      : schema of top level config.
+     *     const token_stream_s  *stream      : token stream of whole buffer.
+     *           parsed_block_s  *blocks      : blocks from findTopLevelBlocks.
+     *     const int32_t          num_blocks  : number of blocks.
+     *           arena_s         *arena       : arena for the parse, or NULL.
+     *           arena_s         *output_arena: arena for outputs, or NULL.
+     * @see findTopLevelBlocks(), readSubconfig().
+     * @return none
+     */
+	
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		blocks[index].arena = 
+			(arena != NULL) ? createArena(arena->block_size) : NULL;
+	}
+	
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		parsed_block_s *block = &blocks[index];
+		
+		// View of the block's tokens, just past its opening brace:
+		token_stream_s block_stream = 
+		{
+			.buffer        = stream->buffer,
+			.buffer_length = stream->buffer_length,
+			.tokens        = &stream->tokens[block->open_index + 1],
+			.num_tokens    = block->close_index - block->open_index,
+			.index         = 0,
+			.name_scratch  = {NULL, 0},
+			.value_scratch = {NULL, 0}
+		};
+		
+		block->data = 
+			readSubconfig(
+				verbosity,
+				syntax,
+				schema->default_subconfig,
+				schema,
+				&block_stream,
+				block->arena,
+				(output_arena != NULL) ? block->arena : NULL,
+				NULL,
+				0
+			);
+		
+		block->consumed = 
+			   (block_stream.index == block_stream.num_tokens)
+			&& (block->data.total_num_subconfigs_read >= 0);
+		
+		free(block_stream.name_scratch.data);
+		free(block_stream.value_scratch.data);
+	}
+	
+	if (arena != NULL)
+	{
+		for (int32_t index = 0; index < num_blocks; index++)
+		{
+			mergeArena(arena, blocks[index].arena);
+			freeArena(blocks[index].arena);
+			blocks[index].arena = NULL;
+			
+			setConfigDataArenas(&blocks[index].data, arena, output_arena);
+		}
+	}
+}
+
+void freeParsedBlocks(
+    parsed_block_s *blocks,
+    const int32_t   num_blocks
+    ) {
+	
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		if (!blocks[index].used)
+		{
+			arenaFree(
+				blocks[index].data.output_arena, 
+				blocks[index].data.structure
+			);
+			freeConfigData(blocks[index].data);
+		}
+	}
+	
+	free(blocks);
+}
+
+void* readConfigSchemaArena(
 	 const int32_t            verbosity,
      const char              *file_name,  
-	 const loader_config_s    config,
+	 const schema_s          *schema,
+	       arena_s           *arena,
+	 const bool               outputs_in_arena,
 	       loader_data_s     *ret_cofig_data,
            int64_t           *file_position
     ){
+	
+	/**
+     * Read config file, from file_position onwards, with a precompiled 
+	 * schema. The schema is only read, so can be reused across reads. 
+	 * Parse bookkeeping is allocated from arena, so the whole read can be 
+	 * released with one freeArena().
+     * @param
+     *     const int32_t        verbosity       : verbosity level of warnings.
+     *     const char          *file_name       : path of config file.
+     *     const schema_s      *schema          : schema from compileSchema().
+     *           arena_s       *arena           : arena for the parse, or NULL
+	 *                                            for malloc.
+     *     const bool           outputs_in_arena: also allocate the returned
+	 *                                            structures, strings and 
+	 *                                            arrays from arena, otherwise
+	 *                                            they use malloc and outlive 
+	 *                                            it.
+     *           loader_data_s *ret_cofig_data  : parse data of read, valid
+	 *                                            while arena is.
+     *           int64_t       *file_position   : byte to start reading at, 
+	 *                                            moved past the last line 
+	 *                                            read.
+     * @see compileSchemaArena(), readConfigArena().
+     * @return void *config_structs: array of config structures, or NULL on
+	 *                               failure.
+     */
+    
+    CONFIG_STATS_BEGIN(total);
+    CONFIG_STATS_COUNT(reads, 1);
+    
+    arena_s *output_arena = outputs_in_arena ? arena : NULL;
         
     // Initlise empty pointer:
     void    *config_structs       = NULL;
         
-	// Opening file:
-	FILE* file = NULL;	
-        
     loader_data_s config_data;
     config_data.total_num_subconfigs_read = -1;
 	config_data.extra_parameters          = NULL;
 	config_data.subconfigs                = NULL;
+	config_data.parameter_offsets         = NULL;
+	config_data.parameter_lengths         = NULL;
+	config_data.schema                    = NULL;
+	config_data.arena                     = arena;
+	config_data.output_arena              = output_arena;
 	
-    if (checkOpenFile(verbosity, file_name, "r", &file))
-    {        
-        fseek(file, *file_position, SEEK_SET);
+	CONFIG_STATS_BEGIN(io);
+	
+	mapped_file_s mapped;
+
+    if (mapFile(verbosity, file_name, &mapped)) 
+	{        
+		// Parse in place, straight from the mapped bytes:
+		const char *contents        = mapped.data;
+		size_t      contents_length = mapped.length;
+
+		// Pipes and the like have no size to map, so are read ahead instead:
+		char *read_contents = NULL;
+		if (mapped.length == 0)
+		{
+			read_contents = 
+				readFileAsync(verbosity, file_name, &contents_length);
+			contents      = (read_contents != NULL) ? read_contents : "";
+		}
+
+		const size_t start = 
+			((size_t) *file_position < contents_length) 
+			? (size_t) *file_position 
+			: contents_length;
+
+		const char   *buffer        = &contents[start];
+		const size_t  buffer_length = contents_length - start;
+		
+		CONFIG_STATS_END(io);
+		CONFIG_STATS_COUNT(bytes, buffer_length);
+		CONFIG_STATS_COUNT(lines, countConfigStatsLines(buffer, buffer_length));
+		
+		CONFIG_STATS_BEGIN(tokenise);
+		
+		const char_class_table_s table = createCharClassTable(syntax);
+
+		token_stream_s stream = 
+			tokeniseBuffer(buffer, buffer_length, &table);
+		
+		CONFIG_STATS_END(tokenise);
+		CONFIG_STATS_COUNT(tokens, stream.num_tokens);
+        
+        // Large superconfigs have their top level blocks parsed up front, 
+        // in parallel, then stitched in by the sequential pass:
+        parsed_block_s *blocks     = NULL;
+        int32_t         num_blocks = 0;
+        
+        if (   (buffer_length >= CONFIG_PARALLEL_MIN_BYTES)
+			&& schema->config.is_superconfig
+			&& (schema->default_subconfig != NULL)
+		) {
+			blocks = 
+				findTopLevelBlocks(
+					&stream, schema->config.early_exit_index, &num_blocks
+				);
+			parseBlocksParallel(
+				verbosity,
+				syntax,
+				schema,
+				&stream,
+				blocks,
+				num_blocks,
+				arena,
+				output_arena
+			);
+		}
         
         config_data = readSubconfig(
             verbosity,
             syntax,
-            config,
-            config,
-            file
+            schema,
+            schema,
+            &stream,
+            arena,
+            output_arena,
+            blocks,
+            num_blocks
         );
         
-        *file_position = ftell(file);
+        freeParsedBlocks(blocks, num_blocks);
+        
+		// Like the line reader, resume after the line the read stopped on:
+        *file_position = (int64_t) (start + 
+			(
+				(stream.index >= stream.num_tokens) 
+				? buffer_length 
+				: getTokenLineEnd(&stream, stream.index - 1)
+			));
         
-        fclose(file);
+		freeTokenStream(&stream);
+		free(read_contents);
+		unmapFile(&mapped);
     } 
     
     if (config_data.total_num_subconfigs_read < 0)
@@ -2250,30 +2948,262 @@ void* readConfig(
     }
     else
     {
+        CONFIG_STATS_BEGIN(set_structs);
+        
         config_structs = setConfigStructs(
             config_data.config,
             config_data
         ); 
+        
+        CONFIG_STATS_END(set_structs);
     }
+    
+    CONFIG_STATS_END(total);
 		
 	*ret_cofig_data = config_data;
 	
 	return config_structs;
 }
 
+void* readConfigSchema(
+	 const int32_t            verbosity,
+     const char              *file_name,  
+	 const schema_s          *schema,
+	       loader_data_s     *ret_cofig_data,
+           int64_t           *file_position
+    ){
+	
+	/**
+     * Read config file, from file_position onwards, with a precompiled 
+	 * schema, allocating everything with malloc.
+     * @see readConfigSchemaArena(), compileSchema(), readConfig().
+     * @return void *config_structs: array of config structures, or NULL on
+	 *                               failure.
+     */
+	
+	return readConfigSchemaArena(
+		verbosity,
+		file_name,
+		schema,
+		NULL,
+		false,
+		ret_cofig_data,
+		file_position
+	);
+}
+
+void* readConfigArena(
+	 const int32_t            verbosity,
+     const char              *file_name,  
+	 const loader_config_s    config,
+	       arena_s           *arena,
+	 const bool               outputs_in_arena,
+	       loader_data_s     *ret_cofig_data,
+           int64_t           *file_position
+    ){
+	
+	/**
+     * Read config file with the schema and parse bookkeeping compiled into 
+	 * arena, so nothing needs to be freed one allocation at a time.
+     * @param
+     *     const int32_t          verbosity       : verbosity level of 
+	 *                                              warnings.
+     *     const char            *file_name       : path of config file.
+     *     const loader_config_s  config          : config to read file with.
+     *           arena_s         *arena           : arena for the read.
+     *     const bool             outputs_in_arena: also allocate returned 
+	 *                                              structures from arena.
+     *           loader_data_s   *ret_cofig_data  : parse data of read.
+     *           int64_t         *file_position   : byte to start reading at.
+     * @see readConfigSchemaArena(), freeArena().
+     * @return void *config_structs: array of config structures, or NULL on
+	 *                               failure.
+     */
+	
+	schema_s *schema = compileSchemaArena(config, arena);
+	
+	void *config_structs = 
+		readConfigSchemaArena(
+			verbosity,
+			file_name,
+			schema,
+			arena,
+			outputs_in_arena,
+			ret_cofig_data,
+			file_position
+		);
+	
+	ret_cofig_data->schema = schema;
+	
+	return config_structs;
+}
+
+void* readConfig(
+	 const int32_t            verbosity,
+     const char              *file_name,  
+	 const loader_config_s    config,
+	       loader_data_s     *ret_cofig_data,
+           int64_t           *file_position
+    ){
+	
+	// Compile schema for this read, owned by the returned config data:
+	schema_s *schema = compileSchema(config);
+	
+	void *config_structs = 
+		readConfigSchema(
+			verbosity,
+			file_name,
+			schema,
+			ret_cofig_data,
+			file_position
+		);
+	
+	if (config_structs != NULL)
+	{
+		ret_cofig_data->schema = schema;
+	}
+	else
+	{
+		freeSchema(schema);
+	}
+	
+	return config_structs;
+}
+
+void printConfigStats(
+	const config_stats_s stats
+	) {
+	
+	/**
+     * Print the phase times and counts of config reads as two tables.
+     * @param
+     *     const config_stats_s stats: stats from getConfigStats().
+     * @see getConfigStats(), printTable().
+     */
+	
+	const char *phase_names[config_num_phases_e] =
+	{
+		"I/O",
+		"Tokenise",
+		"Name lookup",
+		"Value conversion",
+		"Requirements",
+		"Set structs",
+		"Total"
+	};
+	
+	const char *counter_names[config_num_counters_e] =
+	{
+		"Reads",
+		"Bytes",
+		"Lines",
+		"Tokens",
+		"Lookups",
+		"Dictionary probes",
+		"Allocations",
+		"Conversions"
+	};
+	
+	const double total_ns = (stats.phase_ns[config_phase_total_e] > 0)
+		? (double) stats.phase_ns[config_phase_total_e]
+		: 1.0;
+	
+	// Phase table, times in milliseconds:
+	uni_s phase_cells[config_num_phases_e*4];
+	char  phase_calls[config_num_phases_e][32];
+	
+	for (int32_t phase = 0; phase < config_num_phases_e; phase++)
+	{
+		snprintf(
+			phase_calls[phase], 
+			sizeof(phase_calls[phase]), 
+			"%" PRId64, 
+			stats.phase_calls[phase]
+		);
+		
+		uni_s *row = &phase_cells[phase*4];
+		
+		row[0].value.s = (char*) phase_names[phase];
+		row[0].type    = string_e;
+		row[1].value.f = (float) ((double) stats.phase_ns[phase]*1.0E-6);
+		row[1].type    = float_e;
+		row[2].value.s = phase_calls[phase];
+		row[2].type    = string_e;
+		row[3].value.f = 
+			(float) (100.0*(double) stats.phase_ns[phase]/total_ns);
+		row[3].type    = float_e;
+	}
+	
+	const table_column_s phase_columns[] = {
+		{"Phase"    , 0, 1},
+		{"Time (ms)", 3, 1},
+		{"Calls"    , 0, 1},
+		{"Share (%)", 1, 1}
+	};
+	
+	printTable((table_s) {
+		config_num_phases_e,
+		4,
+		"Config Read Phases",
+		phase_cells,
+		phase_columns
+	});
+	
+	// Counter table, counts can exceed an int cell so print as strings:
+	uni_s counter_cells[config_num_counters_e*2];
+	char  counts[config_num_counters_e][32];
+	
+	for (int32_t counter = 0; counter < config_num_counters_e; counter++)
+	{
+		snprintf(
+			counts[counter], 
+			sizeof(counts[counter]), 
+			"%" PRId64, 
+			stats.counts[counter]
+		);
+		
+		counter_cells[counter*2    ].value.s = (char*) counter_names[counter];
+		counter_cells[counter*2    ].type    = string_e;
+		counter_cells[counter*2 + 1].value.s = counts[counter];
+		counter_cells[counter*2 + 1].type    = string_e;
+	}
+	
+	const table_column_s counter_columns[] = {
+		{"Counter", 0, 1},
+		{"Count"  , 0, 1}
+	};
+	
+	printTable((table_s) {
+		config_num_counters_e,
+		2,
+		"Config Read Counts",
+		counter_cells,
+		counter_columns
+	});
+}
+
 size_t *createStructureParameterMap(
 	 const int32_t  verbosity,
      const type_e  *types, 
      const int32_t  length
     ) {
     
-	checkTypeOrder(verbosity, types, length);
+	parameter_s parameters[length + 1];
+	for (int32_t index = 0; index < length; index++)
+	{
+		parameters[index] = (parameter_s) {.type = types[index]};
+	}
 	
-	size_t *structure_map = malloc(sizeof(size_t) * (size_t) length);
+	size_t *structure_map = malloc(sizeof(size_t) * (size_t) (length + 1));
+	getParameterOffsets(parameters, NULL, length, structure_map);
 	
-	for (int32_t index = 0; index < length; index++)
+	if (verbosity > 2)
 	{
-		structure_map[index] = getTotalTypeArraySize(types, index);
+		fprintf(
+			stderr, 
+			"createStructureParameterMap: Structure of %i members mapped. \n", 
+			length
+		);
 	}
 	
 	return structure_map;
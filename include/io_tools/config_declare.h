@@ -0,0 +1,84 @@
+#ifndef IO_CONFIG_DECLARE_H
+#define IO_CONFIG_DECLARE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "io_tools/structures.h"
+
+/**
+ * Declare a config struct and its parameter table from a single list, so
+ * the two cannot drift apart. Each entry of the list names the parameter
+ * type without its _e suffix, the member, and the parameter_s limits:
+ *
+ *     #define EXAMPLE_FIELDS(FIELD, STRUCT)                              \
+ *         FIELD(STRUCT, char  , parameter_char , 1, 1, -FLT_MAX, FLT_MAX) \
+ *         FIELD(STRUCT, string, parameter_name , 1, 1, -FLT_MAX, FLT_MAX)
+ *
+ *     DECLARE_CONFIG_STRUCT(example_s, EXAMPLE_FIELDS)
+ *
+ *     DECLARE_CONFIG_PARAMETERS(example, example_s, EXAMPLE_FIELDS)
+ *     loader_config_s loader_config =
+ *     {
+ *         .name = "example",
+ *         CONFIG_DECLARED_LAYOUT(example, example_s),
+ *         ...
+ *     };
+ *
+ * Members take the C type of their parameter type and parameters take
+ * offsetof() of their member, so fields may be in any order and
+ * checkLoaderConfig() has no layout left to verify.
+ */
+
+// C type stored for each parameter type, see getSizeOfType():
+#define CONFIG_C_TYPE_bool         bool
+#define CONFIG_C_TYPE_bool_array   bool*
+#define CONFIG_C_TYPE_int          int32_t
+#define CONFIG_C_TYPE_int_array    int32_t*
+#define CONFIG_C_TYPE_int_jagged   int32_t**
+#define CONFIG_C_TYPE_float        float
+#define CONFIG_C_TYPE_float_array  float*
+#define CONFIG_C_TYPE_float_jagged float**
+#define CONFIG_C_TYPE_char         char
+#define CONFIG_C_TYPE_char_array   char*
+#define CONFIG_C_TYPE_string       char*
+#define CONFIG_C_TYPE_string_array char**
+
+#define CONFIG_DECLARE_MEMBER_(STRUCT, type, member, min, max, lower, upper) \
+	CONFIG_C_TYPE_##type member;
+
+#define CONFIG_DECLARE_PARAMETER_(STRUCT, type, member, min, max, lower, upper) \
+	{#member, type##_e, min, max, lower, upper},
+
+#define CONFIG_DECLARE_OFFSET_(STRUCT, type, member, min, max, lower, upper) \
+	offsetof(STRUCT, member),
+
+#define CONFIG_DECLARE_NAME_(STRUCT, type, member, min, max, lower, upper) \
+	#member,
+
+#define DECLARE_CONFIG_STRUCT(STRUCT, FIELDS) \
+	typedef struct {                          \
+		FIELDS(CONFIG_DECLARE_MEMBER_, STRUCT) \
+	} STRUCT;
+
+#define DECLARE_CONFIG_PARAMETERS(prefix, STRUCT, FIELDS)         \
+	parameter_s prefix##_parameters[] =                           \
+		{FIELDS(CONFIG_DECLARE_PARAMETER_, STRUCT)};              \
+	size_t      prefix##_offsets[]    =                           \
+		{FIELDS(CONFIG_DECLARE_OFFSET_, STRUCT)};                 \
+	char       *prefix##_names[]      =                           \
+		{FIELDS(CONFIG_DECLARE_NAME_, STRUCT)};
+
+#define CONFIG_DECLARED_NUM_PARAMETERS(prefix) \
+	((int32_t) (sizeof(prefix##_parameters) / sizeof(parameter_s)))
+
+// Designated initialisers for the layout members of a loader_config_s:
+#define CONFIG_DECLARED_LAYOUT(prefix, STRUCT)                             \
+	.num_defined_parameters = CONFIG_DECLARED_NUM_PARAMETERS(prefix),      \
+	.defined_parameters     = prefix##_parameters,                         \
+	.parameter_offsets      = prefix##_offsets,                            \
+	.layout_declared        = true,                                        \
+	.struct_size            = sizeof(STRUCT)
+
+#endif
@@ -0,0 +1,700 @@
+#ifndef IO_CONFIG_INDEX_H
+#define IO_CONFIG_INDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+
+#include "io_tools/text.h"
+#include "io_tools/arena.h"
+#include "io_tools/structures.h"
+#include "io_tools/lexer.h"
+#include "io_tools/config.h"
+
+#define CONFIG_INDEX_MAGIC     "CFGINDX"
+#define CONFIG_INDEX_VERSION   ((uint32_t) 1)
+#define CONFIG_INDEX_EXTENSION ".cfgindex"
+
+typedef struct ConfigIndexEntry {
+
+	/**
+     * Structure to hold the position of one { [name] ... } block of a config
+	 * file. Entries are in file order, so a block's descendants follow it.
+     */
+
+	// Byte of the opening brace and byte after the closing one:
+	int64_t begin;
+	int64_t end;
+
+	// Offset of the block's name in the index names, -1 if unnamed:
+	int64_t name_offset;
+
+	// Entry indices, -1 if none:
+	int32_t parent;
+	int32_t first_child;
+	int32_t next_sibling;
+	int32_t depth;
+
+} config_index_entry_s;
+
+typedef struct ConfigIndexHeader {
+
+	/**
+     * Structure to hold the header at the start of a config index sidecar,
+	 * followed by the entries and then the null separated names.
+     */
+
+	char     magic[8];
+	uint32_t version;
+	int32_t  num_entries;
+
+	// Validity of the index:
+	source_stamp_s source;
+
+	uint64_t names_length;
+	uint64_t total_size;
+
+} config_index_header_s;
+
+typedef struct ConfigIndex {
+
+	/**
+     * Structure to hold the block structure of a config file. entries and
+	 * names point into the mapped sidecar when is_cached, otherwise into
+	 * memory owned by the index.
+     */
+
+	mapped_file_s               mapped;
+
+	const config_index_entry_s *entries;
+	int32_t                     num_entries;
+	const char                 *names;
+	size_t                      names_length;
+
+	config_index_entry_s       *owned_entries;
+	char                       *owned_names;
+	bool                        is_cached;
+
+} config_index_s;
+
+const char *getConfigIndexName(
+	const config_index_s *index,
+	const int32_t         entry
+	) {
+
+	const int64_t offset = index->entries[entry].name_offset;
+
+	return (offset >= 0) ? &index->names[offset] : NULL;
+}
+
+bool buildConfigIndex(
+	const int32_t         verbosity,
+	const char           *file_name,
+	      config_index_s *ret_index
+	) {
+
+	/**
+     * Index every block of a config file by brace matching its tokens,
+	 * without parsing any values.
+     * @param
+     *     const int32_t         verbosity: verbosity level of warnings.
+     *     const char           *file_name: path of config file.
+     *           config_index_s *ret_index: built index, free with
+	 *                                      freeConfigIndex().
+     * @see readConfigIndex(), findConfigIndexPath().
+     * @return bool success: true if the file was read.
+     */
+
+	*ret_index = (config_index_s) {.mapped = {"", 0, false}};
+
+	mapped_file_s mapped;
+	if (!mapFile(verbosity, file_name, &mapped))
+	{
+		return false;
+	}
+
+	const char_class_table_s table  = createCharClassTable(syntax);
+	token_stream_s           stream =
+		tokeniseBuffer(mapped.data, mapped.length, &table);
+
+	int32_t               max_num_entries = 16;
+	config_index_entry_s *entries         =
+		malloc(sizeof(config_index_entry_s) * (size_t) max_num_entries);
+	int32_t               num_entries     = 0;
+
+	size_t  max_names_length = 256;
+	char   *names            = malloc(max_names_length);
+	size_t  names_length     = 0;
+
+	// Open blocks, and the last child found at each depth:
+	int32_t  max_depth    = 16;
+	int32_t  depth        = 0;
+	int32_t *open_entries = malloc(sizeof(int32_t) * (size_t) max_depth);
+	int32_t *last_child   =
+		malloc(sizeof(int32_t) * (size_t) (max_depth + 1));
+	last_child[0] = -1;
+
+	for (int32_t index = 0; index < stream.num_tokens; index++)
+	{
+		const token_s token = stream.tokens[index];
+
+		switch (token.type)
+		{
+			case (token_open_config_e):
+			{
+				if (num_entries >= max_num_entries)
+				{
+					max_num_entries *= 2;
+					entries =
+						realloc(
+							entries,
+							sizeof(config_index_entry_s)
+							* (size_t) max_num_entries
+						);
+				}
+				if (depth >= max_depth)
+				{
+					max_depth    *= 2;
+					open_entries  =
+						realloc(
+							open_entries, sizeof(int32_t) * (size_t) max_depth
+						);
+					last_child =
+						realloc(
+							last_child,
+							sizeof(int32_t) * (size_t) (max_depth + 1)
+						);
+				}
+
+				const int32_t parent =
+					(depth > 0) ? open_entries[depth - 1] : -1;
+
+				entries[num_entries] = (config_index_entry_s)
+				{
+					.begin        = (int64_t) (token.start - mapped.data),
+					.end          = (int64_t) mapped.length,
+					.name_offset  = -1,
+					.parent       = parent,
+					.first_child  = -1,
+					.next_sibling = -1,
+					.depth        = depth
+				};
+
+				if (last_child[depth] >= 0)
+				{
+					entries[last_child[depth]].next_sibling = num_entries;
+				}
+				else if (parent >= 0)
+				{
+					entries[parent].first_child = num_entries;
+				}
+				last_child[depth] = num_entries;
+
+				open_entries[depth] = num_entries;
+				depth++;
+				last_child[depth] = -1;
+				num_entries++;
+			}
+			break;
+
+			case (token_close_config_e):
+				if (depth == 0)
+				{
+					// Stray closing brace ends the top level read:
+					index = stream.num_tokens;
+					break;
+				}
+				depth--;
+				entries[open_entries[depth]].end =
+					(int64_t) (token.start - mapped.data)
+					+ (int64_t) token.length;
+			break;
+
+			// Like readSubconfig(), only the first name of a block counts:
+			case (token_name_e):
+				if (   (depth > 0)
+					&& (entries[open_entries[depth - 1]].name_offset < 0)
+				) {
+					if (names_length + token.length + 1 > max_names_length)
+					{
+						max_names_length =
+							2*(names_length + token.length + 1);
+						names = realloc(names, max_names_length);
+					}
+
+					memcpy(&names[names_length], token.start, token.length);
+					entries[open_entries[depth - 1]].name_offset =
+						(int64_t) names_length;
+					names_length += token.length;
+					names[names_length] = '\0';
+					names_length++;
+				}
+			break;
+
+			default:
+			break;
+		}
+	}
+
+	free(open_entries);
+	free(last_child);
+	freeTokenStream(&stream);
+	unmapFile(&mapped);
+
+	ret_index->entries       = entries;
+	ret_index->num_entries   = num_entries;
+	ret_index->names         = names;
+	ret_index->names_length  = names_length;
+	ret_index->owned_entries = entries;
+	ret_index->owned_names   = names;
+	ret_index->is_cached     = false;
+
+	return true;
+}
+
+bool writeConfigIndex(
+	const int32_t         verbosity,
+	const char           *index_name,
+	const struct stat    *source_stat,
+	const config_index_s *index
+	) {
+
+	/**
+     * Write an index to a sidecar with writeFileAtomic().
+     * @param
+     *     const int32_t         verbosity  : verbosity level of warnings.
+     *     const char           *index_name : path of sidecar to write.
+     *     const struct stat    *source_stat: stat of the config file, taken
+	 *                                        before it was indexed.
+     *     const config_index_s *index      : index to write.
+     * @see loadConfigIndex(), readConfigIndex().
+     * @return bool success: true if the sidecar was written.
+     */
+
+	const size_t entries_size =
+		sizeof(config_index_entry_s) * (size_t) index->num_entries;
+
+	const config_index_header_s header =
+	{
+		.magic             = CONFIG_INDEX_MAGIC,
+		.version           = CONFIG_INDEX_VERSION,
+		.num_entries       = index->num_entries,
+		.source            = getSourceStamp(source_stat),
+		.names_length      = index->names_length,
+		.total_size        =
+			sizeof(config_index_header_s) + entries_size + index->names_length
+	};
+
+	const struct iovec parts[3] =
+	{
+		{(void*) &header       , sizeof(header)     },
+		{(void*) index->entries , entries_size       },
+		{(void*) index->names   , index->names_length}
+	};
+
+	const bool pass = writeFileAtomic(index_name, parts, 3);
+
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(
+			stderr,
+			"writeConfigIndex: \nWarning! Could not write index \"%s\". \n",
+			index_name
+		);
+	}
+
+	return pass;
+}
+
+bool loadConfigIndex(
+	const int32_t         verbosity,
+	const char           *index_name,
+	const struct stat    *source_stat,
+	      config_index_s *ret_index
+	) {
+
+	/**
+     * Map a sidecar written by writeConfigIndex(). It is rejected if the
+	 * config file's mtime or size no longer match, if any entry points
+	 * outside the file or the names, or if the parent, child and sibling
+	 * links do not form a tree in file order.
+     * @param
+     *     const int32_t         verbosity  : verbosity level of warnings.
+     *     const char           *index_name : path of sidecar.
+     *     const struct stat    *source_stat: current stat of config file.
+     *           config_index_s *ret_index  : index pointing into the
+	 *                                        mapping.
+     * @see writeConfigIndex(), freeConfigIndex().
+     * @return bool success: true if the sidecar was valid and mapped.
+     */
+
+	mapped_file_s mapped;
+	if (!mapFile(verbosity > 1 ? verbosity : 0, index_name, &mapped))
+	{
+		return false;
+	}
+
+	config_index_header_s header;
+
+	bool valid = (mapped.length >= sizeof(header));
+	if (valid)
+	{
+		memcpy(&header, mapped.data, sizeof(header));
+
+		valid =
+			   !memcmp(header.magic, CONFIG_INDEX_MAGIC, sizeof(header.magic))
+			&& (header.version           == CONFIG_INDEX_VERSION)
+			&& (header.total_size        == mapped.length)
+			&& checkSourceStamp(header.source, source_stat)
+			&& (header.num_entries       >= 0)
+			&& (sizeof(header)
+				+ sizeof(config_index_entry_s) * (size_t) header.num_entries
+				+ header.names_length
+				== mapped.length)
+			&& ((header.names_length == 0)
+				|| (mapped.data[mapped.length - 1] == '\0'));
+	}
+
+	const config_index_entry_s *entries =
+		(const config_index_entry_s*) &mapped.data[sizeof(header)];
+
+	for (int32_t entry = 0; valid && (entry < header.num_entries); entry++)
+	{
+		const config_index_entry_s current = entries[entry];
+
+		valid =
+			   (current.begin >= 0)
+			&& (current.begin < current.end)
+			&& (current.end   <= header.source.size)
+			&& (current.name_offset >= -1)
+			&& (current.name_offset < (int64_t) header.names_length)
+			&& (current.parent      >= -1)
+			&& (current.parent       < entry)
+			&& (current.depth ==
+				((current.parent < 0) ? 0 : entries[current.parent].depth + 1))
+			&& ((current.first_child == -1)
+				|| (   (current.first_child >  entry)
+					&& (current.first_child <  header.num_entries)))
+			&& ((current.next_sibling == -1)
+				|| (   (current.next_sibling > entry)
+					&& (current.next_sibling < header.num_entries)));
+	}
+
+	if (!valid)
+	{
+		if (verbosity > 1)
+		{
+			fprintf(
+				stderr,
+				"loadConfigIndex: \nIndex \"%s\" is stale, config must be "
+				"re-indexed. \n",
+				index_name
+			);
+		}
+		unmapFile(&mapped);
+
+		return false;
+	}
+
+	*ret_index = (config_index_s)
+	{
+		.mapped        = mapped,
+		.entries       = entries,
+		.num_entries   = header.num_entries,
+		.names         =
+			&mapped.data[
+				sizeof(header)
+				+ sizeof(config_index_entry_s) * (size_t) header.num_entries
+			],
+		.names_length  = header.names_length,
+		.owned_entries = NULL,
+		.owned_names   = NULL,
+		.is_cached     = true
+	};
+
+	return true;
+}
+
+bool readConfigIndex(
+	const int32_t         verbosity,
+	const char           *file_name,
+	const bool            persist,
+	      config_index_s *ret_index
+	) {
+
+	/**
+     * Get the index of a config file, from its sidecar when valid.
+	 * Otherwise the file is indexed, and the sidecar written if persist.
+     * @param
+     *     const int32_t         verbosity: verbosity level of warnings.
+     *     const char           *file_name: path of config file.
+     *     const bool            persist  : write a sidecar when indexing.
+     *           config_index_s *ret_index: index, free with
+	 *                                      freeConfigIndex().
+     * @see buildConfigIndex(), readConfigPath().
+     * @return bool success: true if the index was read or built.
+     */
+
+	struct stat source_stat;
+	const bool cacheable =
+		   (stat(file_name, &source_stat) == 0)
+		&& S_ISREG(source_stat.st_mode);
+
+	char index_name[strlen(file_name) + sizeof(CONFIG_INDEX_EXTENSION)];
+	snprintf(
+		index_name, sizeof(index_name), "%s%s", file_name,
+		CONFIG_INDEX_EXTENSION
+	);
+
+	if (   cacheable
+		&& loadConfigIndex(verbosity, index_name, &source_stat, ret_index)
+	) {
+		return true;
+	}
+
+	if (!buildConfigIndex(verbosity, file_name, ret_index))
+	{
+		return false;
+	}
+
+	if (cacheable && persist)
+	{
+		writeConfigIndex(verbosity, index_name, &source_stat, ret_index);
+	}
+
+	return true;
+}
+
+void freeConfigIndex(
+	config_index_s *index
+	) {
+
+	free(index->owned_entries);
+	free(index->owned_names);
+	unmapFile(&index->mapped);
+
+	*index = (config_index_s) {.mapped = {"", 0, false}};
+}
+
+int32_t findConfigIndexPath(
+	const config_index_s *index,
+	const char           *path
+	) {
+
+	/**
+     * Find a block by the names of it and its enclosing blocks, separated
+	 * by '/', such as "network/detectors/hanford". Only the siblings at
+	 * each step are looked at.
+     * @param
+     *     const config_index_s *index: index of config file.
+     *     const char           *path : names from the top level down.
+     * @see readConfigPath().
+     * @return int32_t entry: index entry of block, -1 if not found.
+     */
+
+	int32_t entry = (index->num_entries > 0) ? 0 : -1;
+
+	while ((entry >= 0) && (*path != '\0'))
+	{
+		const char   *separator = strchr(path, '/');
+		const size_t  length    =
+			(separator != NULL) ? (size_t) (separator - path) : strlen(path);
+
+		for (; entry >= 0; entry = index->entries[entry].next_sibling)
+		{
+			const char *name = getConfigIndexName(index, entry);
+
+			if (   (name != NULL)
+				&& !strncmp(name, path, length)
+				&& (name[length] == '\0')
+			) {
+				break;
+			}
+		}
+
+		if ((entry < 0) || (separator == NULL) || (separator[1] == '\0'))
+		{
+			break;
+		}
+
+		path  = separator + 1;
+		entry = index->entries[entry].first_child;
+	}
+
+	return entry;
+}
+
+void *readConfigPath(
+	const int32_t         verbosity,
+	const char           *file_name,
+	const schema_s       *schema,
+	const config_index_s *index,
+	const char           *path,
+	      arena_s        *arena,
+	      loader_data_s  *ret_config_data
+	) {
+
+	/**
+     * Read a single block of a config file, found through its index, without
+	 * parsing or validating the rest of the file. The block is read with the
+	 * schema the enclosing blocks' names select, so inherited parameters
+	 * apply as in a full read.
+     * @param
+     *     const int32_t         verbosity      : verbosity level of warnings.
+     *     const char           *file_name      : path of config file.
+     *     const schema_s       *schema         : schema of whole file, from
+	 *                                            compileSchema().
+     *     const config_index_s *index          : index of file, or NULL to
+	 *                                            index it for this read.
+     *     const char           *path           : names of block and its
+	 *                                            enclosing blocks, separated
+	 *                                            by '/'.
+     *           arena_s        *arena          : arena for the read, or NULL
+	 *                                            for malloc.
+     *           loader_data_s  *ret_config_data: parse data of block.
+     * @see findConfigIndexPath(), readConfigIndex().
+     * @return void *structure: structure of block, or NULL if it was not
+	 *                          found or failed its requirements.
+     */
+
+	ret_config_data->total_num_subconfigs_read = -1;
+	ret_config_data->structure                 = NULL;
+
+	config_index_s built_index;
+	if (index == NULL)
+	{
+		if (!buildConfigIndex(verbosity, file_name, &built_index))
+		{
+			return NULL;
+		}
+		index = &built_index;
+	}
+
+	const int32_t entry = findConfigIndexPath(index, path);
+
+	// Follow the schema choices a full read makes down to the block:
+	const schema_s *data_schema = schema;
+	bool            found       = (entry >= 0);
+
+	if (found)
+	{
+		const int32_t depth = index->entries[entry].depth;
+		int32_t       chain[depth + 1];
+
+		for (int32_t level = depth, current = entry; level >= 0; level--)
+		{
+			chain[level] = current;
+			current      = index->entries[current].parent;
+		}
+
+		for (int32_t level = 0; found && (level < depth); level++)
+		{
+			found =
+				   data_schema->config.is_superconfig
+				&& (data_schema->default_subconfig != NULL);
+
+			if (found)
+			{
+				const schema_s *named_schema =
+					findNamedSchema(
+						data_schema, getConfigIndexName(index, chain[level])
+					);
+
+				data_schema =
+					((named_schema != NULL) && !named_schema->config.inherit)
+					? named_schema
+					: data_schema->default_subconfig;
+			}
+		}
+
+		found = found && (data_schema->default_subconfig != NULL);
+	}
+
+	if (!found)
+	{
+		if (verbosity > 0)
+		{
+			fprintf(
+				stderr,
+				"readConfigPath: \nWarning! No block \"%s\" in config \"%s\".\n",
+				path,
+				file_name
+			);
+		}
+		if (index == &built_index)
+		{
+			freeConfigIndex(&built_index);
+		}
+
+		return NULL;
+	}
+
+	const config_index_entry_s block = index->entries[entry];
+
+	if (index == &built_index)
+	{
+		freeConfigIndex(&built_index);
+	}
+
+	mapped_file_s mapped;
+	if (   !mapFile(verbosity, file_name, &mapped)
+		|| ((size_t) block.end > mapped.length)
+	) {
+		unmapFile(&mapped);
+
+		return NULL;
+	}
+
+	// Only the block's own bytes are touched:
+	const char_class_table_s table  = createCharClassTable(syntax);
+	token_stream_s           stream =
+		tokeniseBuffer(
+			&mapped.data[block.begin],
+			(size_t) (block.end - block.begin),
+			&table
+		);
+
+	void *structure = NULL;
+
+	if (   (stream.num_tokens > 0)
+		&& (stream.tokens[0].type == token_open_config_e)
+	) {
+		stream.index = 1;
+
+		loader_data_s config_data =
+			readSubconfig(
+				verbosity,
+				syntax,
+				data_schema->default_subconfig,
+				data_schema,
+				&stream,
+				arena,
+				arena,
+				NULL,
+				0
+			);
+
+		if (config_data.total_num_subconfigs_read >= 0)
+		{
+			structure        = config_data.structure;
+			*ret_config_data = config_data;
+		}
+		else
+		{
+			arenaFree(config_data.output_arena, config_data.structure);
+			freeConfigData(config_data);
+		}
+	}
+
+	freeTokenStream(&stream);
+	unmapFile(&mapped);
+
+	return structure;
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef IO_CONFIG_STATS_H
+#define IO_CONFIG_STATS_H
+
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+#include "io_tools/arena.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Per-phase instrumentation of config reads. Build with -DCONFIG_STATS to
+ * turn it on; otherwise every hook below expands to nothing, so the read
+ * path is unchanged. Phases are timed with the cycle counter where there is
+ * one, and CLOCK_MONOTONIC_RAW otherwise. Blocks parsed in parallel add
+ * their time from every thread, so phase times can sum to more than the
+ * total.
+ *
+ *     resetConfigStats();
+ *     readConfig(verbosity, file_name, config, &config_data, position);
+ *     printConfigStats(getConfigStats());
+ */
+
+typedef enum ConfigPhase {
+
+	/**
+     * Enum of the timed phases of a config read.
+     */
+
+	config_phase_io_e,
+	config_phase_tokenise_e,
+	config_phase_lookup_e,
+	config_phase_convert_e,
+	config_phase_requirements_e,
+	config_phase_set_structs_e,
+	config_phase_total_e,
+	config_num_phases_e
+} config_phase_e;
+
+typedef enum ConfigCounter {
+
+	/**
+     * Enum of the counted events of a config read.
+     */
+
+	config_count_reads_e,
+	config_count_bytes_e,
+	config_count_lines_e,
+	config_count_tokens_e,
+	config_count_lookups_e,
+	config_count_probes_e,
+	config_count_allocations_e,
+	config_count_conversions_e,
+	config_num_counters_e
+} config_counter_e;
+
+typedef struct ConfigStats {
+
+	/**
+     * Structure to hold the phase times and event counts of config reads
+	 * since the last resetConfigStats().
+     */
+
+	int64_t phase_ns   [config_num_phases_e  ];
+	int64_t phase_calls[config_num_phases_e  ];
+	int64_t counts     [config_num_counters_e];
+
+} config_stats_s;
+
+// Accumulators, updated atomically by the hooks:
+static uint64_t config_stats_ticks [config_num_phases_e  ];
+static int64_t  config_stats_calls [config_num_phases_e  ];
+static int64_t  config_stats_counts[config_num_counters_e];
+
+// Clock readings at reset, to convert ticks to nanoseconds:
+static uint64_t config_stats_reset_ticks = 0;
+static int64_t  config_stats_reset_ns    = 0;
+
+static inline int64_t getConfigStatsNs(void) {
+
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+
+	return (int64_t) time.tv_sec*1000000000 + (int64_t) time.tv_nsec;
+}
+
+static inline uint64_t getConfigStatsTicks(void) {
+
+	#if defined(__x86_64__) || defined(__i386__)
+	return (uint64_t) __rdtsc();
+	#else
+	return (uint64_t) getConfigStatsNs();
+	#endif
+}
+
+static inline void addConfigStatsPhase(
+	const config_phase_e phase,
+	const uint64_t       start_ticks
+	) {
+
+	__atomic_fetch_add(
+		&config_stats_ticks[phase],
+		getConfigStatsTicks() - start_ticks,
+		__ATOMIC_RELAXED
+	);
+	__atomic_fetch_add(&config_stats_calls[phase], 1, __ATOMIC_RELAXED);
+}
+
+static inline void addConfigStatsCount(
+	const config_counter_e counter,
+	const int64_t          count
+	) {
+
+	__atomic_fetch_add(&config_stats_counts[counter], count, __ATOMIC_RELAXED);
+}
+
+int64_t countConfigStatsLines(
+	const char   *buffer,
+	const size_t  length
+	) {
+
+	/**
+     * Count the lines in buffer, including an unterminated last line.
+     */
+
+	int64_t     num_lines = 0;
+	const char *end       = buffer + length;
+	const char *line      = buffer;
+
+	while (line < end)
+	{
+		const char *new_line = memchr(line, '\n', (size_t) (end - line));
+
+		num_lines++;
+		line = (new_line != NULL) ? new_line + 1 : end;
+	}
+
+	return num_lines;
+}
+
+void resetConfigStats(void) {
+
+	/**
+     * Zero the phase times and counts, and restart the tick calibration.
+     */
+
+	memset(config_stats_ticks , 0, sizeof(config_stats_ticks ));
+	memset(config_stats_calls , 0, sizeof(config_stats_calls ));
+	memset(config_stats_counts, 0, sizeof(config_stats_counts));
+
+	config_stats_reset_ns    = getConfigStatsNs();
+	config_stats_reset_ticks = getConfigStatsTicks();
+}
+
+config_stats_s getConfigStats(void) {
+
+	/**
+     * Snapshot the phase times and counts since the last resetConfigStats().
+	 * Cycle counts are converted with the tick rate measured over the same
+	 * interval.
+     * @see resetConfigStats(), printConfigStats().
+     * @return config_stats_s stats: times in nanoseconds and counts, all
+	 *                               zero unless built with CONFIG_STATS.
+     */
+
+	config_stats_s stats;
+
+	const uint64_t elapsed_ticks =
+		getConfigStatsTicks() - config_stats_reset_ticks;
+	const int64_t  elapsed_ns    =
+		getConfigStatsNs()    - config_stats_reset_ns;
+
+	const double ns_per_tick = ((elapsed_ticks > 0) && (elapsed_ns > 0))
+		? (double) elapsed_ns / (double) elapsed_ticks
+		: 1.0;
+
+	for (int32_t phase = 0; phase < config_num_phases_e; phase++)
+	{
+		stats.phase_ns[phase] = (int64_t) (ns_per_tick * (double)
+			__atomic_load_n(&config_stats_ticks[phase], __ATOMIC_RELAXED));
+		stats.phase_calls[phase] =
+			__atomic_load_n(&config_stats_calls[phase], __ATOMIC_RELAXED);
+	}
+
+	for (int32_t counter = 0; counter < config_num_counters_e; counter++)
+	{
+		stats.counts[counter] =
+			__atomic_load_n(&config_stats_counts[counter], __ATOMIC_RELAXED);
+	}
+
+	return stats;
+}
+
+#ifdef CONFIG_STATS
+
+#define CONFIG_STATS_BEGIN(phase) \
+	const uint64_t config_stats_start_##phase = getConfigStatsTicks()
+
+#define CONFIG_STATS_END(phase) \
+	addConfigStatsPhase(config_phase_##phase##_e, config_stats_start_##phase)
+
+#define CONFIG_STATS_COUNT(counter, count) \
+	addConfigStatsCount(config_count_##counter##_e, (int64_t) (count))
+
+static void countConfigStatsAllocation(
+	const size_t size
+	) {
+
+	(void) size;
+	addConfigStatsCount(config_count_allocations_e, 1);
+}
+
+// Count arena and malloc fallback allocations through the arena hook:
+__attribute__((constructor)) static void installConfigStatsHooks(void) {
+
+	arena_allocation_hook = countConfigStatsAllocation;
+}
+
+#else
+
+// Hooks compile away, count expressions are never evaluated:
+#define CONFIG_STATS_BEGIN(phase)          ((void) 0)
+#define CONFIG_STATS_END(phase)            ((void) 0)
+#define CONFIG_STATS_COUNT(counter, count) ((void) 0)
+
+#endif
+
+#endif
@@ -0,0 +1,1050 @@
+#ifndef IO_CONFIG_WATCH_H
+#define IO_CONFIG_WATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+
+#include <inttypes.h>
+
+#include "io_tools/text.h"
+#include "io_tools/async_io.h"
+#include "io_tools/arena.h"
+#include "io_tools/custom_types.h"
+#include "io_tools/structures.h"
+#include "io_tools/lexer.h"
+#include "io_tools/config.h"
+
+// Events on the config's directory that can mean new contents, editors
+// often write a temporary file and rename it over the original:
+#define CONFIG_WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO)
+
+typedef enum ConfigChange {
+
+	/**
+     * Enum to hold how a top level block differs between two loads.
+     */
+
+	config_unchanged_e,
+	config_reparsed_e,
+	config_modified_e,
+	config_added_e,
+	config_removed_e
+} config_change_e;
+
+typedef struct WatchedBlock {
+
+	/**
+     * Structure to hold a top level block of a watched config, parsed into
+	 * its own arena so it can outlive the load that read it.
+     */
+
+	uint64_t       hash;
+
+	// NULL if the block had to be parsed into the root arena, which makes
+	// it impossible to keep across loads:
+	arena_s       *arena;
+
+} watched_block_s;
+
+typedef struct ConfigBlockChange {
+
+	/**
+     * Structure to hold the change to one top level block. Unchanged blocks
+	 * keep their structure pointer, reparsed ones hold the same values in a
+	 * new structure.
+     */
+
+	config_change_e   change;
+	char             *name;
+
+	// Position in the old and new config_data.subconfigs, -1 if absent:
+	int32_t           old_index;
+	int32_t           new_index;
+
+	// Defined parameters of the block whose values differ:
+	const char      **changed_parameters;
+	int32_t           num_changed_parameters;
+
+	// Blocks inside the block that were added, removed or differ:
+	int32_t           num_changed_subconfigs;
+
+} config_block_change_s;
+
+typedef struct ConfigChangeSet {
+
+	/**
+     * Structure to hold everything that differs between two loads of a
+	 * watched config.
+     */
+
+	config_block_change_s  *blocks;
+	int32_t                 num_blocks;
+
+	int32_t                 num_unchanged;
+	int32_t                 num_reparsed;
+	int32_t                 num_modified;
+	int32_t                 num_added;
+	int32_t                 num_removed;
+
+	// Defined parameters of the top level config whose values differ:
+	const char            **root_changed_parameters;
+	int32_t                 num_root_changed_parameters;
+
+	// Number of blocks taken from their byte hash without being parsed:
+	int32_t                 num_blocks_skipped;
+
+} config_change_set_s;
+
+typedef struct ConfigWatch {
+
+	/**
+     * Structure to hold a config that is reloaded in place when its file
+	 * changes. Only top level blocks whose text changed are parsed again,
+	 * the rest keep their structures.
+     */
+
+	int32_t           verbosity;
+	char             *file_name;
+	schema_s         *schema;
+
+	int               inotify_descriptor;
+	int               watch_descriptor;
+	char             *directory;
+	char             *base_name;
+
+	// Current load, root parse data and structs live in root_arena:
+	arena_s          *root_arena;
+	loader_data_s     config_data;
+	void            **config_structs;
+	int64_t           generation;
+
+	// One per top level block found, matching the subconfigs of
+	// config_data one to one when aligned:
+	watched_block_s  *blocks;
+	int32_t           num_blocks;
+	bool              aligned;
+
+	// Hash of the text around the top level blocks:
+	uint64_t          outer_hash;
+
+} config_watch_s;
+
+const char *configChangeToString(
+	const config_change_e change
+	) {
+
+	const char *string = "unchanged";
+	switch (change)
+	{
+		case (config_unchanged_e): string = "unchanged"; break;
+		case (config_reparsed_e ): string = "reparsed" ; break;
+		case (config_modified_e ): string = "modified" ; break;
+		case (config_added_e    ): string = "added"    ; break;
+		case (config_removed_e  ): string = "removed"  ; break;
+	}
+
+	return string;
+}
+
+bool compareParameterValues(
+	const parameter_s  parameter,
+	const uint8_t     *value_a,
+	const int32_t      length_a,
+	const uint8_t     *value_b,
+	const int32_t      length_b
+	) {
+
+	/**
+     * Compare one parameter as stored in two structures, following any
+	 * string or array pointers.
+     * @param
+     *     const parameter_s  parameter: definition of parameter.
+     *     const uint8_t     *value_a  : parameter in first structure.
+     *     const int32_t      length_a : elements read into first.
+     *     const uint8_t     *value_b  : parameter in second structure.
+     *     const int32_t      length_b : elements read into second.
+     * @see findChangedParameters().
+     * @return bool equal: true if both hold the same value.
+     */
+
+	size_t element_size = 0;
+
+	switch (parameter.type)
+	{
+		case(bool_e ):
+		case(int_e  ):
+		case(float_e):
+		case(char_e ):
+		return !memcmp(value_a, value_b, getSizeOfType(parameter.type));
+
+		case(bool_array_e ): element_size = sizeof(bool   ); break;
+		case(int_array_e  ): element_size = sizeof(int32_t); break;
+		case(float_array_e): element_size = sizeof(float  ); break;
+		case(char_array_e ): element_size = sizeof(char   ); break;
+
+		case(string_e      ):
+		case(string_array_e):
+		break;
+
+		// Never filled by the parser:
+		default:
+		return true;
+	}
+
+	void *pointer_a = NULL;
+	void *pointer_b = NULL;
+	memcpy(&pointer_a, value_a, sizeof(pointer_a));
+	memcpy(&pointer_b, value_b, sizeof(pointer_b));
+
+	if ((pointer_a == NULL) || (pointer_b == NULL))
+	{
+		return (pointer_a == pointer_b);
+	}
+
+	if (parameter.type == string_e)
+	{
+		return !strcmp(pointer_a, pointer_b);
+	}
+
+	if (length_a != length_b)
+	{
+		return false;
+	}
+
+	if (parameter.type == string_array_e)
+	{
+		char **strings_a = pointer_a;
+		char **strings_b = pointer_b;
+
+		for (int32_t index = 0; index < length_a; index++)
+		{
+			if (   ((strings_a[index] == NULL) != (strings_b[index] == NULL))
+				|| (   (strings_a[index] != NULL)
+					&& strcmp(strings_a[index], strings_b[index]))
+			) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	return !memcmp(pointer_a, pointer_b, element_size * (size_t) length_a);
+}
+
+int32_t findChangedParameters(
+	const loader_data_s  *data_a,
+	const loader_data_s  *data_b,
+	      const char    **ret_names
+	) {
+
+	/**
+     * Find the defined parameters whose values differ between two reads of
+	 * a block. Blocks laid out with different configs differ in every
+	 * parameter.
+     * @param
+     *     const loader_data_s  *data_a   : first read of block.
+     *     const loader_data_s  *data_b   : second read of block.
+     *           const char    **ret_names: names of differing parameters,
+	 *                                      may be NULL to only count.
+     * @see compareParameterValues().
+     * @return int32_t num_changed: number of differing parameters.
+     */
+
+	const loader_config_s *config = &data_b->config;
+
+	const bool same_layout =
+		   (data_a->config.struct_size == config->struct_size)
+		&& (data_a->config.num_defined_parameters
+			== config->num_defined_parameters)
+		&& (data_a->parameter_offsets == data_b->parameter_offsets);
+
+	int32_t num_changed = 0;
+
+	for (
+		int32_t parameter = 0;
+		parameter < config->num_defined_parameters;
+		parameter++
+	) {
+		const size_t offset = data_b->parameter_offsets[parameter];
+
+		const bool equal = same_layout
+			&& compareParameterValues(
+				config->defined_parameters[parameter],
+				&((const uint8_t*) data_a->structure)[offset],
+				data_a->parameter_lengths[parameter],
+				&((const uint8_t*) data_b->structure)[offset],
+				data_b->parameter_lengths[parameter]
+			);
+
+		if (!equal)
+		{
+			if (ret_names != NULL)
+			{
+				ret_names[num_changed] =
+					config->defined_parameters[parameter].name;
+			}
+			num_changed++;
+		}
+	}
+
+	return num_changed;
+}
+
+bool compareNullableStrings(
+	const char *string_a,
+	const char *string_b
+	) {
+
+	return ((string_a == NULL) || (string_b == NULL))
+		? (string_a == string_b)
+		: !strcmp(string_a, string_b);
+}
+
+int32_t countChangedSubconfigs(
+	const loader_data_s *data_a,
+	const loader_data_s *data_b
+	) {
+
+	/**
+     * Count the blocks inside two reads of a block that differ, comparing
+	 * them in order. Blocks only present in one read count as changed.
+     * @see findChangedParameters().
+     * @return int32_t num_changed: number of differing blocks.
+     */
+
+	const int32_t num_a =
+		data_a->config.is_superconfig ? data_a->total_num_subconfigs_read : 0;
+	const int32_t num_b =
+		data_b->config.is_superconfig ? data_b->total_num_subconfigs_read : 0;
+
+	int32_t num_changed = (num_a > num_b) ? num_a - num_b : num_b - num_a;
+
+	for (int32_t index = 0; (index < num_a) && (index < num_b); index++)
+	{
+		const loader_data_s *subconfig_a = &data_a->subconfigs[index];
+		const loader_data_s *subconfig_b = &data_b->subconfigs[index];
+
+		num_changed +=
+			   !compareNullableStrings(subconfig_a->name, subconfig_b->name)
+			|| (findChangedParameters(subconfig_a, subconfig_b, NULL) > 0)
+			|| (countChangedSubconfigs(subconfig_a, subconfig_b) > 0);
+	}
+
+	return num_changed;
+}
+
+uint64_t hashTopLevelBlocks(
+	const token_stream_s *stream,
+	const parsed_block_s *blocks,
+	const int32_t         num_blocks,
+	      uint64_t       *ret_block_hashes
+	) {
+
+	/**
+     * Hash the text of each top level block, and the text around them.
+     * @param
+     *     const token_stream_s *stream          : token stream of file.
+     *     const parsed_block_s *blocks          : blocks from
+	 *                                             findTopLevelBlocks().
+     *     const int32_t         num_blocks      : number of blocks.
+     *           uint64_t       *ret_block_hashes: hash of each block.
+     * @see reloadConfigWatch().
+     * @return uint64_t outer_hash: hash of everything outside the blocks.
+     */
+
+	const char *buffer = stream->buffer;
+
+	uint64_t outer_hash = 0;
+	size_t   position   = 0;
+
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		const token_s open  = stream->tokens[blocks[index].open_index ];
+		const token_s close = stream->tokens[blocks[index].close_index];
+
+		const size_t begin = (size_t) (open.start - buffer);
+		const size_t end   = (size_t) (close.start - buffer) + close.length;
+
+		ret_block_hashes[index] = hashString(&buffer[begin], end - begin);
+
+		outer_hash =
+			mixHash(
+				outer_hash ^ hashString(&buffer[position], begin - position),
+				(uint64_t) index
+			);
+		position   = end;
+	}
+
+	return mixHash(
+		outer_hash
+		^ hashString(&buffer[position], stream->buffer_length - position),
+		(uint64_t) num_blocks
+	);
+}
+
+void freeConfigChangeSet(
+	config_change_set_s *changes
+	) {
+
+	for (int32_t index = 0; index < changes->num_blocks; index++)
+	{
+		free(changes->blocks[index].name);
+		free(changes->blocks[index].changed_parameters);
+	}
+	free(changes->blocks);
+	free(changes->root_changed_parameters);
+
+	memset(changes, 0, sizeof(*changes));
+}
+
+void addConfigBlockChange(
+	      config_change_set_s *changes,
+	const config_change_e      change,
+	const loader_data_s       *old_data,
+	const loader_data_s       *new_data,
+	const int32_t              old_index,
+	const int32_t              new_index
+	) {
+
+	/**
+     * Record the change to one top level block, listing the parameters and
+	 * blocks that differ when it is in both loads.
+     */
+
+	const loader_data_s *data = (new_data != NULL) ? new_data : old_data;
+
+	config_block_change_s block =
+	{
+		.change                 = change,
+		.name                   =
+			(data->name != NULL) ? strdup(data->name) : NULL,
+		.old_index              = old_index,
+		.new_index              = new_index,
+		.changed_parameters     = NULL,
+		.num_changed_parameters = 0,
+		.num_changed_subconfigs = 0
+	};
+
+	if (change == config_modified_e)
+	{
+		block.changed_parameters =
+			malloc(
+				sizeof(char*)
+				* (size_t) (new_data->config.num_defined_parameters + 1)
+			);
+		block.num_changed_parameters =
+			findChangedParameters(
+				old_data, new_data, block.changed_parameters
+			);
+		block.num_changed_subconfigs =
+			countChangedSubconfigs(old_data, new_data);
+	}
+
+	changes->blocks[changes->num_blocks] = block;
+	changes->num_blocks++;
+
+	switch (change)
+	{
+		case (config_unchanged_e): changes->num_unchanged++; break;
+		case (config_reparsed_e ): changes->num_reparsed++ ; break;
+		case (config_modified_e ): changes->num_modified++ ; break;
+		case (config_added_e    ): changes->num_added++    ; break;
+		case (config_removed_e  ): changes->num_removed++  ; break;
+	}
+}
+
+bool reloadConfigWatch(
+	config_watch_s      *watch,
+	config_change_set_s *ret_changes
+	) {
+
+	/**
+     * Read the watched config again. Top level blocks whose text hashes as
+	 * before, with the text around them unchanged, are taken over without
+	 * parsing. Changed blocks are parsed on their own and, if their values
+	 * turn out the same, the old structure is kept anyway. The new load is
+	 * then diffed against the old one.
+     * @param
+     *     config_watch_s      *watch      : watch to reload.
+     *     config_change_set_s *ret_changes: what differs from the previous
+	 *                                       load, free with
+	 *                                       freeConfigChangeSet().
+     * @see openConfigWatch(), pollConfigWatch().
+     * @return bool success: false if the file could not be read or parsed,
+	 *                       in which case the previous load is kept.
+     */
+
+	memset(ret_changes, 0, sizeof(*ret_changes));
+
+	const int32_t   verbosity = watch->verbosity;
+	const schema_s *schema    = watch->schema;
+
+	mapped_file_s mapped;
+	if (!mapFile(verbosity, watch->file_name, &mapped))
+	{
+		return false;
+	}
+
+	const char *contents        = mapped.data;
+	size_t      contents_length = mapped.length;
+
+	char *read_contents = NULL;
+	if (mapped.length == 0)
+	{
+		read_contents =
+			readFileAsync(verbosity, watch->file_name, &contents_length);
+		contents      = (read_contents != NULL) ? read_contents : "";
+	}
+
+	const char_class_table_s table  = createCharClassTable(syntax);
+	token_stream_s           stream =
+		tokeniseBuffer(contents, contents_length, &table);
+
+	parsed_block_s *blocks     = NULL;
+	int32_t         num_blocks = 0;
+
+	if (schema->config.is_superconfig && (schema->default_subconfig != NULL))
+	{
+		blocks =
+			findTopLevelBlocks(
+				&stream, schema->config.early_exit_index, &num_blocks
+			);
+	}
+
+	watched_block_s *new_blocks =
+		calloc((size_t) num_blocks + 1, sizeof(watched_block_s));
+	uint64_t        *hashes     =
+		malloc(sizeof(uint64_t) * ((size_t) num_blocks + 1));
+	int32_t         *reused     =
+		malloc(sizeof(int32_t) * ((size_t) num_blocks + 1));
+
+	const uint64_t outer_hash =
+		hashTopLevelBlocks(&stream, blocks, num_blocks, hashes);
+
+	// Old blocks whose arena the new load took:
+	const int32_t num_old    = watch->num_blocks;
+	bool         *old_kept   = calloc((size_t) num_old + 1, sizeof(bool));
+
+	const bool can_reuse =
+		   watch->aligned
+		&& (blocks != NULL)
+		&& (outer_hash == watch->outer_hash);
+
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		new_blocks[index].hash = hashes[index];
+		reused[index]          = -1;
+
+		for (int32_t old = 0; can_reuse && (old < num_old); old++)
+		{
+			// Blocks usually stay where they were:
+			const int32_t candidate = (index + old) % num_old;
+
+			if (   !old_kept[candidate]
+				&& (watch->blocks[candidate].arena != NULL)
+				&& (watch->blocks[candidate].hash == hashes[index])
+			) {
+				new_blocks[index]     = watch->blocks[candidate];
+				blocks[index].data    =
+					watch->config_data.subconfigs[candidate];
+				blocks[index].consumed = true;
+				reused[index]         = candidate;
+				old_kept[candidate]   = true;
+				ret_changes->num_blocks_skipped++;
+				break;
+			}
+		}
+	}
+
+	// Changed blocks are parsed on their own, into their own arenas:
+	#pragma omp parallel for schedule(dynamic)
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		if (reused[index] >= 0)
+		{
+			continue;
+		}
+
+		parsed_block_s *block = &blocks[index];
+		arena_s        *arena = createArena(0);
+
+		token_stream_s block_stream =
+		{
+			.buffer        = stream.buffer,
+			.buffer_length = stream.buffer_length,
+			.tokens        = &stream.tokens[block->open_index + 1],
+			.num_tokens    = block->close_index - block->open_index,
+			.index         = 0,
+			.name_scratch  = {NULL, 0},
+			.value_scratch = {NULL, 0}
+		};
+
+		block->data =
+			readSubconfig(
+				verbosity,
+				syntax,
+				schema->default_subconfig,
+				schema,
+				&block_stream,
+				arena,
+				arena,
+				NULL,
+				0
+			);
+
+		block->consumed =
+			   (block_stream.index == block_stream.num_tokens)
+			&& (block->data.total_num_subconfigs_read >= 0);
+
+		// Left for the sequential pass to read into the root arena:
+		if (!block->consumed)
+		{
+			freeArena(arena);
+			arena = NULL;
+		}
+		new_blocks[index].arena = arena;
+
+		free(block_stream.name_scratch.data);
+		free(block_stream.value_scratch.data);
+	}
+
+	arena_s *root_arena = createArena(0);
+
+	loader_data_s config_data =
+		readSubconfig(
+			verbosity,
+			syntax,
+			schema,
+			schema,
+			&stream,
+			root_arena,
+			root_arena,
+			blocks,
+			num_blocks
+		);
+
+	bool aligned =
+		   (blocks != NULL)
+		&& (config_data.total_num_subconfigs_read == num_blocks);
+	for (int32_t index = 0; aligned && (index < num_blocks); index++)
+	{
+		aligned = blocks[index].used;
+	}
+
+	freeTokenStream(&stream);
+	free(read_contents);
+	unmapFile(&mapped);
+
+	const bool success = (config_data.total_num_subconfigs_read >= 0);
+
+	if (!success)
+	{
+		if (verbosity > 0)
+		{
+			fprintf(
+				stderr,
+				"reloadConfigWatch: \nWarning! Could not parse \"%s\", "
+				"keeping previous load.\n",
+				watch->file_name
+			);
+		}
+
+		for (int32_t index = 0; index < num_blocks; index++)
+		{
+			if ((reused[index] < 0) && (new_blocks[index].arena != NULL))
+			{
+				freeArena(new_blocks[index].arena);
+			}
+		}
+		freeArena(root_arena);
+		free(new_blocks);
+	}
+	else
+	{
+		const loader_data_s *old_data = &watch->config_data;
+		const int32_t        num_new  = config_data.total_num_subconfigs_read;
+		const int32_t        num_prev =
+			(watch->root_arena != NULL)
+			? old_data->total_num_subconfigs_read
+			: 0;
+
+		// Old blocks that are in the new load:
+		bool *old_found = calloc((size_t) num_prev + 1, sizeof(bool));
+
+		ret_changes->blocks =
+			calloc(
+				(size_t) (num_new + num_prev + 1),
+				sizeof(config_block_change_s)
+			);
+
+		for (int32_t index = 0; index < num_new; index++)
+		{
+			loader_data_s *new_subconfig = &config_data.subconfigs[index];
+
+			if (aligned && (reused[index] >= 0))
+			{
+				old_found[reused[index]] = true;
+				addConfigBlockChange(
+					ret_changes, config_unchanged_e, new_subconfig,
+					new_subconfig, reused[index], index
+				);
+				continue;
+			}
+
+			// Otherwise find the old block it was reused from, if the blocks
+			// moved, or compare with the first unclaimed old block of the
+			// same name, trying the same position first:
+			int32_t match = -1;
+			for (int32_t old = 0; (match < 0) && (old < 2*num_prev); old++)
+			{
+				const int32_t candidate = (index + old) % num_prev;
+				const loader_data_s *old_subconfig =
+					&old_data->subconfigs[candidate];
+
+				if (   !old_found[candidate]
+					&& ((old < num_prev)
+						? (   (new_subconfig->structure != NULL)
+							&& (old_subconfig->structure
+								== new_subconfig->structure))
+						: compareNullableStrings(
+							old_subconfig->name, new_subconfig->name
+						))
+				) {
+					match = candidate;
+				}
+			}
+
+			if (match < 0)
+			{
+				addConfigBlockChange(
+					ret_changes, config_added_e, NULL, new_subconfig, -1, index
+				);
+				continue;
+			}
+
+			old_found[match] = true;
+
+			const loader_data_s *old_subconfig = &old_data->subconfigs[match];
+
+			const bool equal =
+				   (findChangedParameters(old_subconfig, new_subconfig, NULL)
+					== 0)
+				&& (countChangedSubconfigs(old_subconfig, new_subconfig) == 0);
+
+			// Reused from the old load, even though the blocks moved:
+			const bool shared =
+				   (new_subconfig->structure != NULL)
+				&& (new_subconfig->structure == old_subconfig->structure);
+
+			// Same values, so hand back the structure consumers already have:
+			const bool keep =
+				   equal
+				&& (   shared
+					|| (   aligned
+						&& watch->aligned
+						&& (new_blocks[index].arena    != NULL)
+						&& (watch->blocks[match].arena != NULL)));
+
+			if (keep && !shared)
+			{
+				freeArena(new_blocks[index].arena);
+				new_blocks[index].arena = watch->blocks[match].arena;
+				*new_subconfig          = *old_subconfig;
+				old_kept[match]         = true;
+			}
+
+			addConfigBlockChange(
+				ret_changes,
+				keep
+					? config_unchanged_e
+					: (equal ? config_reparsed_e : config_modified_e),
+				old_subconfig,
+				new_subconfig,
+				match,
+				index
+			);
+		}
+
+		for (int32_t old = 0; old < num_prev; old++)
+		{
+			if (!old_found[old])
+			{
+				addConfigBlockChange(
+					ret_changes, config_removed_e,
+					&old_data->subconfigs[old], NULL, old, -1
+				);
+			}
+		}
+		free(old_found);
+
+		if ((watch->root_arena != NULL) && config_data.config.has_parameters)
+		{
+			ret_changes->root_changed_parameters =
+				malloc(
+					sizeof(char*)
+					* (size_t) (config_data.config.num_defined_parameters + 1)
+				);
+			ret_changes->num_root_changed_parameters =
+				findChangedParameters(
+					old_data,
+					&config_data,
+					ret_changes->root_changed_parameters
+				);
+		}
+
+		// Blocks not carried over go with the previous load:
+		for (int32_t old = 0; old < num_old; old++)
+		{
+			if (!old_kept[old] && (watch->blocks[old].arena != NULL))
+			{
+				freeArena(watch->blocks[old].arena);
+			}
+		}
+		if (watch->root_arena != NULL)
+		{
+			freeArena(watch->root_arena);
+		}
+		free(watch->blocks);
+
+		watch->root_arena     = root_arena;
+		watch->config_data    = config_data;
+		watch->config_structs =
+			(void**) setConfigStructs(config_data.config, config_data);
+		watch->blocks         = new_blocks;
+		watch->num_blocks     = num_blocks;
+		watch->aligned        = aligned;
+		watch->outer_hash     = outer_hash;
+		watch->generation++;
+	}
+
+	free(blocks);
+	free(hashes);
+	free(reused);
+	free(old_kept);
+
+	return success;
+}
+
+bool openConfigWatch(
+	const int32_t          verbosity,
+	const char            *file_name,
+	const loader_config_s  config,
+	      config_watch_s  *ret_watch
+	) {
+
+	/**
+     * Load a config and start watching its file with inotify. The directory
+	 * is watched rather than the file, so replacing the file by renaming
+	 * another over it is seen.
+     * @param
+     *     const int32_t          verbosity: verbosity level of warnings.
+     *     const char            *file_name: path of config file.
+     *     const loader_config_s  config   : config to read file with.
+     *           config_watch_s  *ret_watch: watch holding the first load.
+     * @see pollConfigWatch(), reloadConfigWatch(), closeConfigWatch().
+     * @return bool success: true if the config was loaded, even if the
+	 *                       file could not be watched.
+     */
+
+	const char *separator = strrchr(file_name, '/');
+
+	*ret_watch = (config_watch_s)
+	{
+		.verbosity          = verbosity,
+		.file_name          = strdup(file_name),
+		.schema             = compileSchema(config),
+		.inotify_descriptor = -1,
+		.watch_descriptor   = -1,
+		.directory          =
+			(separator != NULL)
+			? strndup(file_name, (size_t) (separator - file_name) + 1)
+			: strdup("."),
+		.base_name          =
+			strdup((separator != NULL) ? separator + 1 : file_name),
+		.root_arena         = NULL,
+		.config_structs     = NULL,
+		.generation         = 0,
+		.blocks             = NULL,
+		.num_blocks         = 0,
+		.aligned            = false,
+		.outer_hash         = 0
+	};
+
+	// Watched before the first load, so no edit falls between the two:
+	ret_watch->inotify_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (ret_watch->inotify_descriptor >= 0)
+	{
+		ret_watch->watch_descriptor =
+			inotify_add_watch(
+				ret_watch->inotify_descriptor,
+				ret_watch->directory,
+				CONFIG_WATCH_EVENTS
+			);
+	}
+
+	if ((ret_watch->watch_descriptor < 0) && (verbosity >= 1))
+	{
+		fprintf(
+			stderr,
+			"openConfigWatch: \nWarning! Could not watch \"%s\": %s, only "
+			"explicit reloads will be seen.\n",
+			ret_watch->directory,
+			strerror(errno)
+		);
+	}
+
+	config_change_set_s changes;
+	const bool success = reloadConfigWatch(ret_watch, &changes);
+	freeConfigChangeSet(&changes);
+
+	if (!success)
+	{
+		if (ret_watch->inotify_descriptor >= 0)
+		{
+			close(ret_watch->inotify_descriptor);
+		}
+		freeSchema(ret_watch->schema);
+		free(ret_watch->file_name);
+		free(ret_watch->directory);
+		free(ret_watch->base_name);
+		memset(ret_watch, 0, sizeof(*ret_watch));
+
+		return false;
+	}
+
+	return true;
+}
+
+bool pollConfigWatch(
+	      config_watch_s      *watch,
+	const int32_t              timeout_ms,
+	      config_change_set_s *ret_changes
+	) {
+
+	/**
+     * Wait up to timeout_ms for the watched file to change, and reload it
+	 * if it did. Every event queued for the file is drained first, so a
+	 * burst of writes costs one reload.
+     * @param
+     *     config_watch_s      *watch      : watch to poll.
+     *     const int32_t        timeout_ms : milliseconds to wait, 0 to only
+	 *                                       check, -1 to wait forever.
+     *     config_change_set_s *ret_changes: changes if reloaded, otherwise
+	 *                                       empty.
+     * @see reloadConfigWatch().
+     * @return bool reloaded: true if the file changed and was reloaded.
+     */
+
+	memset(ret_changes, 0, sizeof(*ret_changes));
+
+	if (watch->watch_descriptor < 0)
+	{
+		return false;
+	}
+
+	struct pollfd poll_descriptor =
+	{
+		.fd      = watch->inotify_descriptor,
+		.events  = POLLIN,
+		.revents = 0
+	};
+
+	bool changed = false;
+	int  timeout = timeout_ms;
+
+	while (poll(&poll_descriptor, 1, timeout) > 0)
+	{
+		char buffer[4096]
+			__attribute__((aligned(__alignof__(struct inotify_event))));
+
+		const ssize_t length =
+			read(watch->inotify_descriptor, buffer, sizeof(buffer));
+
+		if (length <= 0)
+		{
+			break;
+		}
+
+		for (
+			ssize_t position = 0;
+			position < length;
+			position +=
+				(ssize_t) sizeof(struct inotify_event)
+				+ ((struct inotify_event*) &buffer[position])->len
+		) {
+			const struct inotify_event *event =
+				(struct inotify_event*) &buffer[position];
+
+			changed = changed
+				|| ((event->len > 0) && !strcmp(event->name, watch->base_name))
+				// Dropped events may have been for the file:
+				|| (event->mask & IN_Q_OVERFLOW);
+
+			// The directory is gone, and its watch with it:
+			if (   (event->wd == watch->watch_descriptor)
+				&& (event->mask & IN_IGNORED)
+			) {
+				if (watch->verbosity >= 1)
+				{
+					fprintf(
+						stderr,
+						"pollConfigWatch: \nWarning! Watch on \"%s\" was "
+						"removed, only explicit reloads will be seen.\n",
+						watch->directory
+					);
+				}
+				watch->watch_descriptor = -1;
+				changed                 = true;
+			}
+		}
+
+		// Only drain what is already queued:
+		timeout = 0;
+	}
+
+	return changed && reloadConfigWatch(watch, ret_changes);
+}
+
+void closeConfigWatch(
+	config_watch_s *watch
+	) {
+
+	if (watch->inotify_descriptor >= 0)
+	{
+		close(watch->inotify_descriptor);
+	}
+
+	for (int32_t index = 0; index < watch->num_blocks; index++)
+	{
+		if (watch->blocks[index].arena != NULL)
+		{
+			freeArena(watch->blocks[index].arena);
+		}
+	}
+	if (watch->root_arena != NULL)
+	{
+		freeArena(watch->root_arena);
+	}
+	if (watch->schema != NULL)
+	{
+		freeSchema(watch->schema);
+	}
+
+	free(watch->blocks);
+	free(watch->file_name);
+	free(watch->directory);
+	free(watch->base_name);
+
+	memset(watch, 0, sizeof(*watch));
+	watch->inotify_descriptor = -1;
+	watch->watch_descriptor   = -1;
+}
+
+#endif
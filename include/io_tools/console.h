@@ -10,55 +10,362 @@
 
 #include "io_tools/custom_types.h"
 
+// Log-linear histogram, linear sub-buckets within each power of two of ns:
+#define TIMER_SUB_BUCKET_BITS 4
+#define TIMER_SUB_BUCKETS     (1 << TIMER_SUB_BUCKET_BITS)
+#define TIMER_NUM_BUCKETS     (64*TIMER_SUB_BUCKETS)
+
+// Deepest nesting of open timer scopes:
+#define TIMER_MAX_DEPTH 32
+
 typedef struct timer 
 {
-    char  *name;
+    char    *name;
 
-    struct timespec start;
-    struct timespec stop;
+    int64_t  start; // CLOCK_MONOTONIC nanoseconds.
+    int64_t  stop;
 } timer_s;
 
+static inline int64_t getTimerNs(void) {
+    
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (int64_t) time.tv_sec*1000000000 + (int64_t) time.tv_nsec;
+}
+
 void start_timer(
     char    *name,
     timer_s *timer
     ) {
     
-    timer->name = name;
-    clock_gettime(CLOCK_REALTIME, &timer->start);
+    timer->name  = name;
+    timer->start = getTimerNs();
 }
 
-float stop_timer(
+int64_t stop_timer_ns(
     timer_s *timer
     ) {
     
-    clock_gettime(CLOCK_REALTIME, &timer->stop);
-    float time_elapsed = (float)(timer->stop.tv_sec - timer->start.tv_sec)
-        + (float)(timer->stop.tv_nsec - timer->start.tv_nsec) 
-        / (float)1E9;
-    clock_gettime(CLOCK_REALTIME, &timer->start);
+    /**
+     * Return nanoseconds since the timer was started or last stopped, and 
+     * restart it.
+     */
+    
+    timer->stop  = getTimerNs();
+    
+    const int64_t time_elapsed = timer->stop - timer->start;
+    timer->start = timer->stop;
     
     return time_elapsed;
 }
 
+float stop_timer(
+    timer_s *timer
+    ) {
+    
+    return (float) ((double) stop_timer_ns(timer)*1.0E-9);
+}
+
 void print_timer(
     const char *lap_name,
     timer_s    *timer
     ) {
 
+    const int64_t time_elapsed = stop_timer_ns(timer);
+
     printf(
-        "Timer: %s, Lap: %s. Reading: %f Seconds.\n", 
+        "Timer: %s, Lap: %s. Reading: %" PRId64 ".%09" PRId64 " Seconds.\n", 
         timer->name, 
         lap_name, 
-        stop_timer(timer)
+        time_elapsed / 1000000000,
+        time_elapsed % 1000000000
     );
 }
 
+typedef struct TimerScope {
+    
+    /**
+     * Structure to hold the lap statistics of one named timer scope.
+     */
+    
+    const char *name;
+    int32_t     depth;  // Nesting depth scope was first opened at.
+    int32_t     parent; // Scope open around it then, -1 if none.
+    
+    int64_t     count;
+    int64_t     total_ns;
+    int64_t     min_ns;
+    int64_t     max_ns;
+    
+    int64_t     histogram[TIMER_NUM_BUCKETS];
+} timer_scope_s;
+
+typedef struct TimerProfile {
+    
+    /**
+     * Structure to hold named timer scopes and the stack of open laps.
+     */
+    
+    int32_t        num_scopes;
+    int32_t        max_scopes;
+    timer_scope_s *scopes;
+    
+    int32_t        depth;
+    int32_t        open_scopes[TIMER_MAX_DEPTH];
+    int64_t        open_starts[TIMER_MAX_DEPTH];
+} timer_profile_s;
+
+static inline int32_t getTimerBucket(
+    const int64_t time_ns
+    ) {
+    
+    /**
+     * Histogram bucket of a duration. Durations below TIMER_SUB_BUCKETS ns 
+     * get a bucket each, above that each power of two is split into 
+     * TIMER_SUB_BUCKETS linear buckets, so bucket width stays within 
+     * 1/TIMER_SUB_BUCKETS of the value.
+     */
+    
+    const uint64_t value = (time_ns > 0) ? (uint64_t) time_ns : 0;
+    
+    if (value < TIMER_SUB_BUCKETS)
+    {
+        return (int32_t) value;
+    }
+    
+    const int32_t exponent = 63 - __builtin_clzll(value);
+    const int32_t shift    = exponent - TIMER_SUB_BUCKET_BITS;
+    
+    return (shift + 1)*TIMER_SUB_BUCKETS 
+        + (int32_t) ((value >> shift) - TIMER_SUB_BUCKETS);
+}
+
+static inline int64_t getTimerBucketValue(
+    const int32_t bucket
+    ) {
+    
+    /**
+     * Midpoint of the durations in a histogram bucket.
+     */
+    
+    if (bucket < TIMER_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+    
+    const int32_t shift     = bucket/TIMER_SUB_BUCKETS - 1;
+    const int64_t sub_value = bucket%TIMER_SUB_BUCKETS + TIMER_SUB_BUCKETS;
+    
+    return (sub_value << shift) + (((int64_t) 1 << shift) >> 1);
+}
+
+timer_profile_s createTimerProfile(void) {
+    
+    timer_profile_s profile = {
+        .num_scopes = 0,
+        .max_scopes = 0,
+        .scopes     = NULL,
+        .depth      = 0
+    };
+    
+    return profile;
+}
+
+void freeTimerProfile(
+    timer_profile_s *profile
+    ) {
+    
+    free(profile->scopes);
+    *profile = createTimerProfile();
+}
+
+int32_t getTimerScope(
+          timer_profile_s *profile,
+    const char            *name
+    ) {
+    
+    /**
+     * Find or add the scope called name. Look scopes up once outside hot 
+     * loops and pass the index to beginTimerScope().
+     * @param
+     *     timer_profile_s *profile: profile to hold scope.
+     *     const char      *name   : scope name, must outlive profile.
+     * @see beginTimerScope(), addTimerSample().
+     * @return int32_t scope: index of scope in profile.
+     */
+    
+    for (int32_t scope = 0; scope < profile->num_scopes; scope++)
+    {
+        if (   (profile->scopes[scope].name == name) 
+            || !strcmp(profile->scopes[scope].name, name)
+        ) {
+            return scope;
+        }
+    }
+    
+    if (profile->num_scopes >= profile->max_scopes)
+    {
+        profile->max_scopes = 
+            (profile->max_scopes > 0) ? profile->max_scopes*2 : 8;
+        profile->scopes     = 
+            realloc(
+                profile->scopes, 
+                sizeof(timer_scope_s) * (size_t) profile->max_scopes
+            );
+    }
+    
+    timer_scope_s *scope = &profile->scopes[profile->num_scopes];
+    memset(scope, 0, sizeof(timer_scope_s));
+    
+    scope->name   = name;
+    scope->depth  = -1;
+    scope->parent = -1;
+    scope->min_ns = INT64_MAX;
+    
+    return profile->num_scopes++;
+}
+
+void addTimerSample(
+          timer_profile_s *profile,
+    const int32_t          scope_index,
+    const int64_t          time_ns
+    ) {
+    
+    /**
+     * Record one lap of time_ns nanoseconds against a scope.
+     */
+    
+    timer_scope_s *scope = &profile->scopes[scope_index];
+    
+    scope->count++;
+    scope->total_ns += time_ns;
+    scope->min_ns    = (time_ns < scope->min_ns) ? time_ns : scope->min_ns;
+    scope->max_ns    = (time_ns > scope->max_ns) ? time_ns : scope->max_ns;
+    
+    scope->histogram[getTimerBucket(time_ns)]++;
+}
+
+void beginTimerScope(
+          timer_profile_s *profile,
+    const int32_t          scope_index
+    ) {
+    
+    /**
+     * Open a lap of a scope, nested inside any lap already open.
+     * @see endTimerScope(), lapTimerScope().
+     */
+    
+    const int32_t depth = profile->depth;
+    
+    if (depth < TIMER_MAX_DEPTH)
+    {
+        timer_scope_s *scope = &profile->scopes[scope_index];
+        
+        if (scope->depth < 0)
+        {
+            scope->depth  = depth;
+            scope->parent = (depth > 0) ? profile->open_scopes[depth - 1] : -1;
+        }
+        
+        profile->open_scopes[depth] = scope_index;
+        profile->open_starts[depth] = getTimerNs();
+    }
+    
+    profile->depth++;
+}
+
+int64_t lapTimerScope(
+    timer_profile_s *profile
+    ) {
+    
+    /**
+     * Record the innermost open lap and start the next, for timing each 
+     * iteration of a loop without closing its scope.
+     * @return int64_t time_ns: length of the recorded lap.
+     */
+    
+    const int32_t depth = profile->depth - 1;
+    
+    if ((depth < 0) || (depth >= TIMER_MAX_DEPTH))
+    {
+        return 0;
+    }
+    
+    const int64_t now     = getTimerNs();
+    const int64_t time_ns = now - profile->open_starts[depth];
+    
+    addTimerSample(profile, profile->open_scopes[depth], time_ns);
+    profile->open_starts[depth] = now;
+    
+    return time_ns;
+}
+
+int64_t endTimerScope(
+    timer_profile_s *profile
+    ) {
+    
+    /**
+     * Record and close the innermost open lap.
+     * @return int64_t time_ns: length of the recorded lap.
+     */
+    
+    const int64_t time_ns = lapTimerScope(profile);
+    
+    if (profile->depth > 0)
+    {
+        profile->depth--;
+    }
+    
+    return time_ns;
+}
+
+int64_t getTimerPercentile(
+    const timer_scope_s *scope,
+    const double         percentile
+    ) {
+    
+    /**
+     * Estimate a percentile of a scope's laps from its histogram, within 
+     * one bucket width.
+     * @param
+     *     const timer_scope_s *scope     : scope to read.
+     *     const double         percentile: percentile in [0, 100].
+     * @return int64_t time_ns: estimated lap length at percentile.
+     */
+    
+    if (scope->count == 0)
+    {
+        return 0;
+    }
+    
+    int64_t rank = (int64_t) ceil(percentile/100.0 * (double) scope->count);
+    rank = (rank < 1) ? 1 : rank;
+    
+    int64_t seen = 0;
+    for (int32_t bucket = 0; bucket < TIMER_NUM_BUCKETS; bucket++)
+    {
+        seen += scope->histogram[bucket];
+        
+        if (seen >= rank)
+        {
+            const int64_t value = getTimerBucketValue(bucket);
+            
+            return (value < scope->min_ns) ? scope->min_ns 
+                 : (value > scope->max_ns) ? scope->max_ns 
+                 : value;
+        }
+    }
+    
+    return scope->max_ns;
+}
 
 typedef struct loading_s {
 
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
 	//
 	// Structure to hold loading bar incolumnion. 
+	// Single threaded, use progress_s inside parallel loops.
 	//
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
 
@@ -240,6 +547,241 @@ void progressCheck(
     loading->tick_index++;
 } 
 
+// Longest bar a progress_s can draw:
+#define PROGRESS_MAX_BAR_LENGTH 256
+
+// Weight of the newest rate sample in the smoothed ETA:
+#define PROGRESS_RATE_SMOOTHING 0.2
+
+typedef struct Progress {
+	
+	/**
+     * Structure to hold a progress bar that can be ticked from inside 
+	 * parallel loops. Threads share one counter, and whichever thread finds 
+	 * a redraw due and wins the render flag draws the bar. Over aligned, so
+	 * keep it on the stack or in aligned_alloc() memory.
+     */
+	
+	// Shared between threads, kept on their own cache lines:
+	_Alignas(64) int64_t ticks;
+	_Alignas(64) bool    rendering;
+	
+	// Only touched by the thread holding rendering:
+	_Alignas(64) int64_t next_render_ns;
+	int64_t  last_render_ns;
+	int64_t  last_render_ticks;
+	double   rate; // Smoothed ticks per second.
+	size_t   max_eta_length;
+	int64_t  num_renders;
+	
+	// Set up once:
+	int64_t  num_ticks;
+	int64_t  check_mask;
+	int64_t  interval_ns;
+	int64_t  start_ns;
+	size_t   bar_length;
+	FILE    *stream;
+	
+	char     line[PROGRESS_MAX_BAR_LENGTH + 128];
+} progress_s;
+
+void setupProgress(
+	      progress_s *progress,
+	const int64_t     num_ticks,
+	const size_t      bar_length,
+	const int64_t     check_interval,
+	const int64_t     interval_ms
+	) {
+	
+	/**
+     * Set up a progress bar for num_ticks ticks.
+     * @param
+     *     progress_s    *progress      : progress bar to set up.
+     *     const int64_t  num_ticks     : ticks at completion.
+     *     const size_t   bar_length    : characters in bar.
+     *     const int64_t  check_interval: ticks between clock checks, 
+	 *                                    rounded up to a power of two.
+     *     const int64_t  interval_ms   : least time between redraws.
+     * @see tickProgress(), finishProgress().
+     */
+	
+	memset(progress, 0, sizeof(progress_s));
+	
+	int64_t interval = 1;
+	while (interval < check_interval)
+	{
+		interval <<= 1;
+	}
+	
+	progress->num_ticks      = (num_ticks > 0) ? num_ticks : 1;
+	progress->check_mask     = interval - 1;
+	progress->interval_ns    = interval_ms*1000000;
+	progress->bar_length     = (bar_length < PROGRESS_MAX_BAR_LENGTH) 
+		? bar_length 
+		: PROGRESS_MAX_BAR_LENGTH;
+	progress->stream         = stdout;
+	progress->start_ns       = getTimerNs();
+	progress->last_render_ns = progress->start_ns;
+	progress->next_render_ns = progress->start_ns + progress->interval_ns;
+}
+
+void renderProgress(
+	      progress_s *progress,
+	const int64_t     ticks,
+	const int64_t     now
+	) {
+	
+	/**
+     * Draw the bar into the progress line buffer and write it in one call.
+	 * Only called by the thread holding the render flag.
+     */
+	
+	const int64_t elapsed_ns = now - progress->last_render_ns;
+	if ((elapsed_ns > 0) && (ticks > progress->last_render_ticks))
+	{
+		const double rate = (double) (ticks - progress->last_render_ticks) 
+			/ ((double) elapsed_ns*1.0E-9);
+		
+		progress->rate = (progress->rate > 0.0) 
+			? PROGRESS_RATE_SMOOTHING*rate 
+				+ (1.0 - PROGRESS_RATE_SMOOTHING)*progress->rate 
+			: rate;
+	}
+	progress->last_render_ns    = now;
+	progress->last_render_ticks = ticks;
+	
+	const int64_t done      = (ticks < progress->num_ticks) 
+		? ticks 
+		: progress->num_ticks;
+	const double  fraction  = (double) done / (double) progress->num_ticks;
+	const size_t  num_pips  = (size_t) (fraction*(double) progress->bar_length);
+	
+	char   *line   = progress->line;
+	size_t  length = 0;
+	
+	line[length++] = '\r';
+	memcpy(&line[length], "Progress: [", 11);
+	length += 11;
+	memset(&line[length], '#', num_pips);
+	memset(&line[length + num_pips], ' ', progress->bar_length - num_pips);
+	length += progress->bar_length;
+	
+	char eta[64];
+	int32_t seconds = (progress->rate > 0.0) 
+		? (int32_t) ((double) (progress->num_ticks - done) / progress->rate)
+		: 0;
+	
+	if (seconds > 3600)
+	{
+		snprintf(
+			eta, sizeof(eta), "ETA: %d:%02d:%02d hours:minutes:seconds", 
+			seconds/3600, (seconds/60)%60, seconds%60
+		);
+	}
+	else if (seconds > 60)
+	{
+		snprintf(
+			eta, sizeof(eta), "ETA: %d:%02d minutes:seconds", 
+			seconds/60, seconds%60
+		);
+	}
+	else
+	{
+		snprintf(eta, sizeof(eta), "ETA: %d seconds", seconds);
+	}
+	
+	// Pad to the longest ETA so far, to cover the previous draw:
+	const size_t eta_length = strlen(eta);
+	if (eta_length > progress->max_eta_length)
+	{
+		progress->max_eta_length = eta_length;
+	}
+	
+	length += (size_t) snprintf(
+		&line[length], 
+		sizeof(progress->line) - length, 
+		"] %.2f%%. %-*s", 
+		fraction*100.0, 
+		(int) progress->max_eta_length, 
+		eta
+	);
+	
+	fwrite(line, 1, length, progress->stream);
+	fflush(progress->stream);
+	
+	progress->num_renders++;
+}
+
+void checkProgress(
+	      progress_s *progress,
+	const int64_t     ticks
+	) {
+	
+	/**
+     * Redraw if the interval has passed and no other thread is drawing.
+     */
+	
+	const int64_t now = getTimerNs();
+	
+	if (now < __atomic_load_n(&progress->next_render_ns, __ATOMIC_RELAXED))
+	{
+		return;
+	}
+	
+	if (!__atomic_test_and_set(&progress->rendering, __ATOMIC_ACQUIRE))
+	{
+		// Another thread may have drawn since the load above:
+		if (now >= progress->next_render_ns)
+		{
+			__atomic_store_n(
+				&progress->next_render_ns, 
+				now + progress->interval_ns, 
+				__ATOMIC_RELAXED
+			);
+			renderProgress(progress, ticks, now);
+		}
+		
+		__atomic_clear(&progress->rendering, __ATOMIC_RELEASE);
+	}
+}
+
+static inline void tickProgress(
+	progress_s *progress
+	) {
+	
+	/**
+     * Count one tick, safe from any thread. Costs a relaxed atomic 
+	 * increment, plus a clock read every check interval.
+     */
+	
+	const int64_t ticks = 
+		__atomic_add_fetch(&progress->ticks, 1, __ATOMIC_RELAXED);
+	
+	if ((ticks & progress->check_mask) == 0)
+	{
+		checkProgress(progress, ticks);
+	}
+}
+
+void finishProgress(
+	progress_s *progress
+	) {
+	
+	/**
+     * Draw the final state of the bar and end its line. Call after the 
+	 * parallel loop has joined.
+     */
+	
+	renderProgress(
+		progress, 
+		__atomic_load_n(&progress->ticks, __ATOMIC_RELAXED), 
+		getTimerNs()
+	);
+	
+	fputc('\n', progress->stream);
+	fflush(progress->stream);
+}
+
 typedef struct TableColumn {
 	  	
 	      char*         header        ;
@@ -259,7 +801,83 @@ typedef struct Table {
 
 typedef enum {top_e, mid_top_e, mid_e, bottom_e} table_pos_e; 
 
-void printTableSeparator(
+// Bytes a table stream gathers before each write:
+#define TABLE_STREAM_FLUSH_BYTES ((size_t) 64*1024)
+
+typedef struct TableBuffer {
+	
+	/**
+     * Structure to hold table text while it is assembled, so it can be 
+	 * written with one call.
+     */
+	
+	char   *data;
+	size_t  length;
+	size_t  capacity;
+} table_buffer_s;
+
+void reserveTableBuffer(
+	      table_buffer_s *buffer,
+	const size_t          length
+	) {
+	
+	if (buffer->length + length + 1 > buffer->capacity)
+	{
+		size_t capacity = (buffer->capacity > 0) ? buffer->capacity : 4096;
+		while (buffer->length + length + 1 > capacity)
+		{
+			capacity *= 2;
+		}
+		
+		buffer->data     = realloc(buffer->data, capacity);
+		buffer->capacity = capacity;
+	}
+}
+
+void appendTableText(
+	      table_buffer_s *buffer,
+	const char           *text,
+	const size_t          length
+	) {
+	
+	reserveTableBuffer(buffer, length);
+	
+	memcpy(&buffer->data[buffer->length], text, length);
+	buffer->length += length;
+	buffer->data[buffer->length] = '\0';
+}
+
+void appendTableRepeat(
+	      table_buffer_s *buffer,
+	const char           *glyph,
+	const int32_t         count
+	) {
+	
+	/**
+     * Append glyph, which may be multibyte, count times.
+     */
+	
+	if (count <= 0)
+	{
+		return;
+	}
+	
+	const size_t glyph_length = strlen(glyph);
+	reserveTableBuffer(buffer, glyph_length * (size_t) count);
+	
+	char *end = &buffer->data[buffer->length];
+	for (int32_t index = 0; index < count; index++)
+	{
+		memcpy(end, glyph, glyph_length);
+		end += glyph_length;
+	}
+	
+	buffer->length += glyph_length * (size_t) count;
+	buffer->data[buffer->length] = '\0';
+}
+
+void appendTableSeparator(
+	      table_buffer_s *buffer,
 	const table_pos_e     pos,
 	const int32_t         num_columns,
 	const table_column_s *columns,
@@ -272,24 +890,37 @@ void printTableSeparator(
 	
 	const char* centre_thin[] = {"═","╤","╪","╧"};
 
-	printf(left[pos]);
+	appendTableText(buffer, left[pos], strlen(left[pos]));
 	
-	for (int index = 0; index < num_columns; index++ ) 
+	for (int32_t index = 0; index < num_columns; index++ ) 
 	{
-		for (int width_index = 0; width_index < widths[index]; width_index++ ) 
-		{
-			printf("═");
-		}
+		appendTableRepeat(buffer, "═", widths[index]);
+		
 		if (index != (num_columns-1)) 
 		{
-			bool bold = columns[index + 1].bold;
-			printf(bold?centre[pos]:centre_thin[pos]);
+			const char *glyph = 
+				columns[index + 1].bold ? centre[pos] : centre_thin[pos];
+			appendTableText(buffer, glyph, strlen(glyph));
 		}
  	}
 	
-	printf(right[pos]);
+	appendTableText(buffer, right[pos], strlen(right[pos]));
+	appendTableText(buffer, "\n", 1);
+}
 
-	printf("\n");
+void printTableSeparator(
+	const table_pos_e     pos,
+	const int32_t         num_columns,
+	const table_column_s *columns,
+	const int32_t        *widths
+	) {
+	
+	table_buffer_s buffer = {NULL, 0, 0};
+	
+	appendTableSeparator(&buffer, pos, num_columns, columns, widths);
+	fwrite(buffer.data, 1, buffer.length, stdout);
+	
+	free(buffer.data);
 }
 
 char* convertCellToString(
@@ -344,54 +975,122 @@ char* convertCellToString(
 	return string;
 }
 
-void printTable(
-    const table_s table
-    ) {
-
-	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-	//
-	// Prints a table into the console.
-	//
-	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+const char *formatTableCell(
+	      arena_s *arena,
+	const uni_s    cell,
+	const int32_t  decimal_places,
+	      int32_t *ret_length
+	) {
 	
-	//Assigning variables for readablity:
-    const int32_t          num_rows     = table.num_rows;
-    const int32_t          num_columns  = table.num_columns;
-    const table_column_s * columns      = table.columns;
-
-	//Calculate column required widths:
+	/**
+     * Format a cell once, unpadded. Strings are used in place, other types
+	 * are written into arena.
+     * @param
+     *     arena_s       *arena         : arena for formatted text.
+     *     const uni_s    cell          : cell to format.
+     *     const int32_t  decimal_places: decimal places of floats.
+     *           int32_t *ret_length    : length of text.
+     * @see printTable(), streamTableRow().
+     * @return const char *text: cell text.
+     */
+	
+	char scratch[64];
+	int  length = 0;
+	
+	switch(cell.type) 
+	{			
+		case(bool_e):
+			length = 
+				snprintf(scratch, sizeof(scratch), "%i", (int) cell.value.b);
+		break;	
 		
-    int32_t* widths = malloc(sizeof(int) * (size_t) num_columns);
-    for (
-        int32_t column_index = 0; 
-        column_index < num_columns; 
-        column_index++
-    ) {				
-        widths[column_index] = 
-            (int32_t) strlen(columns[column_index].header) + 2;
-    }
-
-    for (int32_t row_index = 0; row_index < num_rows; row_index++ ) 
-    {
-        for (
-            int32_t column_index = 0; 
-            column_index < num_columns; 
-            column_index++
-        ) {
-            int32_t cell_index = row_index*num_columns + column_index;
-
-            table_column_s column = columns[column_index]; 
-            uni_s cell = table.cells[cell_index];
-            widths[column_index] = 
-                (int32_t) strlen(
-                    convertCellToString(cell, widths[column_index] - 2, 
-                    column.decimal_places)
-                );
-        }
-    }
+		case(int_e):
+			length = snprintf(scratch, sizeof(scratch), "%i", cell.value.i);
+		break;
 		
+		case(float_e):
+			length = 
+				snprintf(
+					scratch, sizeof(scratch), "%.*f", 
+					decimal_places, (double) cell.value.f
+				);
+		break;
+		
+		case(char_e):
+			scratch[0] = (cell.value.c != '\0') ? cell.value.c : ' ';
+			length     = 1;
+		break;
+		
+		case(string_e):
+			if ((cell.value.s != NULL) && (cell.value.s[0] != '\0'))
+			{
+				*ret_length = (int32_t) strlen(cell.value.s);
+				return cell.value.s;
+			}
+			scratch[0] = ' ';
+			length     = 1;
+		break;
+		
+		default: 
+			fprintf(stderr, "Warning! Type \"%i\" not recognised!", cell.type);
+			scratch[0] = ' ';
+			length     = 1;
+		break;
+	}
+	
+	char *text = arenaAlloc(arena, (size_t) length + 1);
+	
+	// Only floats near FLT_MAX with many decimals outgrow the scratch:
+	if ((size_t) length >= sizeof(scratch))
+	{
+		snprintf(
+			text, (size_t) length + 1, "%.*f", 
+			decimal_places, (double) cell.value.f
+		);
+	}
+	else
+	{
+		memcpy(text, scratch, (size_t) length + 1);
+	}
+	
+	*ret_length = (int32_t) length;
+	
+	return text;
+}
+
+void appendTableCell(
+	      table_buffer_s *buffer,
+	const bool            bold,
+	const char           *text,
+	const int32_t         length,
+	const int32_t         width
+	) {
+	
+	/**
+     * Append a column border then text right aligned in width, which 
+	 * includes a space either side. Over long text is kept whole.
+     */
+	
+	appendTableText(buffer, bold ? "║" : "│", strlen("║"));
+	appendTableText(buffer, " ", 1);
+	appendTableRepeat(buffer, " ", width - 2 - length);
+	appendTableText(buffer, text, (size_t) length);
+	appendTableText(buffer, " ", 1);
+}
+
+void appendTableHeader(
+	      table_buffer_s *buffer,
+	const char           *title,
+	const int32_t         num_columns,
+	const table_column_s *columns,
+	const int32_t        *widths
+	) {
+	
+	/**
+     * Append the top border, title, and column headers of a table.
+     */
+	
 	//Calculate total table width:
-    
     int32_t table_width = 1; //<-- Add width for last colum separator.
 
     for (int32_t column_index = 0; column_index < num_columns; column_index++) 
@@ -400,99 +1099,424 @@ void printTable(
         table_width += widths[column_index] + 1;
     }
 	
-	//Print Spacing Before table:
-	printf("\n");
+	//Spacing before table:
+	appendTableText(buffer, "\n", 1);
 	
-	//Print table top:
-	printTableSeparator(top_e, num_columns, columns, widths);
+	appendTableSeparator(buffer, top_e, num_columns, columns, widths);
 
  	//Calculate centre of table for title start position:
-    int32_t title_length = (int32_t) strlen(table.title); 
-    int32_t title_start  = table_width - title_length - 2; 
+    const int32_t title_length = (int32_t) strlen(title); 
+          int32_t title_start  = table_width - title_length - 2; 
 
-    if (title_start < 0) 
-    {
-        title_start = 0;
-    } 
-    else 
-    {
-        title_start /= 2;
-    }
+    title_start = (title_start < 0) ? 0 : title_start/2;
 
 	//Calculate remaining space needed to reach end of table: 
-	int32_t title_end = table_width - title_start - title_length - 2;
-
-	//Print title column: 
-    printf("║");
+	const int32_t title_end = table_width - title_start - title_length - 2;
 
-    for (int32_t index = 0; index < (int32_t) title_start; index++ ) 
-    {    
-        printf(" ");
-    }
-
-    printf("%s", table.title);
+	appendTableText  (buffer, "║", strlen("║"));
+	appendTableRepeat(buffer, " ", title_start);
+	appendTableText  (buffer, title, (size_t) title_length);
+	appendTableRepeat(buffer, " ", title_end);
+	appendTableText  (buffer, "║\n", strlen("║\n"));
+	
+	appendTableSeparator(buffer, mid_top_e, num_columns, columns, widths);
 
-    for (int32_t index = 0; index < (int32_t) title_end; index++ ) 
+    for (int32_t column_index = 0; column_index < num_columns; column_index++) 
     {
-        printf(" ");
+		appendTableCell(
+			buffer,
+			columns[column_index].bold || (column_index == 0),
+			columns[column_index].header,
+			(int32_t) strlen(columns[column_index].header),
+			widths[column_index]
+		);
     }
+	appendTableText(buffer, "║\n", strlen("║\n"));
 
-    printf("║\n");
-
- 	//Print Title Separator:
-	
-	printTableSeparator(mid_top_e, num_columns, columns, widths);
-
-	//Print headers:
-    for (int32_t column_index = 0; column_index < num_columns; column_index++ ) 
-    {
+	appendTableSeparator(buffer, mid_e, num_columns, columns, widths);
+}
 
-        table_column_s column = columns[column_index];
+void fprintTable(
+	      FILE    *stream,
+    const table_s  table
+    ) {
 
-        bool bold = (( column.bold ) || ( column_index == 0 ));
-        printf(bold?"║":"│");
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+	//
+	// Prints a table into stream. Each cell is formatted once, while
+	// measuring column widths, and the table is written in one call.
+	//
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+	
+	//Assigning variables for readablity:
+    const int32_t          num_rows     = table.num_rows;
+    const int32_t          num_columns  = table.num_columns;
+    const table_column_s * columns      = table.columns;
+	const size_t           num_cells    = 
+		(size_t) num_rows*(size_t) num_columns;
 
-        printf(" %*s ", widths[column_index] - 2, columns[column_index].header);
+	arena_s *arena = createArena(0);
+	
+	const char **texts   = arenaAlloc(arena, sizeof(char*)   * num_cells + 1);
+	int32_t     *lengths = arenaAlloc(arena, sizeof(int32_t) * num_cells + 1);
+	int32_t     *widths  = 
+		arenaAlloc(arena, sizeof(int32_t) * (size_t) num_columns + 1);
+	
+	//Calculate column required widths:
+    for (int32_t column_index = 0; column_index < num_columns; column_index++) 
+	{				
+        widths[column_index] = 
+            (int32_t) strlen(columns[column_index].header) + 2;
     }
 
-		printf("║\n");
-
-	//Print header separator:
+	for (size_t cell_index = 0; cell_index < num_cells; cell_index++)
+	{
+		const int32_t column_index = 
+			(int32_t) (cell_index % (size_t) num_columns);
+		
+		texts[cell_index] = 
+			formatTableCell(
+				arena, 
+				table.cells[cell_index], 
+				columns[column_index].decimal_places, 
+				&lengths[cell_index]
+			);
+		
+		if (lengths[cell_index] + 2 > widths[column_index])
+		{
+			widths[column_index] = lengths[cell_index] + 2;
+		}
+	}
+	
+	table_buffer_s buffer = {NULL, 0, 0};
+	
+	appendTableHeader(&buffer, table.title, num_columns, columns, widths);
+	
+	for (size_t cell_index = 0; cell_index < num_cells; cell_index++)
+	{
+		const int32_t column_index = 
+			(int32_t) (cell_index % (size_t) num_columns);
+		
+		appendTableCell(
+			&buffer,
+			columns[column_index].bold || (column_index == 0),
+			texts[cell_index],
+			lengths[cell_index],
+			widths[column_index]
+		);
+		
+		if (column_index == num_columns - 1)
+		{
+			appendTableText(&buffer, "║\n", strlen("║\n"));
+		}
+	}
+	
+	appendTableSeparator(&buffer, bottom_e, num_columns, columns, widths);
+	appendTableText(&buffer, "\n", 1);
+	
+	fwrite(buffer.data, 1, buffer.length, stream);
+	
+	free(buffer.data);
+	freeArena(arena);
+}
 
-		printTableSeparator(mid_e, num_columns, columns, widths);
+void printTable(
+    const table_s table
+    ) {
+	
+	// Prints a table into the console:
+	fprintTable(stdout, table);
+}
 
-	//Print data:
+typedef struct TableStream {
+	
+	/**
+     * Structure to hold a table printed a row at a time, for tables too 
+	 * large to hold. Widths are fixed when the stream starts.
+     */
+	
+	int32_t               num_columns;
+	const table_column_s *columns;
+	int32_t              *widths;
+	
+	int64_t               num_rows;
+	FILE                 *stream;
+	arena_s              *arena;
+	table_buffer_s        buffer;
+} table_stream_s;
+
+table_stream_s startTableStream(
+	const char           *title,
+	const int32_t         num_columns,
+	const table_column_s *columns,
+	const int32_t        *widths,
+	const uni_s          *sample_cells,
+	const int32_t         num_sample_rows,
+	      FILE           *stream
+	) {
+	
+	/**
+     * Start a streamed table and write its header.
+     * @param
+     *     const char           *title          : title of table.
+     *     const int32_t         num_columns    : number of columns.
+     *     const table_column_s *columns        : column headers and formats.
+     *     const int32_t        *widths         : text width of each column,
+	 *                                            or NULL to estimate them.
+     *     const uni_s          *sample_cells   : rows to estimate widths 
+	 *                                            from, may be NULL.
+     *     const int32_t         num_sample_rows: number of sample rows.
+     *           FILE           *stream         : where to write table.
+     * @see streamTableRow(), endTableStream().
+     * @return table_stream_s table_stream: stream to add rows to. Cells 
+	 *                                      wider than the estimate push 
+	 *                                      their row out of line.
+     */
+	
+	table_stream_s table_stream = {
+		.num_columns = num_columns,
+		.columns     = columns,
+		.widths      = malloc(sizeof(int32_t) * (size_t) num_columns + 1),
+		.num_rows    = 0,
+		.stream      = stream,
+		.arena       = createArena(0),
+		.buffer      = {NULL, 0, 0}
+	};
+	
+    for (int32_t column_index = 0; column_index < num_columns; column_index++) 
+	{
+		const int32_t header_width = 
+			(int32_t) strlen(columns[column_index].header);
+		
+		table_stream.widths[column_index] = 2 + 
+			(((widths != NULL) && (widths[column_index] > header_width))
+			? widths[column_index] 
+			: header_width);
+	}
+	
+	for (int32_t row_index = 0; row_index < num_sample_rows; row_index++)
+	{
+		for (
+			int32_t column_index = 0; 
+			column_index < num_columns; 
+			column_index++
+		) {
+			int32_t length = 0;
+			formatTableCell(
+				table_stream.arena, 
+				sample_cells[row_index*num_columns + column_index], 
+				columns[column_index].decimal_places, 
+				&length
+			);
+			
+			if (   (widths == NULL) 
+				&& (length + 2 > table_stream.widths[column_index])
+			) {
+				table_stream.widths[column_index] = length + 2;
+			}
+		}
+	}
+	resetArena(table_stream.arena);
+	
+	appendTableHeader(
+		&table_stream.buffer, title, num_columns, columns, table_stream.widths
+	);
+	
+	return table_stream;
+}
 
-    for (int32_t row_index = 0; row_index < num_rows; row_index++) 
-    {
-        for (
-            int32_t column_index = 0; 
-            column_index < num_columns; 
-            column_index++     
-        ) {
-            table_column_s column = columns[column_index];
-            int32_t cell_index = row_index*num_columns + column_index;
+void flushTableStream(
+	table_stream_s *table_stream
+	) {
+	
+	fwrite(
+		table_stream->buffer.data, 1, table_stream->buffer.length, 
+		table_stream->stream
+	);
+	fflush(table_stream->stream);
+	
+	table_stream->buffer.length = 0;
+}
 
-            bool bold = (( column.bold ) || ( column_index == 0 ));
-            printf(bold?"║":"│");
+void streamTableRow(
+	      table_stream_s *table_stream,
+	const uni_s          *cells
+	) {
+	
+	/**
+     * Add one row of num_columns cells to a streamed table. Rows are 
+	 * gathered and written every TABLE_STREAM_FLUSH_BYTES.
+     */
+	
+	for (
+		int32_t column_index = 0; 
+		column_index < table_stream->num_columns; 
+		column_index++
+	) {
+		const table_column_s column = table_stream->columns[column_index];
+		
+		int32_t     length = 0;
+		const char *text   = 
+			formatTableCell(
+				table_stream->arena, 
+				cells[column_index], 
+				column.decimal_places, 
+				&length
+			);
+		
+		appendTableCell(
+			&table_stream->buffer,
+			column.bold || (column_index == 0),
+			text,
+			length,
+			table_stream->widths[column_index]
+		);
+	}
+	appendTableText(&table_stream->buffer, "║\n", strlen("║\n"));
+	
+	table_stream->num_rows++;
+	
+	if (table_stream->buffer.length >= TABLE_STREAM_FLUSH_BYTES)
+	{
+		flushTableStream(table_stream);
+		resetArena(table_stream->arena);
+	}
+}
 
-            int32_t   width          = widths[column_index] - 2;
-            int32_t   decimal_places = column.decimal_places;
-            uni_s cell           = table.cells[cell_index];
+void endTableStream(
+	table_stream_s *table_stream
+	) {
+	
+	/**
+     * Write the bottom of a streamed table and free the stream.
+     */
+	
+	appendTableSeparator(
+		&table_stream->buffer, 
+		bottom_e, 
+		table_stream->num_columns, 
+		table_stream->columns, 
+		table_stream->widths
+	);
+	appendTableText(&table_stream->buffer, "\n", 1);
+	
+	flushTableStream(table_stream);
+	
+	free(table_stream->buffer.data);
+	free(table_stream->widths);
+	freeArena(table_stream->arena);
+}
 
-            printf(convertCellToString(cell, width, decimal_places));					
+void orderTimerScopes(
+    const timer_profile_s *profile,
+    const int32_t          parent,
+          int32_t         *order,
+          int32_t         *num_ordered
+    ) {
+    
+    /**
+     * List scopes depth first, each after the scope it was first opened in.
+     */
+    
+    for (int32_t scope = 0; scope < profile->num_scopes; scope++)
+    {
+        if (profile->scopes[scope].parent == parent)
+        {
+            order[(*num_ordered)++] = scope;
+            orderTimerScopes(profile, scope, order, num_ordered);
         }
-
-        printf("║\n");
     }
+}
 
-	//Print table bottom:
-
-		printTableSeparator(bottom_e, num_columns, columns, widths);
-	
-	//Print Spacing post table:
-		
-		printf("\n");
+void printTimerProfile(
+    const timer_profile_s *profile,
+    const char            *title
+    ) {
+    
+    /**
+     * Print laps, total, and min/mean/p50/p99/max lap time of every scope 
+     * in profile as a table. Nested scopes follow their parent, marked with 
+     * a '-' per level.
+     * @param
+     *     const timer_profile_s *profile: profile to summarise.
+     *     const char            *title  : title of table.
+     * @see getTimerPercentile(), printTable().
+     */
+    
+    const int32_t num_columns = 8;
+    const int32_t num_scopes  = profile->num_scopes;
+    
+    int32_t *order       = malloc(sizeof(int32_t) * (size_t) (num_scopes + 1));
+    int32_t  num_ordered = 0;
+    
+    orderTimerScopes(profile, -1, order, &num_ordered);
+    
+    uni_s *cells = 
+        malloc(sizeof(uni_s) * (size_t) (num_ordered*num_columns + 1));
+    char  *names = 
+        malloc(sizeof(char) * (size_t) (num_ordered*(TIMER_MAX_DEPTH*2 + 65)));
+    char  *laps  = malloc(sizeof(char) * (size_t) (num_ordered*24 + 1));
+    
+    for (int32_t row = 0; row < num_ordered; row++)
+    {
+        const timer_scope_s *scope = &profile->scopes[order[row]];
+        
+        char *name = &names[row*(TIMER_MAX_DEPTH*2 + 65)];
+        int32_t length = 0;
+        for (int32_t level = 0; level < scope->depth; level++)
+        {
+            name[length++] = '-';
+            name[length++] = ' ';
+        }
+        snprintf(&name[length], 65, "%s", scope->name);
+        
+        snprintf(&laps[row*24], 24, "%" PRId64, scope->count);
+        
+        const double count = (scope->count > 0) ? (double) scope->count : 1.0;
+        const double times_us[6] = 
+        {
+            (double) scope->total_ns*1.0E-6,
+            (double) scope->total_ns/count*1.0E-3,
+            (double) ((scope->count > 0) ? scope->min_ns : 0)*1.0E-3,
+            (double) getTimerPercentile(scope, 50.0)*1.0E-3,
+            (double) getTimerPercentile(scope, 99.0)*1.0E-3,
+            (double) scope->max_ns*1.0E-3
+        };
+        
+        uni_s *cell = &cells[row*num_columns];
+        
+        cell[0].value.s = name;
+        cell[0].type    = string_e;
+        cell[1].value.s = &laps[row*24];
+        cell[1].type    = string_e;
+        
+        for (int32_t column = 0; column < 6; column++)
+        {
+            cell[column + 2].value.f = (float) times_us[column];
+            cell[column + 2].type    = float_e;
+        }
+    }
+    
+    const table_column_s columns[] = {
+        {"Scope"     , 0, 1},
+        {"Laps"      , 0, 1},
+        {"Total (ms)", 3, 1},
+        {"Mean (us)" , 3, 0},
+        {"Min (us)"  , 3, 0},
+        {"P50 (us)"  , 3, 0},
+        {"P99 (us)"  , 3, 0},
+        {"Max (us)"  , 3, 0}
+    };
+    
+    printTable((table_s) {
+        num_ordered,
+        num_columns,
+        title,
+        cells,
+        columns
+    });
+    
+    free(order); free(cells); free(names); free(laps);
 }
 
 void printTitle(
@@ -10,6 +10,14 @@
 #include <stdbool.h>
 #include <inttypes.h>
 
+#include "io_tools/arena.h"
+#include "io_tools/numbers.h"
+#include "io_tools/config_stats.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 typedef enum Type {
 	
 	/**
@@ -271,6 +279,53 @@ size_t getSizeOfType(
 	return size;
 }
 
+size_t getAlignmentOfType(
+	const type_e type
+	) {
+	
+	/**
+     * Return the alignment, in bytes, the compiler gives a struct member of 
+	 * entered type enum.
+     * @param 
+     *     const type_e type: type enum to return alignment of.
+     * @see getSizeOfType()
+     * @return size_t alignment: alignment of type.
+     */
+	
+	size_t alignment = 1;
+	switch(type) 
+	{	
+		case(none_e        ): alignment = 1                  ; break;
+		case(bool_e        ): alignment = _Alignof(bool     ); break;
+		case(bool_array_e  ): alignment = _Alignof(bool*    ); break;
+		
+		case(int_e         ): alignment = _Alignof(int32_t  ); break;
+		case(int_array_e   ): alignment = _Alignof(int32_t* ); break;
+		case(int_jagged_e  ): alignment = _Alignof(int32_t**); break;			
+			
+		case(float_e       ): alignment = _Alignof(float    ); break;
+		case(float_array_e ): alignment = _Alignof(float*   ); break;
+		case(float_jagged_e): alignment = _Alignof(float**  ); break;		
+
+		case(char_e        ): alignment = _Alignof(char     ); break;
+		case(char_array_e  ): alignment = _Alignof(char*    ); break;
+		
+		case(string_e      ): alignment = _Alignof(char*    ); break;		
+		case(string_array_e): alignment = _Alignof(char**   ); break;
+			
+		default:
+			
+			fprintf(
+				stderr, 
+				"getAlignmentOfType: \nWarning! Type \"%s\" not recognised! \n", 
+				typeToString(type)
+			);
+		break;
+	}
+	
+	return alignment;
+}
+
 type_e getBaseType(
 	const type_e type
 	) {
@@ -417,9 +472,11 @@ bool stringToBool(
 	
 	if isdigit(string[0]) 
 	{
-		int32_t bool_value = atoi(string);
+		int32_t bool_value = 0;
+		const number_status_e status = 
+			parseInt32Number(string, NULL, &bool_value, NULL);
 
-		if ((bool_value > 1) || (bool_value < 0)) 
+		if ((status != number_ok_e) || (bool_value > 1) || (bool_value < 0)) 
 		{
 			if (verbosity > 1) 
 			{
@@ -433,7 +490,7 @@ bool stringToBool(
 		} 
 		else 
 		{
-			value = (bool) atoi(string); 
+			value = (bool) bool_value; 
 		}
 	} 
 	else if (!strcmp(string, "true")) 
@@ -465,38 +522,73 @@ int32_t stringToInt(
 	const char    *string
 	) {
 	
-	int32_t value = 0;
+	int32_t     value = 0;
+	const char *end   = NULL;
 	
-	if ( strchr(string, '.') ) 
-	{
-		fprintf(
-			stderr, 
-			"stringToInt: \nWarning! Decimal detected in: %s, ignoring post"
-			" decimal values. \n", 
-			string
-		);
-
-		char *string_copy = strdup(string);
-		strtok(string_copy, ".");
-
-		string = string_copy;
-	}
-
-	if (isdigit(string[0]) || (string[0] == '-'))
+	const number_status_e status = 
+		parseInt32Number(string, NULL, &value, &end);
+	
+	float decimal_value = 0.0f;
+	
+	switch (status)
 	{
-		value = (int32_t) atoi(string); 
-	} 
-	else 
-	{	
-		if (verbosity > 1) 
-		{
-			fprintf(
-				stderr, 
-				"stringToInt: \nWarning! Int value %s not recognised! \n", 
-				string
-			);
-		}
-		value = 0;
+		case (number_ok_e):
+		break;
+		
+		case (number_trailing_e):
+			// A valid decimal keeps its integer part, anything else is 
+			// rejected:
+			if (   (*end == '.') 
+				&& (parseFloatNumber(string, NULL, &decimal_value, NULL) 
+					== number_ok_e)
+			) {
+				fprintf(
+					stderr, 
+					"stringToInt: \nWarning! Decimal detected in: %s, ignoring"
+					" post decimal values. \n", 
+					string
+				);
+			}
+			else
+			{
+				if (verbosity > 0) 
+				{
+					fprintf(
+						stderr, 
+						"stringToInt: \nWarning! Trailing characters \"%s\" "
+						"after int value %s, rejected! \n", 
+						end,
+						string
+					);
+				}
+				value = 0;
+			}
+		break;
+		
+		case (number_range_e):
+			if (verbosity > 0) 
+			{
+				fprintf(
+					stderr, 
+					"stringToInt: \nWarning! Int value %s out of range, "
+					"clamped to %i! \n", 
+					string,
+					value
+				);
+			}
+		break;
+		
+		case (number_empty_e):
+			if (verbosity > 1) 
+			{
+				fprintf(
+					stderr, 
+					"stringToInt: \nWarning! Int value %s not recognised! \n", 
+					string
+				);
+			}
+			value = 0;
+		break;
 	}
 	
 	return value;
@@ -507,40 +599,75 @@ float stringToFloat(
 	const char    *string
 	) {
 	
-	float value = 0.0f;
+	float       value = 0.0f;
+	const char *end   = NULL;
 	
-	if (isdigit(string[0]) || (string[0] == '-')) 
-	{
-		value = (float) atof(string); 
-	} 
-    else 
+	const number_status_e status = 
+		parseFloatNumber(string, NULL, &value, &end);
+	
+	switch (status)
 	{
-		if (verbosity > 1) 
-		{
-			fprintf(
-				stderr, 
-				"stringToFloat: \nWarning! Float value %s not recognised! \n",
-				string
-			);
-		}
-		value = 0.0f;
+		case (number_ok_e):
+		break;
+		
+		case (number_trailing_e):
+			if (verbosity > 0) 
+			{
+				fprintf(
+					stderr, 
+					"stringToFloat: \nWarning! Trailing characters \"%s\" "
+					"after float value %s, rejected! \n", 
+					end,
+					string
+				);
+			}
+			value = 0.0f;
+		break;
+		
+		case (number_range_e):
+			if (verbosity > 0) 
+			{
+				fprintf(
+					stderr, 
+					"stringToFloat: \nWarning! Float value %s out of range! \n", 
+					string
+				);
+			}
+		break;
+		
+		case (number_empty_e):
+			if (verbosity > 1) 
+			{
+				fprintf(
+					stderr, 
+					"stringToFloat: \nWarning! Float value %s not recognised! \n",
+					string
+				);
+			}
+			value = 0.0f;
+		break;
 	}
 	
 	return value;
 }
 
-multi_s StringToMultiS(
+multi_s StringToMultiSArena(
 	const int32_t  verbosity,
 	const char    *string,
-	const type_e   type
+	const type_e   type,
+	      arena_s *arena
 	) {
 	
 	/**
-     * Convert string to void pointer with structure of type.
+     * Convert string to multi_s of entered type.
      * @param 
-     *     const multi_s data: multi_s structure to return in string format.
-     * @see
-     * @return char *string: inputted multi_s value in string format.
+     *     const int32_t  verbosity: verbosity level of warnings.
+     *     const char    *string   : string to convert.
+     *     const type_e   type     : type to convert to.
+     *           arena_s *arena    : arena strings are copied into, or NULL
+     *                               to use malloc.
+     * @see StringToMultiS()
+     * @return multi_s value: converted value.
      */
 	multi_s value;
 	value.type = type;
@@ -576,7 +703,7 @@ multi_s StringToMultiS(
 		break;
 
 		case(string_e): 
-			asprintf(&value.value.s, "%s", string); 
+			value.value.s = arenaStrdup(arena, string); 
 		break;
 	
 		default:
@@ -595,25 +722,54 @@ multi_s StringToMultiS(
 	return value;
 }
 
-array_s stringToArrayS(
+multi_s StringToMultiS(
 	const int32_t  verbosity,
 	const char    *string,
 	const type_e   type
 	) {
 	
+	/**
+     * Convert string to multi_s of entered type, strings are allocated with 
+	 * malloc.
+     * @see StringToMultiSArena()
+     */
+	
+	return StringToMultiSArena(verbosity, string, type, NULL);
+}
+
+array_s stringToArraySArena(
+	const int32_t  verbosity,
+	const char    *string,
+	const type_e   type,
+	      arena_s *arena
+	) {
+	
+	/**
+     * Convert a comma separated string to an array of entered type.
+     * @param 
+     *     const int32_t  verbosity: verbosity level of warnings.
+     *     const char    *string   : string to convert.
+     *     const type_e   type     : array type to convert to.
+     *           arena_s *arena    : arena elements are allocated from, or 
+     *                               NULL to use malloc.
+     * @see stringToArrayS()
+     * @return array_s array: converted array.
+     */
+	
 	const char *delimiter = ",";
 	
-	char *string_copy = strdup(string);
+	char *string_copy = arenaStrdup(arena, string);
 	
 	const type_e  base_type            = getBaseType(type);
 	const size_t  size                 = getSizeOfType(base_type);
 	const int32_t initial_num_elements = 1;
 	      int32_t num_elements         = initial_num_elements;
+	      size_t  capacity             = sizeof(multi_s);
 		 	
-	void *elements = malloc(sizeof(multi_s)*(size_t)num_elements);
+	void *elements = arenaAlloc(arena, capacity);
 
-	char *buffer = NULL;
-	buffer = strtok(string_copy, delimiter);
+	char *save   = NULL;
+	char *buffer = strtok_r(string_copy, delimiter, &save);
 	
 	int32_t index = 0;	   
 	/* walk through other tokens */
@@ -621,10 +777,11 @@ array_s stringToArrayS(
 	{				
 		int32_t position = index*(int32_t)size;
 		multi_s element = 
-			StringToMultiS(
+			StringToMultiSArena(
 					verbosity,
 					buffer,
-					base_type
+					base_type,
+					arena
 				);
 				
 		memcpy(&((char*)elements)[position], &element, size);			
@@ -633,16 +790,22 @@ array_s stringToArrayS(
 		if (index > num_elements)
 		{
 			num_elements *= 2; 
-			elements = realloc(
-                elements, size * (size_t) num_elements + sizeof(multi_s));
+			
+			const size_t new_capacity = 
+				size * (size_t) num_elements + sizeof(multi_s);
+			
+			elements = 
+				arenaRealloc(arena, elements, capacity, new_capacity);
+			capacity = new_capacity;
 		}
 		
-		buffer = strtok(NULL, delimiter);
+		buffer = strtok_r(NULL, delimiter, &save);
 	}
 	
 	num_elements = index;
 
-	elements = realloc(elements, size * (size_t) num_elements);
+	elements = 
+		arenaRealloc(arena, elements, capacity, size * (size_t) num_elements);
 	
 	array_s array = ArrayS(
 		verbosity,
@@ -651,11 +814,258 @@ array_s stringToArrayS(
 		type
 	);
 		
-	free(string_copy);
+	arenaFree(arena, string_copy);
 	
 	return array;
 }
 
+array_s stringToArrayS(
+	const int32_t  verbosity,
+	const char    *string,
+	const type_e   type
+	) {
+	
+	return stringToArraySArena(verbosity, string, type, NULL);
+}
+
+static inline bool isArrayBlank(
+	const char character
+	) {
+	
+	return (character == ' ' ) || (character == '\t') 
+		|| (character == '\n') || (character == '\r')
+		|| (character == '(' ) || (character == ')' );
+}
+
+size_t countArraySeparators(
+	const char   *string,
+	const size_t  length
+	) {
+	
+	/**
+     * Count the ',' characters of an array value, 32 or 16 bytes at a time.
+     * @see parseArrayArena(), countNewLines().
+     * @return size_t num_separators: number of ',' characters.
+     */
+	
+	size_t num_separators = 0;
+	size_t position       = 0;
+	
+	#if defined(__AVX2__)
+	const __m256i separator = _mm256_set1_epi8(',');
+	for (; position + 32 <= length; position += 32)
+	{
+		const __m256i block = 
+			_mm256_loadu_si256((const __m256i*) &string[position]);
+		const uint32_t mask = (uint32_t) 
+			_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, separator));
+		
+		num_separators += (size_t) __builtin_popcount(mask);
+	}
+	#elif defined(__SSE2__)
+	const __m128i separator = _mm_set1_epi8(',');
+	for (; position + 16 <= length; position += 16)
+	{
+		const __m128i block = 
+			_mm_loadu_si128((const __m128i*) &string[position]);
+		const uint32_t mask = (uint32_t) 
+			_mm_movemask_epi8(_mm_cmpeq_epi8(block, separator));
+		
+		num_separators += (size_t) __builtin_popcount(mask);
+	}
+	#endif
+	
+	for (; position < length; position++)
+	{
+		num_separators += (string[position] == ',');
+	}
+	
+	return num_separators;
+}
+
+void warnArrayElement(
+	const int32_t          verbosity,
+	const number_status_e  status,
+	const char            *begin,
+	const char            *end,
+	const type_e           base_type
+	) {
+	
+	if (   ((status == number_empty_e) && (verbosity > 1))
+		|| ((status != number_empty_e) && (verbosity > 0))
+	) {
+		fprintf(
+			stderr, 
+			"parseArrayArena: \nWarning! %s element \"%.*s\" %s! \n", 
+			typeToString(base_type),
+			(int) (end - begin), 
+			begin,
+			(status == number_range_e) ? "out of range" : "not recognised"
+		);
+	}
+}
+
+array_s parseArrayArena(
+	const int32_t  verbosity,
+	const char    *string,
+	const size_t   length,
+	const type_e   type,
+	      arena_s *arena
+	) {
+	
+	/**
+     * Convert a comma separated bool, int or float array value in place, 
+	 * without copying the text or building a multi_s per element. 
+	 * Separators are counted first so the elements are allocated once, at 
+	 * their final size. Whitespace and parentheses around elements are 
+	 * skipped, empty elements are dropped as by stringToArraySArena().
+     * @param 
+     *     const int32_t  verbosity: verbosity level of warnings.
+     *     const char    *string   : array text, need not be null terminated.
+     *     const size_t   length   : number of characters in string.
+     *     const type_e   type     : bool_array_e, int_array_e or 
+	 *                               float_array_e, other types are passed to
+	 *                               stringToArraySArena().
+     *           arena_s *arena    : arena elements are allocated from, or 
+     *                               NULL to use malloc.
+     * @see stringToArraySArena(), parseFloatNumber(), parseInt32Number().
+     * @return array_s array: converted array.
+     */
+	
+	if ((type != bool_array_e) && (type != int_array_e) 
+		&& (type != float_array_e))
+	{
+		char *copy = arenaStrndup(arena, string, length);
+		
+		const array_s array = 
+			stringToArraySArena(verbosity, copy, type, arena);
+		arenaFree(arena, copy);
+		
+		return array;
+	}
+	
+	const type_e  base_type    = getBaseType(type);
+	const size_t  max_elements = countArraySeparators(string, length) + 1;
+	
+	void *elements = 
+		arenaAlloc(arena, getSizeOfType(base_type) * max_elements);
+	
+	bool    *bools  = (bool*   ) elements;
+	int32_t *ints   = (int32_t*) elements;
+	float   *floats = (float*  ) elements;
+	
+	const char *position     = string;
+	const char *string_end   = string + length;
+	int32_t     num_elements = 0;
+	
+	while (position < string_end)
+	{
+		const char *separator = 
+			memchr(position, ',', (size_t) (string_end - position));
+		const char *end   = (separator != NULL) ? separator : string_end;
+		const char *begin = position;
+		
+		position = (separator != NULL) ? separator + 1 : string_end;
+		
+		while ((begin < end) && isArrayBlank(*begin))
+		{
+			begin++;
+		}
+		while ((end > begin) && isArrayBlank(end[-1]))
+		{
+			end--;
+		}
+		if (begin == end)
+		{
+			continue;
+		}
+		
+		number_status_e status = number_ok_e;
+		
+		switch (base_type)
+		{
+			case (float_e):
+				status = 
+					parseFloatNumber(begin, end, &floats[num_elements], NULL);
+				if ((status == number_trailing_e) || (status == number_empty_e))
+				{
+					floats[num_elements] = 0.0f;
+				}
+			break;
+			
+			case (int_e):
+			{
+				const char *number_end    = NULL;
+				float       decimal_value = 0.0f;
+				
+				status = 
+					parseInt32Number(
+						begin, end, &ints[num_elements], &number_end
+					);
+				
+				// A valid decimal keeps its integer part, as in stringToInt():
+				if (   (status == number_trailing_e)
+					&& (*number_end == '.')
+					&& (parseFloatNumber(begin, end, &decimal_value, NULL)
+						== number_ok_e)
+				) {
+					fprintf(
+						stderr, 
+						"parseArrayArena: \nWarning! Decimal detected in: "
+						"%.*s, ignoring post decimal values. \n", 
+						(int) (end - begin),
+						begin
+					);
+					status = number_ok_e;
+				}
+				else if (
+					   (status == number_trailing_e) 
+					|| (status == number_empty_e)
+				) {
+					ints[num_elements] = 0;
+				}
+			}
+			break;
+			
+			default:
+			{
+				const size_t element_length = (size_t) (end - begin);
+				int32_t      bool_value     = 0;
+				
+				if ((element_length == 4) && !memcmp(begin, "true", 4))
+				{
+					bools[num_elements] = true;
+				}
+				else if ((element_length == 5) && !memcmp(begin, "false", 5))
+				{
+					bools[num_elements] = false;
+				}
+				else
+				{
+					status = parseInt32Number(begin, end, &bool_value, NULL);
+					if ((status == number_ok_e) 
+						&& ((bool_value < 0) || (bool_value > 1)))
+					{
+						status = number_range_e;
+					}
+					bools[num_elements] = 
+						(status == number_ok_e) && (bool_value == 1);
+				}
+			}
+			break;
+		}
+		
+		if (status != number_ok_e)
+		{
+			warnArrayElement(verbosity, status, begin, end, base_type);
+		}
+		
+		num_elements++;
+	}
+	
+	return ArrayS(verbosity, elements, num_elements, type);
+}
+
 char *MultiStoString(
 	const multi_s data
 	) {
@@ -767,9 +1177,21 @@ void freeMultiS(
 	switch(data.type) {
 		
 		case(none_e   ): 
+		case(bool_e   ): 
+		case(int_e    ): 
+		case(float_e  ): 
+		case(char_e   ): 
 		
 		break;
 		
+		case(string_e   ): 
+			
+			if (data.value.s  != NULL) 
+			{
+				free(data.value.s); 
+			} 
+		break;
+		
 		case(bool_array_e   ): 
 			
 			if (data.value.bb  != NULL) 
@@ -869,8 +1291,9 @@ typedef struct DictEntry {
 	
 	      multi_s     data;   
 	
-          int32_t     hash; 
+          uint64_t    hash; 
     const char       *string_key;
+          size_t      key_length;
 	
 	struct DictEntry *previous_entry;
 	struct DictEntry *next_entry;
@@ -879,61 +1302,205 @@ typedef struct DictEntry {
 
 typedef struct Dictionary {
 	
+	/**
+     * Open addressing hash table of dict_entry_s pointers. The table is 
+     * always a power of two in length and grows once it is three quarters
+     * full, counting deleted slots. Entries are also kept in a doubly linked
+     * list, in insertion order.
+     */
+	
 	int32_t        length;
 	int32_t        num_entries;
+	int32_t        num_tombstones;
 	
 	dict_entry_s **entries;
 	dict_entry_s  *last_entry;
 	
+	// If set, table, entries and keys are allocated from here:
+	arena_s       *arena;
+	
 } dict_s;
 
-dict_s* makeDictionary(
-	const int32_t length
+// Marks a deleted slot, so probe sequences passing through it stay intact:
+static dict_entry_s dict_tombstone;
+#define DICT_TOMBSTONE (&dict_tombstone)
+
+#define DICT_MIN_LENGTH 8
+
+static inline uint64_t mixHash(
+	const uint64_t a,
+	const uint64_t b
 	) {
 	
-	/**
-     * Create dictionary data structure.
-     * @param 
-     *     const int32_t length: number of elements to allocate for storage of 
-     *                           unique hashes.
-     * @see
-     * @return dict_s *dictionary: pointer to newly created dictionary.
-     */
+	const __uint128_t product = (__uint128_t) a * b;
 	
-	dict_s* dict      = malloc(sizeof(dict_s));
+	return (uint64_t) product ^ (uint64_t) (product >> 64);
+}
+
+static inline uint64_t readHash64(
+	const uint8_t *bytes
+	) {
 	
-	dict->length      = length;
-	dict->num_entries = 0;
-	dict->entries     = calloc( (size_t) length, sizeof(dict_entry_s*));
-	dict->last_entry  = NULL;
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
 	
-	return dict;
+	return value;
 }
 
-int32_t StringToKey(
-	const char *string_key
+static inline uint64_t readHash32(
+	const uint8_t *bytes
+	) {
+	
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	
+	return value;
+}
+
+uint64_t hashString(
+	const char   *string_key,
+	const size_t  length
 	) {
 	
 	/**
-     * Generate pseudo-random number from string.
+     * Hash the first length characters of a string, which does not need to 
+     * be null terminated. Follows the wyhash construction: input is folded 
+     * into the state with 64x64->128 bit multiplies, so every input bit 
+     * affects every output bit.
      * @param 
-     *     const char string_key: String key to convert to numerical key.
-     * @see getDictHashCode()
-     * @return int32_t key: pseudo random numerical key.
+     *     const char   *string_key: String key to hash.
+     *     const size_t  length    : Number of characters in key.
+     * @see getDictHashCodeN()
+     * @return uint64_t hash: 64 bit hash of key.
      */
 	
-	int     index   = 0;
-	char    current = string_key[index];
-	int32_t key     = 0;
+	const uint64_t secret[4] = 
+	{
+		0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 
+		0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+	};
+	
+	const uint8_t *bytes = (const uint8_t*) string_key;
+	      uint64_t seed  = mixHash(secret[0], secret[1]);
+	      uint64_t a     = 0;
+	      uint64_t b     = 0;
 	
-	while (current != '\0') {
+	if (length <= 16)
+	{
+		if (length >= 4)
+		{
+			const size_t shift = (length >> 3) << 2;
+			
+			a = (readHash32(bytes) << 32) | readHash32(&bytes[shift]);
+			b = (readHash32(&bytes[length - 4]) << 32) 
+			  | readHash32(&bytes[length - 4 - shift]);
+		}
+		else if (length > 0)
+		{
+			a = ((uint64_t) bytes[0] << 16) 
+			  | ((uint64_t) bytes[length >> 1] << 8) 
+			  | bytes[length - 1];
+		}
+	}
+	else
+	{
+		size_t remaining = length;
 		
-		key += (int) current*index;	
-		index++;
+		while (remaining > 16)
+		{
+			seed = 
+				mixHash(
+					readHash64(bytes) ^ secret[1], 
+					readHash64(&bytes[8]) ^ seed
+				);
+			bytes     += 16;
+			remaining -= 16;
+		}
 		
-		current = string_key[index];
+		a = readHash64(&bytes[remaining - 16]);
+		b = readHash64(&bytes[remaining - 8]);
 	}
-	return key;
+	
+	a ^= secret[1];
+	b ^= seed;
+	
+	const __uint128_t product = (__uint128_t) a * b;
+	
+	return mixHash(
+		(uint64_t) product ^ secret[0] ^ length, 
+		(uint64_t) (product >> 64) ^ secret[1]
+	);
+}
+
+dict_s* makeDictionaryArena(
+	const int32_t  length,
+	      arena_s *arena
+	) {
+	
+	/**
+     * Create dictionary data structure.
+     * @param 
+     *     const int32_t  length: expected number of entries, the dictionary
+     *                            grows past this if needed.
+     *           arena_s *arena : arena to allocate from, or NULL for malloc.
+     * @see insertDictEntry(), makeDictionary()
+     * @return dict_s *dictionary: pointer to newly created dictionary.
+     */
+	
+	// Smallest power of two that holds length entries below the load limit:
+	int32_t table_length = DICT_MIN_LENGTH;
+	while (table_length*3 < length*4)
+	{
+		table_length *= 2;
+	}
+	
+	dict_s* dict         = arenaAlloc(arena, sizeof(dict_s));
+	
+	dict->length         = table_length;
+	dict->num_entries    = 0;
+	dict->num_tombstones = 0;
+	dict->entries        = 
+		arenaCalloc(arena, (size_t) table_length, sizeof(dict_entry_s*));
+	dict->last_entry     = NULL;
+	dict->arena          = arena;
+	
+	return dict;
+}
+
+dict_s* makeDictionary(
+	const int32_t length
+	) {
+	
+	/**
+     * Create dictionary data structure, allocated with malloc.
+     * @param 
+     *     const int32_t length: expected number of entries, the dictionary
+     *                           grows past this if needed.
+     * @see makeDictionaryArena()
+     * @return dict_s *dictionary: pointer to newly created dictionary.
+     */
+	
+	return makeDictionaryArena(length, NULL);
+}
+
+int32_t getDictHashCodeN(
+	const dict_s *dict, 
+	const char   *string_key,
+	const size_t  length
+	) {
+	
+	/**
+     * Find the home slot of a string key view of entered length.
+     * @param 
+	 *     const dict_s *dict      : Dictionary to hash with string_key.
+     *     const char   *string_key: String key to link to dictionary index.
+     *     const size_t  length    : Number of characters in key.
+     * @see hashString()
+     * @return int32_t hash: hash to dictionary index.
+     */
+
+	return (int32_t) 
+		(hashString(string_key, length) & (uint64_t) (dict->length - 1));
 }
 
 int32_t getDictHashCode(
@@ -942,27 +1509,79 @@ int32_t getDictHashCode(
 	) {
 	
 	/**
-     * Find dict hash given string key input. Will
-	 * always return same hash for the same string,
-	 * but Dose not garantee different hash for 
-	 * differnt strings.
+     * Find dict hash given string key input. Will always return same hash 
+	 * for the same string and dictionary length.
      * @param 
 	 *     const dict_s *dict     : Dictionary to hash with string_key.
      *     const char  *string_key: String key to link to dictionary index.
-     * @see StringToKey()
+     * @see getDictHashCodeN()
      * @return int32_t hash: hash to dictionary index.
      */
 
-   const int32_t key = StringToKey(string_key);
-   
-   int32_t hash = -1;
-   
-   if (dict->length > 0) 
-   {
-        hash = key % dict->length;
-   }
-   
-   return hash;
+	return getDictHashCodeN(dict, string_key, strlen(string_key));
+}
+
+void placeDictEntry(
+	dict_s       *dict,
+	dict_entry_s *entry
+	) {
+	
+	/**
+     * Place entry in the first free or deleted slot of its probe sequence.
+     * The table must have at least one free slot.
+     */
+	
+	const uint64_t mask  = (uint64_t) (dict->length - 1);
+	      uint64_t index = entry->hash & mask;
+	
+	while (   (dict->entries[index] != NULL) 
+		   && (dict->entries[index] != DICT_TOMBSTONE)
+	) {
+		index = (index + 1) & mask; //Wrap around.
+	}
+	
+	if (dict->entries[index] == DICT_TOMBSTONE)
+	{
+		dict->num_tombstones--;
+	}
+	
+	dict->entries[index] = entry;
+}
+
+void resizeDictionary(
+	      dict_s  *dict,
+	const int32_t  length
+	) {
+	
+	/**
+     * Rehash all entries into a new table of entered length, clearing any
+     * tombstones. Cached hashes mean no key is rehashed.
+     * @param 
+	 *     dict_s        *dict  : Dictionary to resize.
+	 *     const int32_t  length: New table length, must be a power of two
+	 *                            greater than the number of entries.
+     * @see insertDictEntry().
+     * @return none.
+     */
+	
+	dict_entry_s **old_entries = dict->entries;
+	const int32_t  old_length  = dict->length;
+	
+	dict->entries        = 
+		arenaCalloc(dict->arena, (size_t) length, sizeof(dict_entry_s*));
+	dict->length         = length;
+	dict->num_tombstones = 0;
+	
+	for (int32_t index = 0; index < old_length; index++)
+	{
+		if ((old_entries[index] != NULL) 
+			&& (old_entries[index] != DICT_TOMBSTONE))
+		{
+			placeDictEntry(dict, old_entries[index]);
+		}
+	}
+	
+	arenaFree(dict->arena, old_entries);
 }
 
 int32_t insertDictEntry(
@@ -972,61 +1591,98 @@ int32_t insertDictEntry(
 	) {
 	
 	/**
-     * Insert new multi_s entry into dictionary pointed to by dict.
+     * Insert new multi_s entry into dictionary pointed to by dict, growing
+     * the table if it would pass its load limit.
      * @param 
 	 *     const dict_s  *dict      : Dictionary to hash with string_key.
 	 *     const multi_s *data      : Data to insert into dictionary.
      *     const char    *string_key: String key to insert data at given hash.
-     * @see getDictHashCode(), multi_s.
+     * @see resizeDictionary(), multi_s.
      * @return int32_t return_value: Returns 0 if successful, else return 1.
      */
 	
-	const char *string_key = strdup(string_key_o);
+	if ((dict->num_entries + dict->num_tombstones + 1)*4 > dict->length*3)
+	{
+		// Only grow if live entries, not tombstones, fill the table:
+		const int32_t length = 
+			((dict->num_entries + 1)*2 > dict->length) 
+			? dict->length*2 
+			: dict->length;
+		
+		resizeDictionary(dict, length);
+	}
 	
-	dict->num_entries++;
-	if (dict->num_entries > dict->length) 
-    {
-		fprintf(
-            stderr, 
-            "Warning dictionary too small! Cannot add entry: %s. \n", 
-            string_key
-        );
-        
-		return 1;
+	const size_t key_length = strlen(string_key_o);
+	
+	dict_entry_s* entry = arenaAlloc(dict->arena, sizeof(dict_entry_s));
+	
+	*entry = (dict_entry_s) {  
+		data                                               ,
+		hashString(string_key_o, key_length)               ,
+		arenaStrndup(dict->arena, string_key_o, key_length),
+		key_length                                         ,
+		dict->last_entry                                   ,
+		NULL
+	};
+	
+	if ( dict->last_entry != NULL) 
+	{
+		dict->last_entry->next_entry = entry;
 	}
 	
-	const int32_t hash = getDictHashCode(dict, string_key);
+	placeDictEntry(dict, entry);
 	
-    if ((hash >= 0) && (hash < dict->length))
-    {
-        dict_entry_s* entry = malloc(sizeof(dict_entry_s));
-
-        *entry = (dict_entry_s) {  
-            data            ,
-            hash            ,
-            string_key      ,
-            dict->last_entry,
-            NULL
-        };
-
-        if ( dict->last_entry != NULL) 
-        {
-            dict->last_entry->next_entry = entry;
-        }
+	dict->last_entry = entry;
+	dict->num_entries++;
+	
+	return 0;
+}
 
-        int32_t index = hash;
-        while (dict->entries[index] != NULL)
-        {
-            index++; index %= dict->length; //Wrap around. 
-        }
-    
-        dict->entries[index] = entry;
-        dict->last_entry     = entry;
-        
-        return 0;
-    }
+int32_t findHashIndexN(
+	const dict_s *dict, 
+	const char   *string_key,
+	const size_t  length
+	) {
 	
-	return 1;
+	/**
+     * Find dictionary entry index from a string key view, the key does not
+     * need to be null terminated.
+     * @param 
+	 *     const dict_s  *dict      : Dictionary to find hash for specified 
+     *                                string key.
+     *     const char    *string_key: String key to find hash index from.
+     *     const size_t   length    : Number of characters in key.
+     * @see hashString().
+     * @return int32_t index: Returns hash index if successful, else return -1.
+     */
+	 
+	const uint64_t hash  = hashString(string_key, length);
+	const uint64_t mask  = (uint64_t) (dict->length - 1);
+	      uint64_t index = hash & mask;
+	
+	for (int32_t probe = 0; probe < dict->length; probe++)
+	{
+		CONFIG_STATS_COUNT(probes, 1);
+		
+		const dict_entry_s *entry = dict->entries[index];
+		
+		if (entry == NULL)
+		{
+			break;
+		}
+		else if (
+			   (entry != DICT_TOMBSTONE)
+			&& (entry->hash       == hash  ) 
+			&& (entry->key_length == length) 
+			&& !memcmp(entry->string_key, string_key, length)
+		) {
+			return (int32_t) index;
+		}
+		
+		index = (index + 1) & mask; //Wrap around.
+	}
+	
+	return -1;
 }
 
 int32_t findHashIndex(
@@ -1040,35 +1696,34 @@ int32_t findHashIndex(
 	 *     const dict_s  *dict      : Dictionary to find hash for specified 
      *                                string key.
      *     const char    *string_key: String key to find hash index from.
-     * @see getDictHashCode().
+     * @see findHashIndexN().
      * @return int32_t index: Returns hash index if successful, else return -1.
      */
 	 
-	const int32_t hash = getDictHashCode(dict, string_key);
-    
-    if ((hash >= 0) && (hash < dict->length))
-    {
-              int32_t index = hash;
-
-        const int32_t stop_index = 
-            ((hash - 1) < 0) ? (dict->length - 1) : (hash - 1);
+	return findHashIndexN(dict, string_key, strlen(string_key));
+}
 
-        while (dict->entries[index] != NULL) 
-        {
-            if (!strcmp(dict->entries[index]->string_key, string_key)) 
-            {
-                return index;
-            } 
-            else if (index == stop_index) 
-            {
-                return -1;		
-            }
-
-            index++; index %= dict->length; //Wrap around. 
-        }
-    }
+dict_entry_s *findDictEntryN(
+	const dict_s *dict, 
+	const char   *string_key,
+	const size_t  length
+	) {
 	
-	return -1;
+	/**
+     * Find dictionary entry from a string key view.
+     * @param 
+	 *     const dict_s  *dict      : Dictionary to find entry for specified 
+     *                                string key.
+     *     const char    *string_key: String key to find dictionary entry of.
+     *     const size_t   length    : Number of characters in key.
+     * @see findHashIndexN().
+     * @return dict_entry_s entry: Returns dict entry if successful, else return 
+     *                             NULL.
+     */
+	
+	const int32_t index = findHashIndexN(dict, string_key, length);
+
+	return (index >= 0) ? dict->entries[index] : NULL;
 }
 
 dict_entry_s *findDictEntry_(
@@ -1082,25 +1737,12 @@ dict_entry_s *findDictEntry_(
 	 *     const dict_s  *dict      : Dictionary to find entry for specified 
      *                                string key.
      *     const char    *string_key: String key to find dictionary entry of.
-     * @see findHashIndex().
+     * @see findDictEntryN().
      * @return dict_entry_s entry: Returns dict entry if successful, else return 
      *                             NULL.
      */
 	
-	const int32_t hash  = findHashIndex(dict, string_key);
-    dict_entry_s *entry = NULL;
-
-    if ((hash >= 0) && (hash < dict->length))
-    {
-        const int32_t index = hash;
-        
-        if (index >= 0) 
-        {	
-            entry = dict->entries[index];
-        }
-    }
-
-	return entry;
+	return findDictEntryN(dict, string_key, strlen(string_key));
 }
 
 dict_entry_s *findDictEntry(
@@ -1141,7 +1783,8 @@ void deleteDictEntry(
 	) {
 	
 	/**
-     * Delete dictionary entry at entered string key.
+     * Delete dictionary entry at entered string key. The slot is marked with
+     * a tombstone so later entries in the same probe sequence stay findable.
      * @param 
 	 *     const dict_s  *dict      : Dictionary to find entry for specified 
      *                                string key.
@@ -1150,36 +1793,32 @@ void deleteDictEntry(
      * @return none.
      */
 	
-	const int32_t hash = findHashIndex(dict, string_key);
+	const int32_t index = findHashIndex(dict, string_key);
 	
-    if ((hash >= 0) && (hash < dict->length))
+    if (index >= 0)
     {
-        const int32_t index = hash; 
-
-        if (index >= 0) {
-
-            if (dict->entries[index]->previous_entry != NULL) 
-            {
-                if (dict->entries[index]->next_entry != NULL) 
-                {
-                    dict->entries[index]->previous_entry->next_entry = 
-                        dict->entries[index]->next_entry;
-                    dict->entries[index]->next_entry->previous_entry = 
-                        dict->entries[index]->previous_entry;
-
-                } 
-                else 
-                {
-                    dict->entries[index]->previous_entry->next_entry = NULL;
-                    dict->last_entry = dict->entries[index]->previous_entry;
-                }
-            } 
-
-            dict->num_entries--;
-            free(dict->entries[index]);
-
-            dict->entries[index] = NULL;
+        dict_entry_s *entry = dict->entries[index];
+
+        if (entry->previous_entry != NULL) 
+        {
+            entry->previous_entry->next_entry = entry->next_entry;
+        } 
+
+        if (entry->next_entry != NULL) 
+        {
+            entry->next_entry->previous_entry = entry->previous_entry;
+        } 
+        else 
+        {
+            dict->last_entry = entry->previous_entry;
         }
+
+        dict->entries[index] = DICT_TOMBSTONE;
+        dict->num_entries--;
+        dict->num_tombstones++;
+
+        arenaFree(dict->arena, (char*) entry->string_key);
+        arenaFree(dict->arena, entry);
     }
 }
 
@@ -1232,6 +1871,8 @@ void printDictKeys(
     {
 		printf("%s \n", entries[index]->string_key);	
 	}
+	
+	free(entries);
 }
 
 void freeDictEntry(
@@ -1247,6 +1888,7 @@ void freeDictEntry(
      */
 	
 	freeMultiS(entry->data);
+	free((char*) entry->string_key);
 	free(entry);
 }
 
@@ -1262,6 +1904,12 @@ void freeDictionary(
      * @return none
      */
 	
+	// Arena dictionaries are released with their arena:
+	if (dict->arena != NULL)
+	{
+		return;
+	}
+	
 	dict_entry_s **entries = returnAllEntries(dict);
 	
 	for (int32_t index = 0; index < dict->num_entries; index++) 
@@ -1274,15 +1922,220 @@ void freeDictionary(
 	free(dict);
 }
 
+typedef struct PerfectHash {
+
+	/**
+     * Structure to hold a minimal perfect hash of a fixed set of keys, as
+	 * emitted by src/perfect_hash_generator.c. A key hashes to one bucket,
+	 * the bucket displacement sends it to exactly one slot, and a single
+	 * compare against that slot decides the lookup.
+     */
+
+	int32_t         num_keys;
+	int32_t         num_buckets;
+
+	// Hash of the key set in index order, see getPerfectHashFingerprint():
+	uint64_t        fingerprint;
+
+	const uint32_t *displacements;
+
+	// Per slot:
+	const char    **slot_keys;
+	const uint32_t *slot_lengths;
+	const int32_t  *slot_indices;
+
+	// Keys in index order:
+	const char    **keys;
+
+} perfect_hash_s;
+
+#define PERFECT_HASH_MIX        0x9e3779b97f4a7c15ull
+#define PERFECT_HASH_MAX_TABLES 256
+
+static const perfect_hash_s *perfect_hash_registry[PERFECT_HASH_MAX_TABLES];
+static int32_t               num_perfect_hashes = 0;
+
+static inline uint32_t getPerfectHashBucket(
+	const uint64_t hash,
+	const int32_t  num_buckets
+	) {
+	
+	return (uint32_t) (((hash >> 32) * (uint64_t) num_buckets) >> 32);
+}
+
+static inline uint32_t getPerfectHashSlot(
+	const uint64_t hash,
+	const uint32_t displacement,
+	const int32_t  num_keys
+	) {
+	
+	return (uint32_t) 
+		(mixHash(hash ^ displacement, PERFECT_HASH_MIX) % (uint64_t) num_keys);
+}
+
+static inline int32_t findPerfectHashIndex(
+	const perfect_hash_s *table,
+	const char           *key,
+	const size_t          length
+	) {
+	
+	/**
+     * Look a key view up in a perfect hash, one hash and one compare.
+     * @param 
+	 *     const perfect_hash_s *table : table to search.
+	 *     const char           *key   : key, need not be null terminated.
+	 *     const size_t          length: number of characters in key.
+     * @see getMapIndexN().
+     * @return int32_t index: index of key, -1 if it is not in the table.
+     */
+	
+	CONFIG_STATS_COUNT(probes, 1);
+	
+	const uint64_t hash = hashString(key, length);
+	const uint32_t slot = 
+		getPerfectHashSlot(
+			hash, 
+			table->displacements[
+				getPerfectHashBucket(hash, table->num_buckets)
+			],
+			table->num_keys
+		);
+	
+	return ((table->slot_lengths[slot] == length) 
+		&& (memcmp(table->slot_keys[slot], key, length) == 0))
+		? table->slot_indices[slot] 
+		: -1;
+}
+
+bool getPerfectHashFingerprint(
+	      char    **keys,
+	const int32_t   num_keys,
+	      uint64_t *ret_fingerprint
+	) {
+	
+	/**
+     * Hash a key set in order, so a map can find the generated table built 
+	 * for the same keys. 
+     * @param 
+	 *           char    **keys           : keys in index order.
+	 *     const int32_t   num_keys       : number of keys.
+	 *           uint64_t *ret_fingerprint: hash of the key set.
+     * @see findPerfectHash().
+     * @return bool valid: false if a key is NULL.
+     */
+	
+	uint64_t fingerprint = (uint64_t) num_keys;
+	for (int32_t index = 0; index < num_keys; index++)
+	{
+		if (keys[index] == NULL)
+		{
+			return false;
+		}
+		
+		fingerprint = 
+			mixHash(
+				fingerprint ^ hashString(keys[index], strlen(keys[index])), 
+				PERFECT_HASH_MIX
+			);
+	}
+	*ret_fingerprint = fingerprint;
+	
+	return true;
+}
+
+void registerPerfectHashes(
+	const perfect_hash_s *tables,
+	const int32_t         num_tables
+	) {
+	
+	/**
+     * Make generated tables available to createMapArena(). Generated headers 
+	 * call this before main, so including one is enough to use it.
+     * @param 
+	 *     const perfect_hash_s *tables    : tables to register.
+	 *     const int32_t         num_tables: number of tables.
+     * @see findPerfectHash().
+     * @return none
+     */
+	
+	for (int32_t index = 0; index < num_tables; index++)
+	{
+		if (num_perfect_hashes == PERFECT_HASH_MAX_TABLES)
+		{
+			fprintf(
+				stderr, 
+				"registerPerfectHashes: \nWarning! Registry full, %i tables"
+				" left to the dynamic map.\n", 
+				num_tables - index
+			);
+			return;
+		}
+		perfect_hash_registry[num_perfect_hashes++] = &tables[index];
+	}
+}
+
+const perfect_hash_s *findPerfectHash(
+	      char    **keys,
+	const int32_t   num_keys
+	) {
+	
+	/**
+     * Find a registered table for exactly this key set. Every key is looked 
+	 * up once, so a table generated from an older schema is never used.
+     * @param 
+	 *           char    **keys    : keys in index order.
+	 *     const int32_t   num_keys: number of keys.
+     * @see registerPerfectHashes(), createMapArena().
+     * @return const perfect_hash_s *table: matching table, NULL if none.
+     */
+	
+	uint64_t fingerprint;
+	if ((num_keys == 0) 
+		|| !getPerfectHashFingerprint(keys, num_keys, &fingerprint))
+	{
+		return NULL;
+	}
+	
+	for (int32_t table = 0; table < num_perfect_hashes; table++)
+	{
+		const perfect_hash_s *candidate = perfect_hash_registry[table];
+		
+		if ((candidate->num_keys    != num_keys) 
+			|| (candidate->fingerprint != fingerprint))
+		{
+			continue;
+		}
+		
+		bool match = true;
+		for (int32_t index = 0; (index < num_keys) && match; index++)
+		{
+			match = 
+				(findPerfectHashIndex(
+					candidate, keys[index], strlen(keys[index])
+				) == index);
+		}
+		
+		if (match)
+		{
+			return candidate;
+		}
+	}
+	
+	return NULL;
+}
+
 typedef struct Mapping {
 
 	/**
      * Structure to hold map to convert string to index.
      */
     
-    dict_s   *dict;
-    char    **keys;    
-    int32_t   length;
+    dict_s               *dict;
+    char                **keys;    
+    int32_t               length;
+    
+    // Generated table for the same keys, used instead of dict if set:
+    const perfect_hash_s *perfect;
 } map_s;
 
 typedef struct Map_Pairing {
@@ -1296,29 +2149,45 @@ typedef struct Map_Pairing {
     map_s    map;
 } map_pair_s;
 
-map_s createMap(
+map_s createMapArena(
           char    **keys    , 
-    const int32_t   num_keys
+    const int32_t   num_keys,
+          arena_s  *arena
     ) {
 	
 	/**
-     * Create map between array of strings and array of ints
+     * Create map between array of strings and array of ints. If a generated 
+	 * perfect hash is registered for the same keys it is used, otherwise a 
+	 * dictionary is built.
      * @param 
 	 *           char    ** keys    : Strings to map.
 	 *     const int32_t    num_keys: Number of strings to map.
-     * @see makeDictionary(), insertDictEntry().
+	 *           arena_s   *arena   : arena to allocate from, or NULL.
+     * @see findPerfectHash(), makeDictionaryArena(), insertDictEntry().
      * @return map_s map: map between keys and index.
      */
 	    
     map_s map;
-    map.dict = makeDictionary(10*num_keys);
+    map.perfect = findPerfectHash(keys, num_keys);
+    
+    // Static schemas need no dictionary, nor copies of the keys:
+    if (map.perfect != NULL)
+    {
+        map.dict   = NULL;
+        map.keys   = (char**) map.perfect->keys;
+        map.length = num_keys;
+        
+        return map;
+    }
     
-	map.keys = malloc(sizeof(char*) * (size_t) num_keys);
+    map.dict = makeDictionaryArena(num_keys, arena);
+    
+	map.keys = arenaAlloc(arena, sizeof(char*) * (size_t) num_keys);
     for (int32_t index = 0; index < num_keys; index++) 
     {
-        const multi_s data = (multi_s) {*((multi_u*)(&index)), int_e, 1, NULL};
+        const multi_s data = (multi_s) {{.i = index}, int_e, 1, NULL};
         insertDictEntry(map.dict, data, keys[index]);
-		map.keys[index] = strdup(keys[index]);
+		map.keys[index] = arenaStrdup(arena, keys[index]);
 	}   
     
 	map.length = num_keys;
@@ -1326,6 +2195,23 @@ map_s createMap(
     return map;
 }
 
+map_s createMap(
+          char    **keys    , 
+    const int32_t   num_keys
+    ) {
+	
+	/**
+     * Create map between array of strings and array of ints
+     * @param 
+	 *           char    ** keys    : Strings to map.
+	 *     const int32_t    num_keys: Number of strings to map.
+     * @see createMapArena().
+     * @return map_s map: map between keys and index.
+     */
+	
+	return createMapArena(keys, num_keys, NULL);
+}
+
 int32_t getMapIndex(
         const map_s   map, 
         const char   *key
@@ -1340,6 +2226,11 @@ int32_t getMapIndex(
      * @return int32_t index: Index corresponding to inputted key.
      */
 	
+	if (map.perfect != NULL)
+	{
+		return findPerfectHashIndex(map.perfect, key, strlen(key));
+	}
+	
 	int32_t index = -1;
 	
 	dict_entry_s *entry = 
@@ -1357,6 +2248,33 @@ int32_t getMapIndex(
     return index;
 }
 
+int32_t getMapIndexN(
+        const map_s   map, 
+        const char   *key,
+        const size_t  length
+    ) {
+	
+	/**
+     * Return index of a key view in map, the key does not need to be null 
+     * terminated.
+     * @param 
+	 *     const map_s   map   : Key to index map.
+	 *     const char   *key   : String to find index of in map.
+	 *     const size_t  length: Number of characters in key.
+     * @see findDictEntryN(), createMap().
+     * @return int32_t index: Index corresponding to inputted key.
+     */
+	
+	if (map.perfect != NULL)
+	{
+		return findPerfectHashIndex(map.perfect, key, length);
+	}
+	
+	const dict_entry_s *entry = findDictEntryN(map.dict, key, length);
+	
+    return (entry != NULL) ? entry->data.value.i : -1;
+}
+
 char *getMapKey(
     const map_s   map,
     const int32_t index
@@ -1383,5 +2301,34 @@ char *getMapKey(
     
     return key;
 }
+
+void freeMap(
+    map_s map
+    ) {
+	
+	/**
+     * Deallocate all memory assigned to map.
+     * @param 
+	 *     map_s map: Key to index map to deallocate.
+     * @see freeDictionary(), createMap().
+     * @return none
+     */
+	
+	if ((map.dict == NULL) || (map.dict->arena != NULL))
+	{
+		return;
+	}
+	
+	freeDictionary(map.dict);
+	
+	if (map.keys != NULL)
+	{
+		for (int32_t index = 0; index < map.length; index++)
+		{
+			free(map.keys[index]);
+		}
+		free(map.keys);
+	}
+}
     
 #endif
\ No newline at end of file
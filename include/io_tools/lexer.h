@@ -0,0 +1,523 @@
+#ifndef IO_LEXER_H
+#define IO_LEXER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <inttypes.h>
+
+#include "io_tools/structures.h"
+
+typedef enum CharClass {
+
+	/**
+     * Enum to hold the syntactic class of a single config file character.
+     */
+
+	char_other_e,
+	char_space_e,
+	char_line_break_e,
+	char_comment_e,
+	char_new_line_e,
+	char_value_indicator_e,
+	char_start_config_e,
+	char_end_config_e,
+	char_string_separator_e,
+	char_char_separator_e,
+	char_start_name_e,
+	char_end_name_e,
+	char_start_array_e,
+	char_end_array_e
+} char_class_e;
+
+typedef enum TokenType {
+
+	/**
+     * Enum to hold the type of a lexed config token.
+     */
+
+	token_none_e,
+	token_open_config_e,
+	token_close_config_e,
+	token_name_e,
+	token_identifier_e,
+	token_value_indicator_e,
+	token_value_e,
+	token_string_e,
+	token_char_e,
+	token_array_e,
+	token_new_line_e,
+	token_comment_e
+} token_e;
+
+typedef struct Token {
+
+	/**
+     * Structure to hold a single token. The token does not own its text,
+     * start points into the lexed buffer and length counts the characters
+     * between any enclosing separators.
+     */
+
+	const char *start;
+	size_t      length;
+	int32_t     line;
+	token_e     type;
+
+} token_s;
+
+typedef struct ScratchBuffer {
+
+	/**
+     * Structure to hold a reusable buffer for null terminated token copies.
+     */
+
+	char   *data;
+	size_t  length;
+
+} scratch_s;
+
+typedef struct TokenStream {
+
+	/**
+     * Structure to hold the token stream of a config buffer, along with the
+     * cursor the parser consumes it with.
+     */
+
+	const char *buffer;
+	size_t      buffer_length;
+
+	token_s    *tokens;
+	int32_t     num_tokens;
+	int32_t     index;
+
+	scratch_s   name_scratch;
+	scratch_s   value_scratch;
+
+} token_stream_s;
+
+typedef struct CharClassTable {
+
+	/**
+     * Structure to hold the character class of every possible byte value.
+     */
+
+	uint8_t classes[256];
+
+} char_class_table_s;
+
+void setCharClasses(
+	      char_class_table_s *table,
+	const char               *characters,
+	const char_class_e        char_class
+	) {
+
+	/**
+     * Assign a character class to every character in a syntax string.
+     * @param
+     *           char_class_table_s *table     : table to update.
+     *     const char               *characters: syntax characters, may be NULL.
+     *     const char_class_e        char_class: class to assign.
+     * @see createCharClassTable().
+     * @return none
+     */
+
+	if (characters == NULL)
+	{
+		return;
+	}
+
+	for (size_t index = 0; characters[index] != '\0'; index++)
+	{
+		table->classes[(uint8_t) characters[index]] = (uint8_t) char_class;
+	}
+}
+
+char_class_table_s createCharClassTable(
+	const loader_syntax_s syntax
+	) {
+
+	/**
+     * Build the 256 entry character class table for the entered syntax, so
+     * the lexer can classify each byte with a single lookup.
+     * @param
+     *     const loader_syntax_s syntax: syntax to build the table from.
+     * @see setCharClasses().
+     * @return char_class_table_s table: completed character class table.
+     */
+
+	char_class_table_s table;
+	memset(table.classes, char_other_e, sizeof(table.classes));
+
+	for (int32_t index = 0; index < 256; index++)
+	{
+		if (isspace(index))
+		{
+			table.classes[index] = char_space_e;
+		}
+	}
+
+	table.classes['\n'] = char_line_break_e;
+	table.classes['\0'] = char_space_e;
+
+	setCharClasses(&table, syntax.comment         , char_comment_e         );
+	setCharClasses(&table, syntax.new_line        , char_new_line_e        );
+	setCharClasses(&table, syntax.value_indicator , char_value_indicator_e );
+	setCharClasses(&table, syntax.start_config    , char_start_config_e    );
+	setCharClasses(&table, syntax.end_config      , char_end_config_e      );
+	setCharClasses(&table, syntax.string_separator, char_string_separator_e);
+	setCharClasses(&table, syntax.char_separator  , char_char_separator_e  );
+	setCharClasses(&table, syntax.start_name      , char_start_name_e      );
+	setCharClasses(&table, syntax.end_name        , char_end_name_e        );
+	setCharClasses(&table, syntax.start_array     , char_start_array_e     );
+	setCharClasses(&table, syntax.end_array       , char_end_array_e       );
+
+	return table;
+}
+
+void pushToken(
+	      token_stream_s *stream,
+	      int32_t        *max_num_tokens,
+	const token_e         type,
+	const char           *start,
+	const size_t          length,
+	const int32_t         line
+	) {
+
+	if (stream->num_tokens >= *max_num_tokens)
+	{
+		*max_num_tokens *= 2;
+		stream->tokens =
+			realloc(
+				stream->tokens,
+				sizeof(token_s) * (size_t) *max_num_tokens
+			);
+	}
+
+	stream->tokens[stream->num_tokens] =
+		(token_s) {start, length, line, type};
+	stream->num_tokens++;
+}
+
+size_t findClassInLine(
+	const char               *buffer,
+	const size_t              buffer_length,
+	      size_t              position,
+	const char_class_table_s *table,
+	const char_class_e        char_class
+	) {
+
+	/**
+     * Find the next character of char_class before the end of the line.
+     * @return size_t position: position of the character, or of the line
+     *                          break or buffer end if not found.
+     */
+
+	while (position < buffer_length)
+	{
+		const uint8_t current = table->classes[(uint8_t) buffer[position]];
+
+		if ((current == char_class) || (current == char_line_break_e))
+		{
+			break;
+		}
+		position++;
+	}
+
+	return position;
+}
+
+token_stream_s tokeniseBuffer(
+	const char               *buffer,
+	const size_t              buffer_length,
+	const char_class_table_s *table
+	) {
+
+	/**
+     * Convert a config buffer into a token stream in a single pass. Values
+     * end at the new_line syntax character or the end of the line, an
+     * implicit token_new_line_e with zero length is emitted for the latter.
+     * @param
+     *     const char               *buffer       : config text to lex, does
+     *                                              not need to be null
+     *                                              terminated.
+     *     const size_t              buffer_length: length of buffer.
+     *     const char_class_table_s *table        : character classes built
+     *                                              from the loader syntax.
+     * @see createCharClassTable(), freeTokenStream().
+     * @return token_stream_s stream: token stream with cursor at the start.
+     *                                Caller must free with freeTokenStream().
+     */
+
+	token_stream_s stream =
+	{
+		.buffer         = buffer,
+		.buffer_length  = buffer_length,
+		.tokens         = NULL,
+		.num_tokens     = 0,
+		.index          = 0,
+		.name_scratch   = {NULL, 0},
+		.value_scratch  = {NULL, 0}
+	};
+
+	// Rough guess of one token per eight bytes, grown on demand:
+	int32_t max_num_tokens = (int32_t) (buffer_length / 8) + 16;
+	stream.tokens = malloc(sizeof(token_s) * (size_t) max_num_tokens);
+
+	bool    in_value = false;
+	int32_t line     = 1;
+	size_t  position = 0;
+
+	while (position < buffer_length)
+	{
+		const char   *current    = &buffer[position];
+		const uint8_t char_class = table->classes[(uint8_t) *current];
+
+		switch (char_class)
+		{
+			case (char_space_e):
+				position++;
+			break;
+
+			case (char_line_break_e):
+				if (in_value)
+				{
+					pushToken(
+						&stream, &max_num_tokens, token_new_line_e, current, 0,
+						line
+					);
+					in_value = false;
+				}
+				line++;
+				position++;
+			break;
+
+			case (char_comment_e):
+			{
+				const size_t end =
+					findClassInLine(
+						buffer, buffer_length, position, table,
+						char_line_break_e
+					);
+				pushToken(
+					&stream, &max_num_tokens, token_comment_e, current,
+					end - position, line
+				);
+				position = end;
+			}
+			break;
+
+			case (char_new_line_e):
+				pushToken(
+					&stream, &max_num_tokens, token_new_line_e, current, 1,
+					line
+				);
+				in_value = false;
+				position++;
+			break;
+
+			case (char_value_indicator_e):
+				pushToken(
+					&stream, &max_num_tokens, token_value_indicator_e, current,
+					1, line
+				);
+				in_value = true;
+				position++;
+			break;
+
+			case (char_start_config_e):
+				pushToken(
+					&stream, &max_num_tokens, token_open_config_e, current, 1,
+					line
+				);
+				in_value = false;
+				position++;
+			break;
+
+			case (char_end_config_e):
+				pushToken(
+					&stream, &max_num_tokens, token_close_config_e, current, 1,
+					line
+				);
+				in_value = false;
+				position++;
+			break;
+
+			case (char_start_name_e):
+			case (char_string_separator_e):
+			case (char_char_separator_e):
+			case (char_start_array_e):
+			{
+				char_class_e close_class = char_end_name_e;
+				token_e      type        = token_name_e;
+
+				if (char_class == char_string_separator_e)
+				{
+					close_class = char_string_separator_e;
+					type        = token_string_e;
+				}
+				else if (char_class == char_char_separator_e)
+				{
+					close_class = char_char_separator_e;
+					type        = token_char_e;
+				}
+				else if (char_class == char_start_array_e)
+				{
+					close_class = char_end_array_e;
+					type        = token_array_e;
+				}
+
+				const size_t end =
+					findClassInLine(
+						buffer, buffer_length, position + 1, table, close_class
+					);
+				pushToken(
+					&stream, &max_num_tokens, type, &current[1],
+					end - position - 1, line
+				);
+
+				// Step over closing character but leave line breaks for the
+				// next iteration:
+				position =
+					(   (end < buffer_length)
+					 && (table->classes[(uint8_t) buffer[end]] == close_class)
+					) ? end + 1 : end;
+			}
+			break;
+
+			default:
+			{
+				size_t end = position + 1;
+				while (
+					   (end < buffer_length)
+					&& (table->classes[(uint8_t) buffer[end]] == char_other_e)
+				) {
+					end++;
+				}
+
+				pushToken(
+					&stream,
+					&max_num_tokens,
+					in_value ? token_value_e : token_identifier_e,
+					current,
+					end - position,
+					line
+				);
+				position = end;
+			}
+			break;
+		}
+	}
+
+	if (in_value)
+	{
+		pushToken(
+			&stream, &max_num_tokens, token_new_line_e, &buffer[buffer_length],
+			0, line
+		);
+	}
+
+	return stream;
+}
+
+const char *copyTokenText(
+	      scratch_s *scratch,
+	const char      *start,
+	const size_t     length,
+	const bool       remove_space,
+	const char      *remove
+	) {
+
+	/**
+     * Copy token text into a reusable scratch buffer, so it can be passed on
+     * as a null terminated string without a fresh allocation.
+     * @param
+     *           scratch_s *scratch     : scratch buffer to copy into.
+     *     const char      *start       : start of text to copy.
+     *     const size_t     length      : number of characters to copy.
+     *     const bool       remove_space: skip whitespace characters.
+     *     const char      *remove      : other characters to skip, may be
+     *                                    NULL.
+     * @see freeTokenStream().
+     * @return const char *text: null terminated copy, valid until the next
+     *                           call with the same scratch buffer.
+     */
+
+	if (length + 1 > scratch->length)
+	{
+		scratch->length = 2*length + 1;
+		scratch->data   = realloc(scratch->data, scratch->length);
+	}
+
+	size_t copy_index = 0;
+	for (size_t index = 0; index < length; index++)
+	{
+		const char current = start[index];
+
+		if (   (remove_space && isspace((unsigned char) current))
+			|| ((remove != NULL) && (current != '\0') && strchr(remove, current))
+		) {
+			continue;
+		}
+
+		scratch->data[copy_index] = current;
+		copy_index++;
+	}
+	scratch->data[copy_index] = '\0';
+
+	return scratch->data;
+}
+
+size_t getTokenLineEnd(
+	const token_stream_s *stream,
+	const int32_t         token_index
+	) {
+
+	/**
+     * Return the buffer offset just after the line holding the entered token.
+     */
+
+	size_t position = stream->buffer_length;
+
+	if ((token_index >= 0) && (token_index < stream->num_tokens))
+	{
+		position =
+			(size_t) (stream->tokens[token_index].start - stream->buffer);
+
+		while (
+			   (position < stream->buffer_length)
+			&& (stream->buffer[position] != '\n')
+		) {
+			position++;
+		}
+
+		if (position < stream->buffer_length)
+		{
+			position++;
+		}
+	}
+
+	return position;
+}
+
+void freeTokenStream(
+	token_stream_s *stream
+	) {
+
+	if (stream->tokens != NULL)
+	{
+		free(stream->tokens);
+		stream->tokens = NULL;
+	}
+
+	free(stream->name_scratch.data);
+	free(stream->value_scratch.data);
+
+	stream->name_scratch  = (scratch_s) {NULL, 0};
+	stream->value_scratch = (scratch_s) {NULL, 0};
+	stream->num_tokens    = 0;
+}
+
+#endif
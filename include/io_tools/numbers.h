@@ -0,0 +1,1077 @@
+#ifndef IO_NUMBERS_H
+#define IO_NUMBERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include <inttypes.h>
+
+#define NUMBER_MAX_DIGITS         19
+#define NUMBER_MIN_POWER_OF_TEN  -65
+#define NUMBER_MAX_POWER_OF_TEN   38
+
+typedef enum NumberStatus {
+
+	/**
+     * Enum to hold the outcome of parsing a number from text.
+     */
+
+	number_ok_e,
+	number_empty_e,
+	number_trailing_e,
+	number_range_e
+} number_status_e;
+
+// 128 bit truncated powers of five, 5^-65 to 5^38, most significant bit 
+// set, for Eisel-Lemire float conversion:
+static const uint64_t number_powers_of_five[][2] =
+{
+	{0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL}, // 5^-65
+	{0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL}, // 5^-64
+	{0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL}, // 5^-63
+	{0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL}, // 5^-62
+	{0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL}, // 5^-61
+	{0xCDB02555653131B6ULL, 0x3792F412CB06794DULL}, // 5^-60
+	{0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL}, // 5^-59
+	{0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL}, // 5^-58
+	{0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL}, // 5^-57
+	{0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL}, // 5^-56
+	{0x9CED737BB6C4183DULL, 0x55464DD69685606BULL}, // 5^-55
+	{0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL}, // 5^-54
+	{0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL}, // 5^-53
+	{0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL}, // 5^-52
+	{0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL}, // 5^-51
+	{0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL}, // 5^-50
+	{0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL}, // 5^-49
+	{0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL}, // 5^-48
+	{0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL}, // 5^-47
+	{0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL}, // 5^-46
+	{0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL}, // 5^-45
+	{0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL}, // 5^-44
+	{0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL}, // 5^-43
+	{0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL}, // 5^-42
+	{0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL}, // 5^-41
+	{0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL}, // 5^-40
+	{0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL}, // 5^-39
+	{0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL}, // 5^-38
+	{0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL}, // 5^-37
+	{0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL}, // 5^-36
+	{0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL}, // 5^-35
+	{0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL}, // 5^-34
+	{0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL}, // 5^-33
+	{0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL}, // 5^-32
+	{0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL}, // 5^-31
+	{0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL}, // 5^-30
+	{0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL}, // 5^-29
+	{0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL}, // 5^-28
+	{0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL}, // 5^-27
+	{0xC612062576589DDAULL, 0x95364AFE032A819EULL}, // 5^-26
+	{0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL}, // 5^-25
+	{0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL}, // 5^-24
+	{0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL}, // 5^-23
+	{0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL}, // 5^-22
+	{0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL}, // 5^-21
+	{0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL}, // 5^-20
+	{0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL}, // 5^-19
+	{0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL}, // 5^-18
+	{0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL}, // 5^-17
+	{0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL}, // 5^-16
+	{0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL}, // 5^-15
+	{0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL}, // 5^-14
+	{0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL}, // 5^-13
+	{0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL}, // 5^-12
+	{0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL}, // 5^-11
+	{0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL}, // 5^-10
+	{0x89705F4136B4A597ULL, 0x31680A88F8953031ULL}, // 5^-9
+	{0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL}, // 5^-8
+	{0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL}, // 5^-7
+	{0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL}, // 5^-6
+	{0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL}, // 5^-5
+	{0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL}, // 5^-4
+	{0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL}, // 5^-3
+	{0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL}, // 5^-2
+	{0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL}, // 5^-1
+	{0x8000000000000000ULL, 0x0000000000000000ULL}, // 5^0
+	{0xA000000000000000ULL, 0x0000000000000000ULL}, // 5^1
+	{0xC800000000000000ULL, 0x0000000000000000ULL}, // 5^2
+	{0xFA00000000000000ULL, 0x0000000000000000ULL}, // 5^3
+	{0x9C40000000000000ULL, 0x0000000000000000ULL}, // 5^4
+	{0xC350000000000000ULL, 0x0000000000000000ULL}, // 5^5
+	{0xF424000000000000ULL, 0x0000000000000000ULL}, // 5^6
+	{0x9896800000000000ULL, 0x0000000000000000ULL}, // 5^7
+	{0xBEBC200000000000ULL, 0x0000000000000000ULL}, // 5^8
+	{0xEE6B280000000000ULL, 0x0000000000000000ULL}, // 5^9
+	{0x9502F90000000000ULL, 0x0000000000000000ULL}, // 5^10
+	{0xBA43B74000000000ULL, 0x0000000000000000ULL}, // 5^11
+	{0xE8D4A51000000000ULL, 0x0000000000000000ULL}, // 5^12
+	{0x9184E72A00000000ULL, 0x0000000000000000ULL}, // 5^13
+	{0xB5E620F480000000ULL, 0x0000000000000000ULL}, // 5^14
+	{0xE35FA931A0000000ULL, 0x0000000000000000ULL}, // 5^15
+	{0x8E1BC9BF04000000ULL, 0x0000000000000000ULL}, // 5^16
+	{0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL}, // 5^17
+	{0xDE0B6B3A76400000ULL, 0x0000000000000000ULL}, // 5^18
+	{0x8AC7230489E80000ULL, 0x0000000000000000ULL}, // 5^19
+	{0xAD78EBC5AC620000ULL, 0x0000000000000000ULL}, // 5^20
+	{0xD8D726B7177A8000ULL, 0x0000000000000000ULL}, // 5^21
+	{0x878678326EAC9000ULL, 0x0000000000000000ULL}, // 5^22
+	{0xA968163F0A57B400ULL, 0x0000000000000000ULL}, // 5^23
+	{0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL}, // 5^24
+	{0x84595161401484A0ULL, 0x0000000000000000ULL}, // 5^25
+	{0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL}, // 5^26
+	{0xCECB8F27F4200F3AULL, 0x0000000000000000ULL}, // 5^27
+	{0x813F3978F8940984ULL, 0x4000000000000000ULL}, // 5^28
+	{0xA18F07D736B90BE5ULL, 0x5000000000000000ULL}, // 5^29
+	{0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL}, // 5^30
+	{0xFC6F7C4045812296ULL, 0x4D00000000000000ULL}, // 5^31
+	{0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL}, // 5^32
+	{0xC5371912364CE305ULL, 0x6C28000000000000ULL}, // 5^33
+	{0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL}, // 5^34
+	{0x9A130B963A6C115CULL, 0x3C7F400000000000ULL}, // 5^35
+	{0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL}, // 5^36
+	{0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL}, // 5^37
+	{0x96769950B50D88F4ULL, 0x1314448000000000ULL}, // 5^38
+};
+
+static const float number_exact_powers_of_ten[] =
+{
+	1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+const char *numberStatusToString(
+	const number_status_e status
+	) {
+
+	const char *string = "unknown";
+
+	switch (status)
+	{
+		case (number_ok_e      ): string = "ok"                 ; break;
+		case (number_empty_e   ): string = "no digits"          ; break;
+		case (number_trailing_e): string = "trailing characters"; break;
+		case (number_range_e   ): string = "out of range"       ; break;
+	}
+
+	return string;
+}
+
+static inline bool isNumberSpace(
+	const char character
+	) {
+
+	return (character == ' ') || ((character >= '\t') && (character <= '\r'));
+}
+
+static inline bool isNumberDigit(
+	const char character
+	) {
+
+	return (unsigned char) (character - '0') < 10;
+}
+
+static inline bool isEightDigits(
+	const uint64_t value
+	) {
+
+	return !(
+		(   (value + 0x4646464646464646ULL) 
+		  | (value - 0x3030303030303030ULL)
+		) & 0x8080808080808080ULL
+	);
+}
+
+static inline uint32_t parseEightDigits(
+	      uint64_t value
+	) {
+
+	/**
+     * Convert eight ASCII digits, loaded little endian, to their value with
+	 * three multiplies instead of eight.
+     */
+
+	const uint64_t mask = 0x000000FF000000FFULL;
+	const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+	const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+
+	value -= 0x3030303030303030ULL;
+	value  = (value * 10) + (value >> 8);
+	value  = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+
+	return (uint32_t) value;
+}
+
+static inline const char *parseDigits(
+	const char     *position,
+	const char     *end,
+	      uint64_t *value,
+	      int32_t  *num_digits,
+	const int32_t   max_digits
+	) {
+
+	/**
+     * Accumulate decimal digits into value while fewer than max_digits have
+	 * been taken, eight at a time where possible.
+     * @return const char *position: first character not consumed.
+     */
+
+	#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	while ((end - position >= 8) && (*num_digits + 8 <= max_digits))
+	{
+		uint64_t chunk;
+		memcpy(&chunk, position, sizeof(chunk));
+
+		if (!isEightDigits(chunk))
+		{
+			break;
+		}
+
+		*value       = *value * 100000000ULL + parseEightDigits(chunk);
+		*num_digits += 8;
+		position    += 8;
+	}
+	#endif
+
+	while (
+		   (position < end) 
+		&& isNumberDigit(*position) 
+		&& (*num_digits < max_digits)
+	) {
+		*value = *value * 10 + (uint64_t) (*position - '0');
+		(*num_digits)++;
+		position++;
+	}
+
+	return position;
+}
+
+static inline number_status_e finishNumber(
+	const char  *position,
+	const char  *end,
+	const char **ret_end
+	) {
+
+	/**
+     * Step over trailing whitespace, and report anything else left behind.
+     */
+
+	if (ret_end != NULL)
+	{
+		*ret_end = position;
+	}
+
+	while ((position < end) && isNumberSpace(*position))
+	{
+		position++;
+	}
+
+	return (position < end) ? number_trailing_e : number_ok_e;
+}
+
+number_status_e parseInt32Number(
+	const char     *string,
+	const char     *end,
+	      int32_t  *ret_value,
+	const char    **ret_end
+	) {
+
+	/**
+     * Parse a decimal integer, without locale lookups or allocation.
+     * @param
+     *     const char     *string   : text to parse.
+     *     const char     *end      : end of text, or NULL if null terminated.
+     *           int32_t  *ret_value: parsed value, clamped if out of range.
+     *     const char    **ret_end  : first character after the number, may 
+	 *                                be NULL.
+     * @see parseFloatNumber().
+     * @return number_status_e status: number_ok_e if the whole text, bar 
+	 *                                 whitespace, was a number.
+     */
+
+	if (end == NULL)
+	{
+		end = string + strlen(string);
+	}
+
+	const char *position = string;
+	while ((position < end) && isNumberSpace(*position))
+	{
+		position++;
+	}
+
+	bool negative = false;
+	if ((position < end) && ((*position == '-') || (*position == '+')))
+	{
+		negative = (*position == '-');
+		position++;
+	}
+
+	const char *digits_start = position;
+	while ((position < end) && (*position == '0'))
+	{
+		position++;
+	}
+
+	uint64_t value      = 0;
+	int32_t  num_digits = 0;
+	position = parseDigits(position, end, &value, &num_digits, 11);
+
+	*ret_value = 0;
+
+	if (position == digits_start)
+	{
+		if (ret_end != NULL)
+		{
+			*ret_end = string;
+		}
+		return number_empty_e;
+	}
+
+	const uint64_t limit = negative ? (uint64_t) INT32_MAX + 1 : INT32_MAX;
+	if ((value > limit) || ((position < end) && isNumberDigit(*position)))
+	{
+		while ((position < end) && isNumberDigit(*position))
+		{
+			position++;
+		}
+		*ret_value = negative ? INT32_MIN : INT32_MAX;
+		finishNumber(position, end, ret_end);
+
+		return number_range_e;
+	}
+
+	*ret_value = negative ? (int32_t) (0 - value) : (int32_t) value;
+
+	return finishNumber(position, end, ret_end);
+}
+
+static inline uint64_t multiplyHigh128(
+	const uint64_t  a,
+	const uint64_t  b,
+	      uint64_t *low
+	) {
+
+	const __uint128_t product = (__uint128_t) a * b;
+	*low = (uint64_t) product;
+
+	return (uint64_t) (product >> 64);
+}
+
+uint32_t computeFloatBits(
+	const int64_t  power_of_ten,
+	      uint64_t mantissa
+	) {
+
+	/**
+     * Eisel-Lemire conversion of mantissa * 10^power_of_ten to the bits of
+	 * the nearest float, using a 128 bit product with a truncated power of 
+	 * five. mantissa must be non zero.
+     * @return uint32_t bits: float bits without sign.
+     */
+
+	const int32_t mantissa_bits    = 23;
+	const int32_t minimum_exponent = -127;
+	const int32_t infinite_power   = 0xFF;
+
+	if (power_of_ten < NUMBER_MIN_POWER_OF_TEN)
+	{
+		return 0;
+	}
+	if (power_of_ten > NUMBER_MAX_POWER_OF_TEN)
+	{
+		return (uint32_t) infinite_power << mantissa_bits;
+	}
+
+	const int32_t leading_zeros = __builtin_clzll(mantissa);
+	mantissa <<= leading_zeros;
+
+	const uint64_t *power = 
+		number_powers_of_five[power_of_ten - NUMBER_MIN_POWER_OF_TEN];
+
+	uint64_t low;
+	uint64_t high = multiplyHigh128(mantissa, power[0], &low);
+
+	// Only look at the second word when the first leaves the result unclear:
+	const uint64_t precision_mask = UINT64_MAX >> (mantissa_bits + 3);
+	if ((high & precision_mask) == precision_mask)
+	{
+		uint64_t second_low;
+		const uint64_t second_high = 
+			multiplyHigh128(mantissa, power[1], &second_low);
+
+		low += second_high;
+		if (second_high > low)
+		{
+			high++;
+		}
+	}
+
+	const int32_t upper_bit = (int32_t) (high >> 63);
+	const int32_t shift     = upper_bit + 64 - mantissa_bits - 3;
+
+	uint64_t result = high >> shift;
+	int32_t  power2 = 
+		(int32_t) ((((152170 + 65536) * power_of_ten) >> 16) + 63)
+		+ upper_bit - leading_zeros - minimum_exponent;
+
+	// Subnormal:
+	if (power2 <= 0)
+	{
+		if (-power2 + 1 >= 64)
+		{
+			return 0;
+		}
+		result >>= -power2 + 1;
+		result  += (result & 1);
+		result >>= 1;
+		power2   = (result < ((uint64_t) 1 << mantissa_bits)) ? 0 : 1;
+
+		return ((uint32_t) power2 << mantissa_bits) 
+			| (uint32_t) (result & (((uint64_t) 1 << mantissa_bits) - 1));
+	}
+
+	// Exact halfway cases round to even:
+	if (   (low <= 1) 
+		&& (power_of_ten >= -17) 
+		&& (power_of_ten <= 10) 
+		&& ((result & 3) == 1)
+		&& ((result << shift) == high)
+	) {
+		result &= ~(uint64_t) 1;
+	}
+
+	result += (result & 1);
+	result >>= 1;
+
+	if (result >= ((uint64_t) 2 << mantissa_bits))
+	{
+		result = (uint64_t) 1 << mantissa_bits;
+		power2++;
+	}
+
+	if (power2 >= infinite_power)
+	{
+		return (uint32_t) infinite_power << mantissa_bits;
+	}
+
+	return ((uint32_t) power2 << mantissa_bits) 
+		| (uint32_t) (result & (((uint64_t) 1 << mantissa_bits) - 1));
+}
+
+static inline bool matchWord(
+	const char *position,
+	const char *end,
+	const char *word
+	) {
+
+	const size_t length = strlen(word);
+	if ((size_t) (end - position) < length)
+	{
+		return false;
+	}
+
+	for (size_t index = 0; index < length; index++)
+	{
+		if ((position[index] | 0x20) != word[index])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+number_status_e parseFloatNumber(
+	const char   *string,
+	const char   *end,
+	      float  *ret_value,
+	const char  **ret_end
+	) {
+
+	/**
+     * Parse a decimal float, correctly rounded, without locale lookups or 
+	 * allocation. Up to 19 significant digits are converted exactly with 
+	 * the Eisel-Lemire algorithm, longer inputs fall back to strtof() only
+	 * when the extra digits could change the result.
+     * @param
+     *     const char   *string   : text to parse.
+     *     const char   *end      : end of text, or NULL if null terminated.
+     *           float  *ret_value: parsed value, infinity if too large.
+     *     const char  **ret_end  : first character after the number, may be
+	 *                              NULL.
+     * @see parseInt32Number().
+     * @return number_status_e status: number_ok_e if the whole text, bar 
+	 *                                 whitespace, was a number.
+     */
+
+	if (end == NULL)
+	{
+		end = string + strlen(string);
+	}
+
+	const char *position = string;
+	while ((position < end) && isNumberSpace(*position))
+	{
+		position++;
+	}
+
+	const char *number_start = position;
+
+	bool negative = false;
+	if ((position < end) && ((*position == '-') || (*position == '+')))
+	{
+		negative = (*position == '-');
+		position++;
+	}
+
+	*ret_value = 0.0f;
+
+	if (matchWord(position, end, "inf"))
+	{
+		position += matchWord(position, end, "infinity") ? 8 : 3;
+		*ret_value = negative ? -INFINITY : INFINITY;
+
+		return finishNumber(position, end, ret_end);
+	}
+	if (matchWord(position, end, "nan"))
+	{
+		*ret_value = negative ? -NAN : NAN;
+
+		return finishNumber(position + 3, end, ret_end);
+	}
+
+	uint64_t mantissa     = 0;
+	int32_t  num_digits   = 0;
+	int64_t  exponent     = 0;
+	bool     truncated    = false;
+	bool     found_digits = false;
+
+	// Leading zeros are not significant:
+	while ((position < end) && (*position == '0'))
+	{
+		found_digits = true;
+		position++;
+	}
+
+	const char *start = position;
+	position = 
+		parseDigits(position, end, &mantissa, &num_digits, NUMBER_MAX_DIGITS);
+	found_digits = found_digits || (position > start);
+
+	// Integer digits past those that fit scale the value up:
+	while ((position < end) && isNumberDigit(*position))
+	{
+		truncated = truncated || (*position != '0');
+		exponent++;
+		position++;
+	}
+
+	if ((position < end) && (*position == '.'))
+	{
+		position++;
+
+		if (num_digits == 0)
+		{
+			while ((position < end) && (*position == '0'))
+			{
+				found_digits = true;
+				exponent--;
+				position++;
+			}
+		}
+
+		start = position;
+		position = 
+			parseDigits(
+				position, end, &mantissa, &num_digits, NUMBER_MAX_DIGITS
+			);
+		exponent    -= position - start;
+		found_digits = found_digits || (position > start);
+
+		while ((position < end) && isNumberDigit(*position))
+		{
+			truncated    = truncated || (*position != '0');
+			found_digits = true;
+			position++;
+		}
+	}
+
+	if (!found_digits)
+	{
+		if (ret_end != NULL)
+		{
+			*ret_end = string;
+		}
+		return number_empty_e;
+	}
+
+	if ((position < end) && ((*position | 0x20) == 'e'))
+	{
+		const char *exponent_start    = position;
+		bool        negative_exponent = false;
+		position++;
+
+		if ((position < end) && ((*position == '-') || (*position == '+')))
+		{
+			negative_exponent = (*position == '-');
+			position++;
+		}
+
+		if ((position < end) && isNumberDigit(*position))
+		{
+			int64_t explicit_exponent = 0;
+			while ((position < end) && isNumberDigit(*position))
+			{
+				if (explicit_exponent < 0x10000)
+				{
+					explicit_exponent = 
+						explicit_exponent * 10 + (*position - '0');
+				}
+				position++;
+			}
+			exponent += negative_exponent 
+				? -explicit_exponent 
+				: explicit_exponent;
+		}
+		else
+		{
+			// A bare 'e' is not part of the number:
+			position = exponent_start;
+		}
+	}
+
+	float value = 0.0f;
+
+	if (mantissa == 0)
+	{
+		value = 0.0f;
+	}
+	else if (
+		   !truncated 
+		&& (mantissa <= ((uint64_t) 1 << 24))
+		&& (exponent >= -10) 
+		&& (exponent <= 10)
+	) {
+		// Both operands exact, so a single rounding is correct:
+		value = (exponent < 0)
+			? (float) mantissa / number_exact_powers_of_ten[-exponent]
+			: (float) mantissa * number_exact_powers_of_ten[exponent];
+	}
+	else
+	{
+		uint32_t bits = computeFloatBits(exponent, mantissa);
+
+		if (truncated && (bits != computeFloatBits(exponent, mantissa + 1)))
+		{
+			const size_t length = (size_t) (position - number_start);
+			char         copy[length + 1];
+			memcpy(copy, number_start, length);
+			copy[length] = '\0';
+
+			value = fabsf(strtof(copy, NULL));
+		}
+		else
+		{
+			memcpy(&value, &bits, sizeof(value));
+		}
+	}
+
+	*ret_value = negative ? -value : value;
+
+	const number_status_e status = finishNumber(position, end, ret_end);
+
+	// Checked on the bits, -ffast-math builds may assume no infinities:
+	uint32_t value_bits;
+	memcpy(&value_bits, &value, sizeof(value_bits));
+
+	if ((status == number_ok_e) && ((value_bits & 0x7F800000u) == 0x7F800000u))
+	{
+		return number_range_e;
+	}
+
+	return status;
+}
+
+#define NUMBER_POW5_INV_BITS 59
+#define NUMBER_POW5_BITS     61
+#define NUMBER_MAX_FLOAT_TEXT 24
+
+// Ryu float tables, 2^(bits(5^q) - 1 + 59) / 5^q + 1 for q = 0 to 30:
+static const uint64_t number_inverse_powers_of_five[31] =
+{
+	0x0800000000000001ULL, 0x0666666666666667ULL, 0x051EB851EB851EB9ULL,
+	0x04189374BC6A7EFAULL, 0x068DB8BAC710CB2AULL, 0x053E2D6238DA3C22ULL,
+	0x0431BDE82D7B634EULL, 0x06B5FCA6AF2BD216ULL, 0x055E63B88C230E78ULL,
+	0x044B82FA09B5A52DULL, 0x06DF37F675EF6EAEULL, 0x057F5FF85E592558ULL,
+	0x0465E6604B7A8447ULL, 0x0709709A125DA071ULL, 0x05A126E1A84AE6C1ULL,
+	0x0480EBE7B9D58567ULL, 0x0734ACA5F6226F0BULL, 0x05C3BD5191B525A3ULL,
+	0x049C97747490EAE9ULL, 0x0760F253EDB4AB0EULL, 0x05E72843249088D8ULL,
+	0x04B8ED0283A6D3E0ULL, 0x078E480405D7B966ULL, 0x060B6CD004AC9452ULL,
+	0x04D5F0A66A23A9DBULL, 0x07BCB43D769F762BULL, 0x063090312BB2C4EFULL,
+	0x04F3A68DBC8F03F3ULL, 0x07EC3DAF94180651ULL, 0x065697BFA9ACD1DAULL,
+	0x051212FFBAF0A7E2ULL
+};
+
+// Ryu float tables, 5^i scaled to 61 bits for i = 0 to 46:
+static const uint64_t number_scaled_powers_of_five[47] =
+{
+	0x1000000000000000ULL, 0x1400000000000000ULL, 0x1900000000000000ULL,
+	0x1F40000000000000ULL, 0x1388000000000000ULL, 0x186A000000000000ULL,
+	0x1E84800000000000ULL, 0x1312D00000000000ULL, 0x17D7840000000000ULL,
+	0x1DCD650000000000ULL, 0x12A05F2000000000ULL, 0x174876E800000000ULL,
+	0x1D1A94A200000000ULL, 0x12309CE540000000ULL, 0x16BCC41E90000000ULL,
+	0x1C6BF52634000000ULL, 0x11C37937E0800000ULL, 0x16345785D8A00000ULL,
+	0x1BC16D674EC80000ULL, 0x1158E460913D0000ULL, 0x15AF1D78B58C4000ULL,
+	0x1B1AE4D6E2EF5000ULL, 0x10F0CF064DD59200ULL, 0x152D02C7E14AF680ULL,
+	0x1A784379D99DB420ULL, 0x108B2A2C28029094ULL, 0x14ADF4B7320334B9ULL,
+	0x19D971E4FE8401E7ULL, 0x1027E72F1F128130ULL, 0x1431E0FAE6D7217CULL,
+	0x193E5939A08CE9DBULL, 0x1F8DEF8808B02452ULL, 0x13B8B5B5056E16B3ULL,
+	0x18A6E32246C99C60ULL, 0x1ED09BEAD87C0378ULL, 0x13426172C74D822BULL,
+	0x1812F9CF7920E2B6ULL, 0x1E17B84357691B64ULL, 0x12CED32A16A1B11EULL,
+	0x178287F49C4A1D66ULL, 0x1D6329F1C35CA4BFULL, 0x125DFA371A19E6F7ULL,
+	0x16F578C4E0A060B5ULL, 0x1CB2D6F618C878E3ULL, 0x11EFC659CF7D4B8DULL,
+	0x166BB7F0435C9E71ULL, 0x1C06A5EC5433C60DULL
+};
+
+static inline int32_t powerOfFiveBits(
+	const int32_t exponent
+	) {
+
+	return (int32_t) (((uint32_t) exponent * 1217359) >> 19) + 1;
+}
+
+static inline uint32_t countFactorsOfFive(
+	      uint32_t value
+	) {
+
+	uint32_t count = 0;
+	while ((value % 5) == 0)
+	{
+		value /= 5;
+		count++;
+	}
+
+	return count;
+}
+
+static inline uint32_t multiplyShift32(
+	const uint32_t value,
+	const uint64_t factor,
+	const int32_t  shift
+	) {
+
+	const uint64_t low  = (uint64_t) value * (uint32_t) factor;
+	const uint64_t high = (uint64_t) value * (factor >> 32);
+
+	return (uint32_t) (((low >> 32) + high) >> (shift - 32));
+}
+
+int32_t shortestFloatDigits(
+	const uint32_t  bits,
+	      uint32_t *ret_digits,
+	      int32_t  *ret_exponent
+	) {
+
+	/**
+     * Find the shortest decimal that reads back as the finite, non zero 
+	 * float with the entered bits, using the Ryu algorithm. Ties between 
+	 * equally short candidates go to the one closest to the exact value.
+     * @param
+     *     const uint32_t  bits        : IEEE bits of the float, sign ignored.
+     *           uint32_t *ret_digits  : decimal significand, at most 9 
+	 *                                   digits.
+     *           int32_t  *ret_exponent: power of ten to scale digits by.
+     * @see formatFloatNumber().
+     * @return int32_t num_digits: number of digits in ret_digits.
+     */
+
+	const uint32_t ieee_mantissa = bits & 0x7FFFFFu;
+	const uint32_t ieee_exponent = (bits >> 23) & 0xFFu;
+
+	int32_t  exponent_2;
+	uint32_t mantissa_2;
+	if (ieee_exponent == 0)
+	{
+		exponent_2 = 1 - 127 - 23 - 2;
+		mantissa_2 = ieee_mantissa;
+	}
+	else
+	{
+		exponent_2 = (int32_t) ieee_exponent - 127 - 23 - 2;
+		mantissa_2 = (1u << 23) | ieee_mantissa;
+	}
+
+	const bool     accept_bounds = (mantissa_2 & 1) == 0;
+	const uint32_t mm_shift      = (ieee_mantissa != 0) || (ieee_exponent <= 1);
+
+	// Value and the halfway points to its neighbours, times four:
+	const uint32_t mv = 4 * mantissa_2;
+	const uint32_t mp = 4 * mantissa_2 + 2;
+	const uint32_t mm = 4 * mantissa_2 - 1 - mm_shift;
+
+	uint32_t vr, vp, vm;
+	int32_t  exponent_10;
+	bool     vm_trailing_zeros = false;
+	bool     vr_trailing_zeros = false;
+	uint32_t last_removed      = 0;
+
+	if (exponent_2 >= 0)
+	{
+		const int32_t q     = (int32_t) (((uint32_t) exponent_2 * 78913) >> 18);
+		const int32_t shift = 
+			-exponent_2 + q + NUMBER_POW5_INV_BITS + powerOfFiveBits(q) - 1;
+
+		exponent_10 = q;
+		vr = multiplyShift32(mv, number_inverse_powers_of_five[q], shift);
+		vp = multiplyShift32(mp, number_inverse_powers_of_five[q], shift);
+		vm = multiplyShift32(mm, number_inverse_powers_of_five[q], shift);
+
+		if ((q != 0) && ((vp - 1) / 10 <= vm / 10))
+		{
+			const int32_t last_shift = 
+				-exponent_2 + q - 1 + NUMBER_POW5_INV_BITS 
+				+ powerOfFiveBits(q - 1) - 1;
+			last_removed = 
+				multiplyShift32(
+					mv, number_inverse_powers_of_five[q - 1], last_shift
+				) % 10;
+		}
+
+		if (q <= 9)
+		{
+			if ((mv % 5) == 0)
+			{
+				vr_trailing_zeros = countFactorsOfFive(mv) >= (uint32_t) q;
+			}
+			else if (accept_bounds)
+			{
+				vm_trailing_zeros = countFactorsOfFive(mm) >= (uint32_t) q;
+			}
+			else
+			{
+				vp -= countFactorsOfFive(mp) >= (uint32_t) q;
+			}
+		}
+	}
+	else
+	{
+		const int32_t q     = (int32_t) (((uint32_t) -exponent_2 * 732923) >> 20);
+		const int32_t index = -exponent_2 - q;
+		const int32_t shift = 
+			q - (powerOfFiveBits(index) - NUMBER_POW5_BITS);
+
+		exponent_10 = q + exponent_2;
+		vr = multiplyShift32(mv, number_scaled_powers_of_five[index], shift);
+		vp = multiplyShift32(mp, number_scaled_powers_of_five[index], shift);
+		vm = multiplyShift32(mm, number_scaled_powers_of_five[index], shift);
+
+		if ((q != 0) && ((vp - 1) / 10 <= vm / 10))
+		{
+			const int32_t last_shift = 
+				q - 1 - (powerOfFiveBits(index + 1) - NUMBER_POW5_BITS);
+			last_removed = 
+				multiplyShift32(
+					mv, number_scaled_powers_of_five[index + 1], last_shift
+				) % 10;
+		}
+
+		if (q <= 1)
+		{
+			vr_trailing_zeros = true;
+			if (accept_bounds)
+			{
+				vm_trailing_zeros = (mm_shift == 1);
+			}
+			else
+			{
+				vp--;
+			}
+		}
+		else if (q < 31)
+		{
+			vr_trailing_zeros = (mv & ((1u << (q - 1)) - 1)) == 0;
+		}
+	}
+
+	// Drop digits while the neighbours' halfway points stay apart:
+	int32_t  removed = 0;
+	uint32_t output;
+
+	if (vm_trailing_zeros || vr_trailing_zeros)
+	{
+		while (vp / 10 > vm / 10)
+		{
+			vm_trailing_zeros &= (vm % 10) == 0;
+			vr_trailing_zeros &= (last_removed == 0);
+			last_removed = vr % 10;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+
+		if (vm_trailing_zeros)
+		{
+			while ((vm % 10) == 0)
+			{
+				vr_trailing_zeros &= (last_removed == 0);
+				last_removed = vr % 10;
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+		}
+
+		// Exact halfway rounds to even:
+		if (vr_trailing_zeros && (last_removed == 5) && ((vr % 2) == 0))
+		{
+			last_removed = 4;
+		}
+
+		output = vr + (
+			   ((vr == vm) && (!accept_bounds || !vm_trailing_zeros)) 
+			|| (last_removed >= 5)
+		);
+	}
+	else
+	{
+		while (vp / 10 > vm / 10)
+		{
+			last_removed = vr % 10;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+
+		output = vr + ((vr == vm) || (last_removed >= 5));
+	}
+
+	int32_t num_digits = 1;
+	for (uint32_t power = 10; (num_digits < 10) && (output >= power); power *= 10)
+	{
+		num_digits++;
+	}
+
+	*ret_digits   = output;
+	*ret_exponent = exponent_10 + removed;
+
+	return num_digits;
+}
+
+size_t formatFloatNumber(
+	const float  value,
+	const bool   scientific,
+	      char  *string
+	) {
+
+	/**
+     * Write the shortest text that parses back to exactly value. Scientific
+	 * notation looks like printf's %e with only the needed digits, 
+	 * "1.5e+01", otherwise plain positional notation is used, "15". No 
+	 * locale, no format string and no null terminator.
+     * @param
+     *     const float  value     : number to format.
+     *     const bool   scientific: use d.ddde+XX notation.
+     *           char  *string    : output, room for NUMBER_MAX_FLOAT_TEXT 
+	 *                              characters in scientific notation or 
+	 *                              64 otherwise.
+     * @see shortestFloatDigits(), parseFloatNumber().
+     * @return size_t length: number of characters written.
+     */
+
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	char *position = string;
+	if (bits >> 31)
+	{
+		*position++ = '-';
+	}
+
+	const uint32_t exponent_bits = (bits >> 23) & 0xFFu;
+	const uint32_t mantissa_bits = bits & 0x7FFFFFu;
+
+	if (exponent_bits == 0xFFu)
+	{
+		memcpy(position, (mantissa_bits != 0) ? "nan" : "inf", 3);
+		return (size_t) (position - string) + 3;
+	}
+
+	uint32_t digits   = 0;
+	int32_t  exponent = 0;
+	int32_t  num_digits = 1;
+
+	if ((exponent_bits != 0) || (mantissa_bits != 0))
+	{
+		num_digits = shortestFloatDigits(bits, &digits, &exponent);
+	}
+
+	char digit_text[10] = {0};
+	for (int32_t index = num_digits - 1; index >= 0; index--)
+	{
+		digit_text[index] = (char) ('0' + digits % 10);
+		digits /= 10;
+	}
+
+	if (scientific)
+	{
+		const int32_t decimal_exponent = exponent + num_digits - 1;
+
+		*position++ = digit_text[0];
+		if (num_digits > 1)
+		{
+			*position++ = '.';
+			memcpy(position, &digit_text[1], (size_t) num_digits - 1);
+			position += num_digits - 1;
+		}
+
+		*position++ = 'e';
+		*position++ = (decimal_exponent < 0) ? '-' : '+';
+
+		const int32_t magnitude = abs(decimal_exponent);
+		if (magnitude >= 100)
+		{
+			*position++ = (char) ('0' + magnitude / 100);
+		}
+		*position++ = (char) ('0' + (magnitude / 10) % 10);
+		*position++ = (char) ('0' + magnitude % 10);
+	}
+	else if (exponent >= 0)
+	{
+		// Whole number, digits then zeros:
+		memcpy(position, digit_text, (size_t) num_digits);
+		position += num_digits;
+		memset(position, '0', (size_t) exponent);
+		position += exponent;
+	}
+	else if (num_digits + exponent > 0)
+	{
+		// Point falls inside the digits:
+		const int32_t num_whole = num_digits + exponent;
+
+		memcpy(position, digit_text, (size_t) num_whole);
+		position += num_whole;
+		*position++ = '.';
+		memcpy(position, &digit_text[num_whole], (size_t) -exponent);
+		position += -exponent;
+	}
+	else
+	{
+		// Point comes before the digits:
+		const int32_t num_zeros = -(num_digits + exponent);
+
+		*position++ = '0';
+		*position++ = '.';
+		memset(position, '0', (size_t) num_zeros);
+		position += num_zeros;
+		memcpy(position, digit_text, (size_t) num_digits);
+		position += num_digits;
+	}
+
+	return (size_t) (position - string);
+}
+
+#endif
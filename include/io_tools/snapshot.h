@@ -0,0 +1,788 @@
+#ifndef IO_SNAPSHOT_H
+#define IO_SNAPSHOT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+
+#include "io_tools/text.h"
+#include "io_tools/custom_types.h"
+#include "io_tools/structures.h"
+#include "io_tools/config.h"
+
+#define SNAPSHOT_MAGIC     "CFGSNAP"
+#define SNAPSHOT_VERSION   ((uint32_t) 1)
+#define SNAPSHOT_ALIGNMENT ((size_t) 16)
+
+typedef struct SnapshotHeader {
+
+	/**
+     * Structure to hold the header at the start of a config snapshot file.
+	 * Pointer slots in the file hold byte offsets from the start of the
+	 * file, 0 for NULL, and are listed in the relocation table.
+     */
+
+	char     magic[8];
+	uint32_t version;
+	int32_t  num_structs;
+
+	// Validity of the snapshot:
+	uint64_t schema_hash;
+	source_stamp_s source;
+
+	uint64_t root_offset;
+	uint64_t structs_offset;
+	uint64_t relocations_offset;
+	uint64_t num_relocations;
+	uint64_t total_size;
+
+} snapshot_header_s;
+
+typedef struct SnapshotBuffer {
+
+	/**
+     * Structure to hold a snapshot file while it is being built.
+     */
+
+	uint8_t  *data;
+	size_t    length;
+	size_t    capacity;
+
+	uint64_t *relocations;
+	size_t    num_relocations;
+	size_t    max_num_relocations;
+
+} snapshot_buffer_s;
+
+typedef struct SnapshotNode {
+
+	/**
+     * Structure to hold one block of a snapshot, mirroring the structure and
+	 * subconfigs of the loader_data_s it was written from.
+     */
+
+	void                *structure;
+	char                *name;
+	struct SnapshotNode *subconfigs;
+	int32_t              num_subconfigs;
+
+} snapshot_node_s;
+
+// Pointer slots are stored as 64 bit file offsets:
+_Static_assert(
+	sizeof(void*) == sizeof(uint64_t), "Snapshots need 64 bit pointers."
+);
+
+typedef struct ConfigSnapshot {
+
+	/**
+     * Structure to hold a loaded snapshot. The config structures live inside
+	 * the mapping, so stay valid until freeConfigSnapshot().
+     */
+
+	mapped_file_s     mapped;
+	void            **config_structs;
+	int32_t           num_structs;
+	snapshot_node_s  *root;
+
+} config_snapshot_s;
+
+uint64_t combineHash(
+	const uint64_t hash,
+	const uint64_t value
+	) {
+
+	return mixHash(hash ^ value, 0x9E3779B97F4A7C15ULL);
+}
+
+uint64_t hashFloatBits(
+	const uint64_t hash,
+	const float    value
+	) {
+
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	return combineHash(hash, bits);
+}
+
+uint64_t hashNullableString(
+	const uint64_t  hash,
+	const char     *string
+	) {
+
+	return combineHash(
+		hash,
+		(string != NULL) ? hashString(string, strlen(string)) : 0
+	);
+}
+
+uint64_t hashParameter(
+	      uint64_t    hash,
+	const parameter_s parameter
+	) {
+
+	hash = hashNullableString(hash, parameter.name);
+	hash = combineHash(hash, (uint64_t) parameter.type);
+	hash = combineHash(hash, (uint64_t) (uint32_t) parameter.min);
+	hash = combineHash(hash, (uint64_t) (uint32_t) parameter.max);
+	hash = hashFloatBits(hash, parameter.lower_limit);
+	hash = hashFloatBits(hash, parameter.upper_limit);
+
+	return hash;
+}
+
+uint64_t hashSchema(
+	      uint64_t  hash,
+	const schema_s *schema
+	) {
+
+	/**
+     * Hash everything in a compiled schema that affects the layout or the
+	 * validation of parsed structures.
+     * @param
+     *           uint64_t  hash  : hash to extend.
+     *     const schema_s *schema: schema to hash.
+     * @see writeConfigSnapshot(), loadConfigSnapshot().
+     * @return uint64_t hash: extended hash.
+     */
+
+	const loader_config_s config = schema->config;
+
+	const int64_t fields[] =
+	{
+		config.name_necessity,
+		config.inherit,
+		config.is_superconfig,
+		config.has_parameters,
+		config.reorder,
+		config.min,
+		config.max,
+		config.early_exit_index,
+		config.num_defined_parameters,
+		config.min_inputed_parameters,
+		config.max_inputed_parameters,
+		config.min_extra_parameters,
+		config.max_extra_parameters,
+		config.num_defined_subconfigs,
+		config.min_num_subconfigs,
+		config.max_num_subconfigs,
+		config.min_extra_subconfigs,
+		config.max_extra_subconfigs,
+		(int64_t) config.struct_size
+	};
+
+	hash = hashNullableString(hash, config.name);
+	for (size_t index = 0; index < sizeof(fields)/sizeof(fields[0]); index++)
+	{
+		hash = combineHash(hash, (uint64_t) fields[index]);
+	}
+
+	hash = hashParameter(hash, config.default_parameter);
+	for (int32_t index = 0; index < config.num_defined_parameters; index++)
+	{
+		hash = hashParameter(hash, config.defined_parameters[index]);
+		hash = combineHash(hash, schema->parameter_offsets[index]);
+	}
+
+	if (schema->default_subconfig != NULL)
+	{
+		hash = hashSchema(hash, schema->default_subconfig);
+	}
+	for (int32_t index = 0; index < schema->num_subconfigs; index++)
+	{
+		hash = hashSchema(hash, &schema->subconfigs[index]);
+	}
+
+	return hash;
+}
+
+size_t appendSnapshotBytes(
+	      snapshot_buffer_s *buffer,
+	const void              *bytes,
+	const size_t             length
+	) {
+
+	/**
+     * Append length bytes to the snapshot, aligned for any type. If bytes is
+	 * NULL the space is zeroed.
+     * @return size_t offset: offset of the bytes in the snapshot.
+     */
+
+	const size_t offset =
+		(buffer->length + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+
+	if (offset + length > buffer->capacity)
+	{
+		buffer->capacity = 2*(offset + length) + 4096;
+		buffer->data     = realloc(buffer->data, buffer->capacity);
+	}
+
+	memset(&buffer->data[buffer->length], 0, offset - buffer->length);
+	if (bytes != NULL)
+	{
+		memcpy(&buffer->data[offset], bytes, length);
+	}
+	else
+	{
+		memset(&buffer->data[offset], 0, length);
+	}
+	buffer->length = offset + length;
+
+	return offset;
+}
+
+void setSnapshotPointer(
+	      snapshot_buffer_s *buffer,
+	const size_t             slot,
+	const size_t             target
+	) {
+
+	/**
+     * Point the pointer slot at slot to the snapshot offset target, and
+	 * record the slot for relocation at load time.
+     */
+
+	const uint64_t value = target;
+	memcpy(&buffer->data[slot], &value, sizeof(value));
+
+	if (target == 0)
+	{
+		return;
+	}
+
+	if (buffer->num_relocations >= buffer->max_num_relocations)
+	{
+		buffer->max_num_relocations = 2*buffer->max_num_relocations + 64;
+		buffer->relocations         =
+			realloc(
+				buffer->relocations,
+				sizeof(uint64_t) * buffer->max_num_relocations
+			);
+	}
+
+	buffer->relocations[buffer->num_relocations] = slot;
+	buffer->num_relocations++;
+}
+
+size_t appendSnapshotString(
+	      snapshot_buffer_s *buffer,
+	const char              *string
+	) {
+
+	return (string != NULL)
+		? appendSnapshotBytes(buffer, string, strlen(string) + 1)
+		: 0;
+}
+
+void appendSnapshotParameter(
+	      snapshot_buffer_s *buffer,
+	const size_t             slot,
+	const parameter_s        parameter,
+	const int32_t            num_elements,
+	const void              *value
+	) {
+
+	/**
+     * Copy whatever a parameter's pointer slot points to into the snapshot
+	 * and relocate the slot to the copy. Scalar parameters are left as they
+	 * were copied with their structure.
+     * @param
+     *           snapshot_buffer_s *buffer      : snapshot being built.
+     *     const size_t             slot        : offset of parameter in
+	 *                                            snapshot.
+     *     const parameter_s        parameter   : parameter definition.
+     *     const int32_t            num_elements: elements read into array.
+     *     const void              *value       : parameter in the source
+	 *                                            structure.
+     * @see writeConfigSnapshot().
+     * @return none
+     */
+
+	switch (parameter.type)
+	{
+		case(bool_e ):
+		case(int_e  ):
+		case(float_e):
+		case(char_e ):
+		case(none_e ):
+		return;
+
+		default:
+		break;
+	}
+
+	void *pointer = NULL;
+	memcpy(&pointer, value, sizeof(pointer));
+
+	size_t element_size = 0;
+
+	switch (parameter.type)
+	{
+		case(string_e):
+			setSnapshotPointer(
+				buffer, slot, appendSnapshotString(buffer, pointer)
+			);
+		return;
+
+		case(string_array_e):
+		{
+			if (pointer == NULL)
+			{
+				setSnapshotPointer(buffer, slot, 0);
+				return;
+			}
+
+			char **strings = pointer;
+
+			const size_t array_offset =
+				appendSnapshotBytes(
+					buffer, NULL, sizeof(uint64_t) * (size_t) num_elements
+				);
+			for (int32_t index = 0; index < num_elements; index++)
+			{
+				setSnapshotPointer(
+					buffer,
+					array_offset + sizeof(uint64_t) * (size_t) index,
+					appendSnapshotString(buffer, strings[index])
+				);
+			}
+			setSnapshotPointer(buffer, slot, array_offset);
+		}
+		return;
+
+		case(bool_array_e ): element_size = sizeof(bool   ); break;
+		case(int_array_e  ): element_size = sizeof(int32_t); break;
+		case(float_array_e): element_size = sizeof(float  ); break;
+		case(char_array_e ): element_size = sizeof(char   ); break;
+
+		// Never filled by the parser:
+		case(int_jagged_e  ):
+		case(float_jagged_e):
+			setSnapshotPointer(buffer, slot, 0);
+		return;
+
+		default:
+		return;
+	}
+
+	setSnapshotPointer(
+		buffer,
+		slot,
+		(pointer != NULL)
+			? appendSnapshotBytes(
+				buffer, pointer, element_size * (size_t) num_elements
+			)
+			: 0
+	);
+}
+
+void writeSnapshotNode(
+	      snapshot_buffer_s *buffer,
+	const size_t             node_offset,
+	const loader_data_s     *data,
+	const schema_s          *parameter_schema,
+	const schema_s          *data_schema
+	) {
+
+	/**
+     * Copy a parsed block, its values and the blocks read inside it into
+	 * the snapshot node at node_offset.
+     * @param
+     *           snapshot_buffer_s *buffer          : snapshot being built.
+     *     const size_t             node_offset     : offset of node to fill.
+     *     const loader_data_s     *data            : parse data of block.
+     *     const schema_s          *parameter_schema: schema whose parameter
+	 *                                                types the block was
+	 *                                                read with.
+     *     const schema_s          *data_schema     : schema the block's own
+	 *                                                blocks were read with.
+     * @see writeConfigSnapshot().
+     * @return none
+     */
+
+	const uint8_t *structure = data->structure;
+
+	const size_t struct_offset =
+		appendSnapshotBytes(buffer, structure, data->config.struct_size);
+
+	for (
+		int32_t parameter = 0;
+		parameter < data->config.num_defined_parameters;
+		parameter++
+	) {
+		const size_t offset = data->parameter_offsets[parameter];
+
+		appendSnapshotParameter(
+			buffer,
+			struct_offset + offset,
+			parameter_schema->config.defined_parameters[parameter],
+			data->parameter_lengths[parameter],
+			&structure[offset]
+		);
+	}
+
+	const int32_t num_subconfigs =
+		data->config.is_superconfig ? data->total_num_subconfigs_read : 0;
+
+	const size_t subconfigs_offset =
+		(num_subconfigs > 0)
+		? appendSnapshotBytes(
+			buffer, NULL, sizeof(snapshot_node_s) * (size_t) num_subconfigs
+		)
+		: 0;
+
+	setSnapshotPointer(
+		buffer, node_offset + offsetof(snapshot_node_s, structure), struct_offset
+	);
+	setSnapshotPointer(
+		buffer,
+		node_offset + offsetof(snapshot_node_s, name),
+		appendSnapshotString(buffer, data->name)
+	);
+	setSnapshotPointer(
+		buffer,
+		node_offset + offsetof(snapshot_node_s, subconfigs),
+		subconfigs_offset
+	);
+	memcpy(
+		&buffer->data[node_offset + offsetof(snapshot_node_s, num_subconfigs)],
+		&num_subconfigs,
+		sizeof(num_subconfigs)
+	);
+
+	for (int32_t index = 0; index < num_subconfigs; index++)
+	{
+		const loader_data_s *subconfig = &data->subconfigs[index];
+
+		// Mirror the schema choice readSubconfig() made for the block:
+		const schema_s *named_schema =
+			findNamedSchema(data_schema, subconfig->name);
+		const schema_s *default_schema = data_schema->default_subconfig;
+
+		writeSnapshotNode(
+			buffer,
+			subconfigs_offset + sizeof(snapshot_node_s) * (size_t) index,
+			subconfig,
+			(named_schema != NULL) ? named_schema : default_schema,
+			((named_schema != NULL) && !named_schema->config.inherit)
+				? named_schema
+				: default_schema
+		);
+	}
+}
+
+bool writeConfigSnapshot(
+	const int32_t          verbosity,
+	const char            *snapshot_name,
+	const char            *file_name,
+	const loader_config_s  config,
+	      void           **config_structs,
+	const loader_data_s    config_data
+	) {
+
+	/**
+     * Serialise the structures returned by a successful readConfig(), and
+	 * the tree of blocks they were read from, into a snapshot file which 
+	 * loadConfigSnapshot() can map and use directly. Written with 
+	 * writeFileAtomic().
+     * @param
+     *     const int32_t          verbosity     : verbosity level of warnings.
+     *     const char            *snapshot_name : path of snapshot to write.
+     *     const char            *file_name     : path of the config file
+	 *                                            that was read.
+     *     const loader_config_s  config        : config the file was read
+	 *                                            with.
+     *           void           **config_structs: structures from readConfig.
+     *     const loader_data_s    config_data   : parse data from readConfig.
+     * @see loadConfigSnapshot().
+     * @return bool success: true if the snapshot was written.
+     */
+
+	struct stat source_stat;
+	if (   (config_structs == NULL) 
+		|| (config_data.total_num_subconfigs_read < 0)
+		|| (stat(file_name, &source_stat) != 0)
+	) {
+		if (verbosity > 0)
+		{
+			fprintf(
+				stderr,
+				"writeConfigSnapshot: \nWarning! Nothing to snapshot for "
+				"\"%s\". \n",
+				file_name
+			);
+		}
+
+		return false;
+	}
+
+	schema_s *schema = compileSchema(config);
+
+	const int32_t num_structs =
+		config.is_superconfig ? config_data.total_num_subconfigs_read : 1;
+
+	snapshot_buffer_s buffer = {NULL, 0, 0, NULL, 0, 0};
+
+	const size_t header_offset =
+		appendSnapshotBytes(&buffer, NULL, sizeof(snapshot_header_s));
+	const size_t root_offset =
+		appendSnapshotBytes(&buffer, NULL, sizeof(snapshot_node_s));
+
+	writeSnapshotNode(&buffer, root_offset, &config_data, schema, schema);
+
+	// Returned structures are the root's, or its blocks' in returned order:
+	const size_t structs_offset =
+		appendSnapshotBytes(
+			&buffer, NULL, sizeof(uint64_t) * (size_t) num_structs
+		);
+
+	bool pass = true;
+
+	for (int32_t index = 0; pass && (index < num_structs); index++)
+	{
+		size_t node_offset = config.is_superconfig ? 0 : root_offset;
+
+		for (
+			int32_t block = 0; 
+			config.is_superconfig && (block < num_structs); 
+			block++
+		) {
+			if (config_data.subconfigs[block].structure 
+				== config_structs[index]
+			) {
+				uint64_t subconfigs_offset;
+				memcpy(
+					&subconfigs_offset,
+					&buffer.data[
+						root_offset + offsetof(snapshot_node_s, subconfigs)
+					],
+					sizeof(subconfigs_offset)
+				);
+				node_offset = 
+					subconfigs_offset 
+					+ sizeof(snapshot_node_s) * (size_t) block;
+				break;
+			}
+		}
+
+		if (node_offset == 0)
+		{
+			pass = false;
+			break;
+		}
+
+		uint64_t struct_offset;
+		memcpy(
+			&struct_offset,
+			&buffer.data[node_offset + offsetof(snapshot_node_s, structure)],
+			sizeof(struct_offset)
+		);
+
+		setSnapshotPointer(
+			&buffer,
+			structs_offset + sizeof(uint64_t) * (size_t) index,
+			struct_offset
+		);
+	}
+
+	if (pass)
+	{
+		const size_t relocations_offset =
+			appendSnapshotBytes(
+				&buffer,
+				buffer.relocations,
+				sizeof(uint64_t) * buffer.num_relocations
+			);
+
+		snapshot_header_s header =
+		{
+			.magic              = SNAPSHOT_MAGIC,
+			.version            = SNAPSHOT_VERSION,
+			.num_structs        = num_structs,
+			.schema_hash        = hashSchema(SNAPSHOT_VERSION, schema),
+			.source             = getSourceStamp(&source_stat),
+			.root_offset        = root_offset,
+			.structs_offset     = structs_offset,
+			.relocations_offset = relocations_offset,
+			.num_relocations    = buffer.num_relocations,
+			.total_size         = buffer.length
+		};
+		memcpy(&buffer.data[header_offset], &header, sizeof(header));
+
+		const struct iovec snapshot = {buffer.data, buffer.length};
+
+		pass = writeFileAtomic(snapshot_name, &snapshot, 1);
+	}
+
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(
+			stderr,
+			"writeConfigSnapshot: \nWarning! Could not write snapshot \"%s\"."
+			" \n",
+			snapshot_name
+		);
+	}
+
+	free(buffer.data);
+	free(buffer.relocations);
+	freeSchema(schema);
+
+	return pass;
+}
+
+void **loadConfigSnapshot(
+	const int32_t             verbosity,
+	const char               *snapshot_name,
+	const char               *file_name,
+	const loader_config_s     config,
+	      config_snapshot_s  *ret_snapshot
+	) {
+
+	/**
+     * Map a snapshot written by writeConfigSnapshot() and relocate its
+	 * pointers, giving the same structures as readConfig() without parsing.
+	 * The snapshot is rejected if the config file's mtime or size, or the
+	 * hash of config, no longer match those it was written from.
+     * @param
+     *     const int32_t             verbosity    : verbosity level of
+	 *                                              warnings.
+     *     const char               *snapshot_name: path of snapshot.
+     *     const char               *file_name    : path of the source config.
+     *     const loader_config_s     config       : config to read with.
+     *           config_snapshot_s  *ret_snapshot : loaded snapshot.
+     * @see writeConfigSnapshot(), freeConfigSnapshot().
+     * @return void **config_structs: array of config structures, or NULL if
+	 *                                the snapshot is missing or stale.
+     */
+
+	*ret_snapshot = (config_snapshot_s) {.config_structs = NULL};
+
+	struct stat source_stat;
+	if (stat(file_name, &source_stat) != 0)
+	{
+		return NULL;
+	}
+
+	mapped_file_s mapped;
+	if (!mapFileProtection(
+			verbosity > 1 ? verbosity : 0,
+			snapshot_name,
+			PROT_READ | PROT_WRITE,
+			&mapped
+		)
+	) {
+		return NULL;
+	}
+
+	uint8_t           *base   = (uint8_t*) mapped.data;
+	snapshot_header_s  header;
+
+	bool valid = (mapped.length >= sizeof(header));
+	if (valid)
+	{
+		memcpy(&header, base, sizeof(header));
+
+		valid =
+			   !memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC))
+			&& (header.version           == SNAPSHOT_VERSION)
+			&& (header.total_size        == mapped.length)
+			&& checkSourceStamp(header.source, &source_stat)
+			&& (header.root_offset + sizeof(snapshot_node_s) <= mapped.length)
+			&& (header.structs_offset
+				+ sizeof(uint64_t) * (uint64_t) header.num_structs
+				<= mapped.length)
+			&& (header.relocations_offset
+				+ sizeof(uint64_t) * header.num_relocations
+				<= mapped.length);
+	}
+
+	if (valid)
+	{
+		schema_s *schema = compileSchema(config);
+		valid = (header.schema_hash == hashSchema(SNAPSHOT_VERSION, schema));
+		freeSchema(schema);
+	}
+
+	if (!valid)
+	{
+		if (verbosity > 1)
+		{
+			fprintf(
+				stderr,
+				"loadConfigSnapshot: \nSnapshot \"%s\" is stale, config must "
+				"be re-read. \n",
+				snapshot_name
+			);
+		}
+		unmapFile(&mapped);
+
+		return NULL;
+	}
+
+	const uint64_t *relocations =
+		(const uint64_t*) &base[header.relocations_offset];
+
+	// Check every slot and target lies inside the file before touching any:
+	for (uint64_t index = 0; valid && (index < header.num_relocations); index++)
+	{
+		uint64_t target = 0;
+		if (relocations[index] + sizeof(target) <= mapped.length)
+		{
+			memcpy(&target, &base[relocations[index]], sizeof(target));
+		}
+
+		valid = (target > 0) && (target < mapped.length);
+	}
+
+	if (!valid)
+	{
+		if (verbosity > 0)
+		{
+			fprintf(
+				stderr,
+				"loadConfigSnapshot: \nWarning! Snapshot \"%s\" is corrupt. \n",
+				snapshot_name
+			);
+		}
+		unmapFile(&mapped);
+
+		return NULL;
+	}
+
+	for (uint64_t index = 0; index < header.num_relocations; index++)
+	{
+		uint64_t target;
+		memcpy(&target, &base[relocations[index]], sizeof(target));
+
+		void *pointer = &base[target];
+		memcpy(&base[relocations[index]], &pointer, sizeof(pointer));
+	}
+
+	*ret_snapshot = (config_snapshot_s)
+	{
+		.mapped         = mapped,
+		.config_structs = (void**) &base[header.structs_offset],
+		.num_structs    = header.num_structs,
+		.root           = (snapshot_node_s*) &base[header.root_offset]
+	};
+
+	return ret_snapshot->config_structs;
+}
+
+void freeConfigSnapshot(
+	config_snapshot_s *snapshot
+	) {
+
+	unmapFile(&snapshot->mapped);
+	*snapshot = (config_snapshot_s) {.config_structs = NULL};
+}
+
+#endif
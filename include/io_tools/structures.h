@@ -1,6 +1,8 @@
 #ifndef IO_STRUCTURES_H
 #define IO_STRUCTURES_H
 
+#include <stddef.h>
+
 #include "io_tools/custom_types.h"
 
 typedef enum Necessity{ 
@@ -51,6 +53,14 @@ typedef struct LoaderConfig{
 	int32_t              max_inputed_parameters;
 	parameter_s         *defined_parameters;
 	
+	// Optional offsetof() of each defined parameter in the struct. If NULL
+	// parameters are laid out in order with natural padding:
+	size_t              *parameter_offsets;
+	
+	// Set by CONFIG_DECLARED_LAYOUT(), the struct and parameters come from
+	// one declaration so their layout is not checked again:
+	bool                 layout_declared;
+	
 	int32_t              min_extra_parameters;
 	int32_t              max_extra_parameters;
 	parameter_s          default_parameter;
@@ -68,6 +78,38 @@ typedef struct LoaderConfig{
 
 } loader_config_s;
 
+typedef struct Schema {
+	
+	/**
+     * Structure to hold a loader_config_s compiled for parsing. Name maps,
+     * offsets and inherited parameters are built once per schema and then
+     * shared, read only, by every block parsed with it.
+     */
+	
+	loader_config_s      config;
+	
+	map_s                parameter_name_map;
+	size_t              *parameter_offsets;
+	map_s                subconfig_name_map;
+	
+	// Schema for blocks opened inside this config, and for blocks renamed
+	// to each defined subconfig. Only compiled for superconfigs:
+	struct Schema       *default_subconfig;
+	struct Schema       *subconfigs;
+	int32_t              num_subconfigs;
+	
+	bool                 owns_parameters;
+	
+	// First inherited parameter that did not match a base parameter, 
+	// warned about when a block is parsed with it. Index is -1 if none:
+	int32_t              unmatched_index;
+	const char          *unmatched_name;
+	
+	// Arena the schema was compiled into, NULL if allocated with malloc:
+	arena_s             *arena;
+	
+} schema_s;
+
 typedef struct LoaderData {
 	
 	/**
@@ -79,6 +121,10 @@ typedef struct LoaderData {
     
     map_s              parameter_name_map;
     int32_t           *num_parameters_read;
+    size_t            *parameter_offsets;
+    
+    // Number of elements read into each array parameter, 1 for scalars:
+    int32_t           *parameter_lengths;
     
     dict_s            *extra_parameters;
     dict_s            *num_extra_parameters;
@@ -92,8 +138,36 @@ typedef struct LoaderData {
     struct LoaderData *subconfigs;
     loader_config_s    config;
     
+    // Set on the root block only, when the schema was compiled by readConfig:
+    schema_s          *schema;
+    
+    // Arenas for parse bookkeeping and for returned structures, values and 
+    // arrays. Either may be NULL for malloc:
+    arena_s           *arena;
+    arena_s           *output_arena;
+    
 } loader_data_s;
 
+typedef struct ParsedBlock {
+	
+	/**
+     * Structure to hold a top level config block located by brace matching
+     * and parsed ahead of the sequential pass.
+     */
+    
+    int32_t            open_index;
+    int32_t            close_index;
+    
+    // True if the parse stopped exactly on the closing token, so the result
+    // matches what a sequential read would produce:
+    bool               consumed;
+    bool               used;
+    
+    loader_data_s      data;
+    arena_s           *arena;
+    
+} parsed_block_s;
+
 typedef struct LoaderSyntax{
     const char *comment;
     const char *new_line;
@@ -17,8 +17,12 @@
 #include <string.h>
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <sys/uio.h>
 
 #include "io_tools/strings.h"
+#include "io_tools/numbers.h"
 
 typedef struct split_path {
 	
@@ -228,6 +232,128 @@ bool checkOpenFile(
 	return exists;
 }
 
+typedef struct MappedFile {
+
+	/**
+     * Structure to hold a read only view of a whole file. Empty files are
+     * not mapped and point to an empty string instead.
+     */
+
+	const char *data;
+	size_t      length;
+	bool        is_mapped;
+
+} mapped_file_s;
+
+bool mapFileProtection(
+    const int32_t        verbosity, 
+    const char          *file_name, 
+    const int            protection,
+          mapped_file_s *ret_mapped
+    ) {
+
+	/**
+     * Map a whole, private copy on write, file into memory, so it can be 
+     * used in place without any intermediate copies.
+     * @param
+     *     const int32_t        verbosity : verbosity level of warnings.
+     *     const char          *file_name : path of file to map.
+     *     const int            protection: mmap protection flags, writes
+     *                                      are never carried to the file.
+     *           mapped_file_s *ret_mapped: view of the mapped file.
+     * @see mapFile(), unmapFile(), checkOpenFile().
+     * @return bool success: true if the file was opened and mapped.
+     */
+
+	*ret_mapped = (mapped_file_s) {"", 0, false};
+
+	const int file_descriptor = open(file_name, O_RDONLY);
+	struct stat file_stat;
+
+	if ((file_descriptor < 0) || (fstat(file_descriptor, &file_stat) != 0))
+	{
+		if (verbosity >= 1) 
+		{
+			fprintf(
+				stderr, 
+				"mapFileProtection: \nWarning! Could not open file \"%s\":"
+				" %s.\n", 
+				file_name,
+				strerror(errno)
+			);  
+		}
+
+		if (file_descriptor >= 0)
+		{
+			close(file_descriptor);
+		}
+
+		return false;
+	}
+
+	const size_t length = (size_t) file_stat.st_size;
+
+	if (length > 0)
+	{
+		void *data = 
+			mmap(NULL, length, protection, MAP_PRIVATE, file_descriptor, 0);
+
+		if (data == MAP_FAILED)
+		{
+			if (verbosity >= 1) 
+			{
+				fprintf(
+					stderr, 
+					"mapFileProtection: \nWarning! Could not map file \"%s\":"
+					" %s.\n", 
+					file_name,
+					strerror(errno)
+				);  
+			}
+			close(file_descriptor);
+
+			return false;
+		}
+
+		madvise(data, length, MADV_SEQUENTIAL);
+
+		*ret_mapped = (mapped_file_s) {(const char*) data, length, true};
+	}
+
+	// Mapping stays valid after the descriptor is closed:
+	close(file_descriptor);
+
+	return true;
+}
+
+bool mapFile(
+    const int32_t        verbosity, 
+    const char          *file_name, 
+          mapped_file_s *ret_mapped
+    ) {
+
+	/**
+     * Map a whole file read only into memory, so it can be parsed in place
+     * without any intermediate copies.
+     * @see mapFileProtection(), unmapFile().
+     * @return bool success: true if the file was opened and mapped.
+     */
+
+	return mapFileProtection(verbosity, file_name, PROT_READ, ret_mapped);
+}
+
+void unmapFile(
+	mapped_file_s *mapped
+	) {
+
+	if (mapped->is_mapped)
+	{
+		munmap((void*) mapped->data, mapped->length);
+	}
+
+	*mapped = (mapped_file_s) {"", 0, false};
+}
+
 bool createFile(
     const int32_t  verbosity, 
     const char    *file_name, 
@@ -548,7 +674,13 @@ void get_argf(
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
 
 	char* t = strtok(NULL, delimeter);
-	*val = strtof(t, NULL);
+	
+	// Like strtof, keeps the leading number of the field:
+	*val = 0.0f;
+	if (t != NULL)
+	{
+		parseFloatNumber(t, NULL, val, NULL);
+	}
 }
 
 int32_t countLinesInTextFile(
@@ -572,7 +704,7 @@ int32_t countLinesInTextFile(
 
 }
 
-bool readFileDouble(
+bool readFileDoubleStream(
 	const char     *file_name, 
 	const int32_t   mode, 
 	const char     *delimeter, 
@@ -585,7 +717,9 @@ bool readFileDouble(
 
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
 	//
-	// Reads delimited float data from input file.
+	// Reads delimited float data from input file
+	// line by line. Used by readFileDouble for
+	// files that cannot be mapped, such as pipes.
 	//
 	// Mode 0: Column index first. 
 	// Mode 1: Row index first.
@@ -634,7 +768,9 @@ bool readFileDouble(
 
 					char* first = strtok(buffer, delimeter);
 					
-					data[line_index*num_cols + 0] = strtof(first, NULL);
+					parseFloatNumber(
+						first, NULL, &data[line_index*num_cols + 0], NULL
+					);
 
 					//Skips to start column
 					float empty = 0;
@@ -683,7 +819,9 @@ bool readFileDouble(
 				{
 					char* first = strtok(buffer, delimeter);
 
-					data[line_index*num_cols + 0] = strtof(first, NULL);
+					parseFloatNumber(
+						first, NULL, &data[line_index*num_cols + 0], NULL
+					);
 
 					//Skips to start column
 					float empty = 0;
@@ -742,7 +880,651 @@ bool readFileDouble(
 	return success;
 }
 
-bool writeFileDouble(
+#define DELIMITED_CHUNK_SIZE ((size_t) 1 << 20)
+
+#ifndef DELIMITED_PARALLEL_MIN_BYTES
+#define DELIMITED_PARALLEL_MIN_BYTES ((size_t) 1 << 24)
+#endif
+
+#define DELIMITED_RANGES_PER_THREAD 4
+
+typedef struct DelimitedLayout {
+
+	/**
+     * Structure to hold where each field of a delimited text file is stored,
+	 * with the same meaning as the readFileDouble() arguments.
+     */
+
+	float   *data;
+	int32_t  mode;
+	int32_t  num_cols;
+	int32_t  num_lines;
+	int32_t  start_line;
+	int32_t  start_col;
+
+} delimited_layout_s;
+
+typedef struct DelimitedState {
+
+	/**
+     * Structure to hold the position of a delimited text scan between 
+	 * chunks, so lines and fields may straddle chunk boundaries.
+     */
+
+	size_t  field_start;
+	int64_t line;
+	int32_t field;
+
+} delimited_state_s;
+
+typedef struct DelimiterSet {
+
+	/**
+     * Structure to hold the field separators of a delimited text file, 
+	 * '\n' always included, as a byte table and as a list for SIMD compares.
+     */
+
+	bool    is_separator[256];
+	char    characters[16];
+	int32_t num_characters;
+
+} delimiter_set_s;
+
+delimiter_set_s createDelimiterSet(
+	const char *delimeter
+	) {
+
+	/**
+     * Build the separator set of a delimited text file. Like strtok, every
+	 * character of delimeter separates fields and repeats collapse.
+     * @param
+     *     const char *delimeter: field separator characters.
+     * @see findDelimitedStructure().
+     * @return delimiter_set_s set: separators with '\n' added.
+     */
+
+	delimiter_set_s set;
+	memset(&set, 0, sizeof(set));
+
+	set.is_separator['\n'] = true;
+
+	for (size_t index = 0; delimeter[index] != '\0'; index++)
+	{
+		set.is_separator[(uint8_t) delimeter[index]] = true;
+	}
+
+	for (int32_t index = 1; index < 256; index++)
+	{
+		if (set.is_separator[index])
+		{
+			// Longer sets keep working through the byte table alone:
+			if (set.num_characters < 16)
+			{
+				set.characters[set.num_characters] = (char) index;
+			}
+			set.num_characters++;
+		}
+	}
+
+	return set;
+}
+
+size_t countNewLines(
+	const char   *data,
+	const size_t  length
+	) {
+
+	/**
+     * Count the '\n' characters of a buffer, 32 or 16 bytes at a time.
+     * @param
+     *     const char   *data  : buffer to scan.
+     *     const size_t  length: length of buffer.
+     * @see countLinesInTextFile().
+     * @return size_t num_new_lines: number of '\n' characters.
+     */
+
+	size_t num_new_lines = 0;
+	size_t position      = 0;
+
+	#if defined(__AVX2__)
+	const __m256i new_line = _mm256_set1_epi8('\n');
+	for (; position + 32 <= length; position += 32)
+	{
+		const __m256i block = 
+			_mm256_loadu_si256((const __m256i*) &data[position]);
+		const uint32_t mask = (uint32_t) 
+			_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, new_line));
+
+		num_new_lines += (size_t) __builtin_popcount(mask);
+	}
+	#elif defined(__SSE2__)
+	const __m128i new_line = _mm_set1_epi8('\n');
+	for (; position + 16 <= length; position += 16)
+	{
+		const __m128i block = 
+			_mm_loadu_si128((const __m128i*) &data[position]);
+		const uint32_t mask = (uint32_t) 
+			_mm_movemask_epi8(_mm_cmpeq_epi8(block, new_line));
+
+		num_new_lines += (size_t) __builtin_popcount(mask);
+	}
+	#endif
+
+	for (; position < length; position++)
+	{
+		num_new_lines += (data[position] == '\n');
+	}
+
+	return num_new_lines;
+}
+
+size_t findDelimitedStructure(
+	const char            *data,
+	const size_t           begin,
+	const size_t           end,
+	const delimiter_set_s *set,
+	      uint32_t        *ret_index
+	) {
+
+	/**
+     * Record the offset of every separator between begin and end. Blocks of 
+	 * 32 bytes are compared against each separator with AVX2, or of 16 bytes
+	 * with a single SSE4.2 PCMPESTRM, and set bits are walked into the index.
+     * @param
+     *     const char            *data     : buffer to scan.
+     *     const size_t           begin    : first offset to scan.
+     *     const size_t           end      : offset to stop before, at most 
+	 *                                       DELIMITED_CHUNK_SIZE after begin.
+     *     const delimiter_set_s *set      : separator characters.
+     *           uint32_t        *ret_index: separator offsets from begin, 
+	 *                                       room for end - begin entries.
+     * @see convertDelimitedFields().
+     * @return size_t num_index: number of separators found.
+     */
+
+	size_t num_index = 0;
+	size_t position  = begin;
+
+	#if defined(__AVX2__)
+	if (set->num_characters <= 16)
+	{
+		__m256i separators[16];
+		for (int32_t index = 0; index < set->num_characters; index++)
+		{
+			separators[index] = _mm256_set1_epi8(set->characters[index]);
+		}
+
+		for (; position + 32 <= end; position += 32)
+		{
+			const __m256i block = 
+				_mm256_loadu_si256((const __m256i*) &data[position]);
+
+			__m256i matches = _mm256_cmpeq_epi8(block, separators[0]);
+			for (int32_t index = 1; index < set->num_characters; index++)
+			{
+				matches = 
+					_mm256_or_si256(
+						matches, _mm256_cmpeq_epi8(block, separators[index])
+					);
+			}
+
+			uint32_t mask = (uint32_t) _mm256_movemask_epi8(matches);
+			while (mask != 0)
+			{
+				ret_index[num_index++] = 
+					(uint32_t) (position - begin) + (uint32_t) __builtin_ctz(mask);
+				mask &= mask - 1;
+			}
+		}
+	}
+	#elif defined(__SSE4_2__)
+	if (set->num_characters <= 16)
+	{
+		__m128i separators = _mm_setzero_si128();
+		memcpy(&separators, set->characters, (size_t) set->num_characters);
+
+		for (; position + 16 <= end; position += 16)
+		{
+			const __m128i block = 
+				_mm_loadu_si128((const __m128i*) &data[position]);
+
+			uint32_t mask = (uint32_t)
+				_mm_cvtsi128_si32(
+					_mm_cmpestrm(
+						separators, set->num_characters, block, 16,
+						_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK
+					)
+				);
+			while (mask != 0)
+			{
+				ret_index[num_index++] = 
+					(uint32_t) (position - begin) + (uint32_t) __builtin_ctz(mask);
+				mask &= mask - 1;
+			}
+		}
+	}
+	#endif
+
+	for (; position < end; position++)
+	{
+		if (set->is_separator[(uint8_t) data[position]])
+		{
+			ret_index[num_index++] = (uint32_t) (position - begin);
+		}
+	}
+
+	return num_index;
+}
+
+static inline void storeDelimitedField(
+	const char               *data,
+	const size_t              field_start,
+	const size_t              field_end,
+	const int64_t             line,
+	const int32_t             field,
+	const delimited_layout_s *layout
+	) {
+
+	const int64_t row    = line - layout->start_line;
+	const int32_t column = field - layout->start_col;
+
+	if ((row < 0) || (column < 0) || (column >= layout->num_cols))
+	{
+		return;
+	}
+
+	// Like strtof, keeps the leading number of the field:
+	float value = 0.0f;
+	parseFloatNumber(&data[field_start], &data[field_end], &value, NULL);
+
+	const size_t element = (layout->mode == 0)
+		? (size_t) row * (size_t) layout->num_cols + (size_t) column
+		: (size_t) column * (size_t) layout->num_lines + (size_t) row;
+
+	layout->data[element] = value;
+}
+
+void convertDelimitedFields(
+	const char               *data,
+	const size_t              begin,
+	const uint32_t           *index,
+	const size_t              num_index,
+	const delimited_layout_s *layout,
+	      delimited_state_s  *state
+	) {
+
+	/**
+     * Convert every field between the separators found by 
+	 * findDelimitedStructure() and store the wanted ones into layout.
+     * @param
+     *     const char               *data     : buffer that was scanned.
+     *     const size_t              begin    : offset the index is relative 
+	 *                                          to.
+     *     const uint32_t           *index    : separator offsets.
+     *     const size_t              num_index: number of separator offsets.
+     *     const delimited_layout_s *layout   : where to store each field.
+     *           delimited_state_s  *state    : scan position, carried over
+	 *                                          to the next chunk.
+     * @see findDelimitedStructure(), readFileDouble().
+     * @return none
+     */
+
+	size_t  field_start = state->field_start;
+	int64_t line        = state->line;
+	int32_t field       = state->field;
+
+	for (size_t position = 0; position < num_index; position++)
+	{
+		const size_t separator = begin + index[position];
+
+		if (separator > field_start)
+		{
+			storeDelimitedField(
+				data, field_start, separator, line, field, layout
+			);
+			field++;
+		}
+
+		if (data[separator] == '\n')
+		{
+			line++;
+			field = 0;
+		}
+
+		field_start = separator + 1;
+	}
+
+	*state = (delimited_state_s) {field_start, line, field};
+}
+
+void readDelimitedRange(
+	const char               *data,
+	const size_t              begin,
+	const size_t              end,
+	const int64_t             first_line,
+	const delimiter_set_s    *set,
+	const delimited_layout_s *layout,
+	      uint32_t           *index
+	) {
+
+	/**
+     * Index and convert every field of a line aligned byte range, chunk by
+	 * chunk. Ranges own whole lines, so separate ranges may be read by 
+	 * separate threads into the same layout.
+     * @param
+     *     const char               *data      : mapped file.
+     *     const size_t              begin     : start of the first line.
+     *     const size_t              end       : just after the last '\n', or
+	 *                                           the end of the file.
+     *     const int64_t             first_line: file line at begin.
+     *     const delimiter_set_s    *set       : field separators.
+     *     const delimited_layout_s *layout    : where to store each field.
+     *           uint32_t           *index     : scratch for separator 
+	 *                                           offsets, room for 
+	 *                                           DELIMITED_CHUNK_SIZE, or 
+	 *                                           NULL to allocate one.
+     * @see findDelimitedStructure(), convertDelimitedFields().
+     * @return none
+     */
+
+	if (begin >= end)
+	{
+		return;
+	}
+
+	delimited_state_s state = {begin, first_line, 0};
+
+	uint32_t *owned_index = NULL;
+	if (index == NULL)
+	{
+		const size_t index_size = 
+			(end - begin < DELIMITED_CHUNK_SIZE) 
+			? end - begin 
+			: DELIMITED_CHUNK_SIZE;
+
+		owned_index = malloc(sizeof(uint32_t) * index_size);
+		index       = owned_index;
+	}
+
+	for (size_t chunk = begin; chunk < end; chunk += DELIMITED_CHUNK_SIZE)
+	{
+		const size_t chunk_end = 
+			(end - chunk < DELIMITED_CHUNK_SIZE) 
+			? end 
+			: chunk + DELIMITED_CHUNK_SIZE;
+
+		const size_t num_index = 
+			findDelimitedStructure(data, chunk, chunk_end, set, index);
+
+		convertDelimitedFields(
+			data, chunk, index, num_index, layout, &state
+		);
+	}
+
+	// Last field of a file without a final new line:
+	if (state.field_start < end)
+	{
+		storeDelimitedField(
+			data, state.field_start, end, state.line, state.field, layout
+		);
+	}
+
+	free(owned_index);
+}
+
+bool readMappedFileDouble(
+	const char           *file_name, 
+	const mapped_file_s  *mapped,
+	const int32_t         mode, 
+	const char           *delimeter, 
+	const int32_t         num_cols, 
+	const int32_t         start_line, 
+	const int32_t         start_col, 
+	const int32_t         num_ranges,
+	const int32_t         num_threads,
+		  float         **data_ret, 
+		  int32_t        *lines_read
+	) {
+
+	/**
+     * Read delimited float data from a mapped, non empty, file split into 
+	 * line aligned byte ranges. Lines are counted per range, an exclusive 
+	 * prefix sum gives each range its first line, and every range is then 
+	 * converted on an OpenMP thread straight into the output.
+     * @param
+     *     const mapped_file_s  *mapped     : mapped file to read.
+     *     const int32_t         num_ranges : number of ranges, 1 to read 
+	 *                                        serially.
+     *     const int32_t         num_threads: number of threads to use.
+	 *     see readFileDouble() for the rest.
+     * @see readFileDouble(), readFileDoubleParallel().
+     * @return bool success: true if the file was read.
+     */
+
+	const char   *data   = mapped->data;
+	const size_t  length = mapped->length;
+
+	size_t  boundaries[num_ranges + 1];
+	int64_t first_lines[num_ranges + 1];
+
+	// Snap each split to the start of the next line:
+	boundaries[0] = 0;
+	for (int32_t range = 1; range < num_ranges; range++)
+	{
+		size_t boundary = length / (size_t) num_ranges * (size_t) range;
+		if (boundary < boundaries[range - 1])
+		{
+			boundary = boundaries[range - 1];
+		}
+
+		if (   (boundary > 0) 
+			&& (boundary < length) 
+			&& (data[boundary - 1] != '\n')
+		) {
+			const char *new_line = 
+				memchr(&data[boundary], '\n', length - boundary);
+			boundary = 
+				(new_line != NULL) ? (size_t) (new_line - data) + 1 : length;
+		}
+
+		boundaries[range] = boundary;
+	}
+	boundaries[num_ranges] = length;
+
+	#pragma omp parallel for num_threads(num_threads) schedule(dynamic) \
+		if (num_ranges > 1)
+	for (int32_t range = 0; range < num_ranges; range++)
+	{
+		first_lines[range + 1] = (int64_t) 
+			countNewLines(
+				&data[boundaries[range]], 
+				boundaries[range + 1] - boundaries[range]
+			);
+	}
+
+	first_lines[0] = 0;
+	for (int32_t range = 0; range < num_ranges; range++)
+	{
+		first_lines[range + 1] += first_lines[range];
+	}
+
+	const size_t num_lines = 
+		(size_t) first_lines[num_ranges] + (data[length - 1] != '\n');
+
+	if (num_lines > INT32_MAX)
+	{
+		fprintf(
+			stderr, 
+			"readFileDouble: \nWarning! \"%s\" has %zu lines, more than can be"
+			" indexed! \n", 
+			file_name,
+			num_lines
+		);
+
+		return false;
+	}
+
+	float *output = 
+		calloc(num_lines * (size_t) num_cols + 1, sizeof(float));
+
+	const delimited_layout_s layout = 
+	{
+		.data       = output,
+		.mode       = mode,
+		.num_cols   = num_cols,
+		.num_lines  = (int32_t) num_lines,
+		.start_line = start_line,
+		.start_col  = start_col
+	};
+
+	const delimiter_set_s set = createDelimiterSet(delimeter);
+
+	// Ranges own whole lines, so their writes never overlap:
+	#pragma omp parallel for num_threads(num_threads) schedule(dynamic) \
+		if (num_ranges > 1)
+	for (int32_t range = 0; range < num_ranges; range++)
+	{
+		readDelimitedRange(
+			data, boundaries[range], boundaries[range + 1], 
+			first_lines[range], &set, &layout, NULL
+		);
+	}
+
+	*lines_read = 
+		((int32_t) num_lines > start_line) 
+		? (int32_t) num_lines - start_line 
+		: 0;
+	*data_ret = output;
+
+	return true;
+}
+
+bool readFileDouble(
+	const char     *file_name, 
+	const int32_t   mode, 
+	const char     *delimeter, 
+	const int32_t   num_cols, 
+	const int32_t   start_line, 
+	const int32_t   start_col, 
+		  float   **data_ret, 
+		  int32_t  *lines_read
+	) {
+
+	/**
+     * Read delimited float data from a file. The file is mapped, the exact 
+	 * number of lines counted with SIMD and the output allocated once. Each
+	 * chunk is then indexed with SIMD separator searches before its fields
+	 * are converted in bulk. Fields are split like strtok, missing ones are 
+	 * 0, and the layout matches readFileDoubleStream(), which is used for 
+	 * files that cannot be mapped. Files of DELIMITED_PARALLEL_MIN_BYTES or 
+	 * more are read on every OpenMP thread.
+     * @param
+     *     const char     *file_name : path of file to read.
+     *     const int32_t   mode      : 0 for data[line*num_cols + col],
+	 *                                 1 for data[col*num_lines + line], with
+	 *                                 num_lines counting all file lines.
+     *     const char     *delimeter : field separator characters.
+     *     const int32_t   num_cols  : number of columns to read.
+     *     const int32_t   start_line: lines to skip.
+     *     const int32_t   start_col : fields to skip on each line.
+     *           float   **data_ret  : read data, caller must free.
+     *           int32_t  *lines_read: number of lines read.
+     * @see readFileDoubleParallel(), readFileDoubleStream(), 
+	 *      writeFileDouble().
+     * @return bool success: true if the file was read.
+     */
+
+	mapped_file_s mapped;
+	if (!mapFile(3, file_name, &mapped))
+	{
+		return false;
+	}
+
+	if (mapped.length == 0)
+	{
+		// Pipes and special files report no size:
+		unmapFile(&mapped);
+
+		return 
+			readFileDoubleStream(
+				file_name, mode, delimeter, num_cols, start_line, start_col, 
+				data_ret, lines_read
+			);
+	}
+
+	const int32_t num_threads = 
+		(mapped.length >= DELIMITED_PARALLEL_MIN_BYTES) 
+		? omp_get_max_threads() 
+		: 1;
+
+	const bool success = 
+		readMappedFileDouble(
+			file_name, &mapped, mode, delimeter, num_cols, start_line, 
+			start_col, DELIMITED_RANGES_PER_THREAD * num_threads, num_threads,
+			data_ret, lines_read
+		);
+
+	unmapFile(&mapped);
+
+	return success;
+}
+
+bool readFileDoubleParallel(
+	const char     *file_name, 
+	const int32_t   mode, 
+	const char     *delimeter, 
+	const int32_t   num_cols, 
+	const int32_t   start_line, 
+	const int32_t   start_col, 
+	const int32_t   num_threads, 
+		  float   **data_ret, 
+		  int32_t  *lines_read
+	) {
+
+	/**
+     * Read delimited float data from a file on num_threads OpenMP threads, 
+	 * whatever its size, into the same layout as readFileDouble().
+     * @param
+     *     const int32_t num_threads: threads to use, 0 for 
+	 *                                omp_get_max_threads().
+	 *     see readFileDouble() for the rest.
+     * @see readFileDouble(), readMappedFileDouble().
+     * @return bool success: true if the file was read.
+     */
+
+	mapped_file_s mapped;
+	if (!mapFile(3, file_name, &mapped))
+	{
+		return false;
+	}
+
+	if (mapped.length == 0)
+	{
+		unmapFile(&mapped);
+
+		return 
+			readFileDoubleStream(
+				file_name, mode, delimeter, num_cols, start_line, start_col, 
+				data_ret, lines_read
+			);
+	}
+
+	const int32_t thread_count = 
+		(num_threads > 0) ? num_threads : omp_get_max_threads();
+
+	const bool success = 
+		readMappedFileDouble(
+			file_name, &mapped, mode, delimeter, num_cols, start_line, 
+			start_col, DELIMITED_RANGES_PER_THREAD * thread_count, 
+			thread_count, data_ret, lines_read
+		);
+
+	unmapFile(&mapped);
+
+	return success;
+}
+
+bool writeFileDoubleStream(
 	const float   *data          , 
 	const char    *file_name     , 
 	const int32_t  mode          , 
@@ -756,7 +1538,9 @@ bool writeFileDouble(
 
 	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
 	//
-	// Writes delimited float data to output file.
+	// Writes delimited float data to output file
+	// with printf formats, "%*e" in mode 0 and
+	// "%f" in mode 1.
 	//
 	//
 	// Mode 0: Column index first. 
@@ -863,6 +1647,449 @@ bool writeFileDouble(
 	return success;
 }
 
+#define BUFFERED_WRITER_SIZE ((size_t) 1 << 22)
+
+typedef struct BufferedWriter {
+
+	/**
+     * Structure to hold a file descriptor and the user space buffer output
+	 * is gathered in, so it reaches the kernel in a few large writes.
+     */
+
+	int     file_descriptor;
+	char   *buffer;
+	size_t  capacity;
+	size_t  used;
+	size_t  bytes_written;
+	bool    failed;
+	int     error; // errno of the first failed write or close.
+
+} buffered_writer_s;
+
+bool openBufferedWriter(
+    const int32_t            verbosity, 
+    const char              *file_name, 
+    const size_t             capacity,
+          buffered_writer_s *ret_writer
+    ) {
+
+	/**
+     * Create or truncate a file and attach an output buffer to it.
+     * @param
+     *     const int32_t            verbosity : verbosity level of warnings.
+     *     const char              *file_name : path of file to write.
+     *     const size_t             capacity  : buffer size, 0 for 
+	 *                                          BUFFERED_WRITER_SIZE.
+     *           buffered_writer_s *ret_writer: opened writer.
+     * @see writeBufferedBytes(), closeBufferedWriter().
+     * @return bool success: true if the file was opened.
+     */
+
+	const int file_descriptor = 
+		open(file_name, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+	if (file_descriptor < 0)
+	{
+		if (verbosity >= 1) 
+		{
+			fprintf(
+				stderr, 
+				"openBufferedWriter: \nWarning! Could not create file \"%s\":"
+				" %s.\n", 
+				file_name,
+				strerror(errno)
+			);  
+		}
+
+		return false;
+	}
+
+	const size_t buffer_size = 
+		(capacity > 0) ? capacity : BUFFERED_WRITER_SIZE;
+
+	*ret_writer = (buffered_writer_s)
+	{
+		.file_descriptor = file_descriptor,
+		.buffer          = malloc(buffer_size),
+		.capacity        = buffer_size,
+		.used            = 0,
+		.bytes_written   = 0,
+		.failed          = false,
+		.error           = 0
+	};
+
+	return true;
+}
+
+bool writeAllVectors(
+	      buffered_writer_s *writer,
+	      struct iovec      *vectors,
+	      int                num_vectors
+	) {
+
+	/**
+     * Hand every byte of the entered vectors to the kernel, resuming after 
+	 * partial writes and interruptions.
+     * @return bool success: false, and writer marked failed, on error.
+     */
+
+	while ((num_vectors > 0) && !writer->failed)
+	{
+		const ssize_t result = 
+			writev(writer->file_descriptor, vectors, num_vectors);
+
+		if (result < 0)
+		{
+			if (errno != EINTR)
+			{
+				writer->failed = true;
+				writer->error  = errno;
+			}
+			continue;
+		}
+
+		writer->bytes_written += (size_t) result;
+
+		size_t remaining = (size_t) result;
+		while ((num_vectors > 0) && (remaining >= vectors->iov_len))
+		{
+			remaining -= vectors->iov_len;
+			vectors++;
+			num_vectors--;
+		}
+
+		if (num_vectors > 0)
+		{
+			vectors->iov_base  = (char*) vectors->iov_base + remaining;
+			vectors->iov_len  -= remaining;
+		}
+	}
+
+	return !writer->failed;
+}
+
+bool flushBufferedWriter(
+	buffered_writer_s *writer
+	) {
+
+	/**
+     * Write out everything gathered in the buffer.
+     * @see closeBufferedWriter().
+     * @return bool success: false if any write has failed.
+     */
+
+	struct iovec vector = {writer->buffer, writer->used};
+	writer->used = 0;
+
+	return writeAllVectors(writer, &vector, (vector.iov_len > 0));
+}
+
+static inline char *reserveBufferedWriter(
+	      buffered_writer_s *writer,
+	const size_t             length
+	) {
+
+	/**
+     * Return room for length bytes at the end of the buffer, flushing first
+	 * if needed. Callers advance writer->used by what they actually write.
+     */
+
+	if (writer->used + length > writer->capacity)
+	{
+		flushBufferedWriter(writer);
+
+		if (length > writer->capacity)
+		{
+			writer->capacity = length;
+			writer->buffer   = realloc(writer->buffer, length);
+		}
+	}
+
+	return &writer->buffer[writer->used];
+}
+
+void writeBufferedBytes(
+	      buffered_writer_s *writer,
+	const void              *data,
+	const size_t             length
+	) {
+
+	/**
+     * Append bytes to the writer. Blocks larger than the buffer skip the 
+	 * copy and go out in one writev() together with the buffered bytes.
+     * @see reserveBufferedWriter(), flushBufferedWriter().
+     * @return none
+     */
+
+	if (length > writer->capacity - writer->used)
+	{
+		if (length >= writer->capacity)
+		{
+			struct iovec vectors[2] = 
+			{
+				{writer->buffer, writer->used},
+				{(void*) data  , length      }
+			};
+			writer->used = 0;
+
+			writeAllVectors(writer, vectors, 2);
+
+			return;
+		}
+
+		flushBufferedWriter(writer);
+	}
+
+	memcpy(&writer->buffer[writer->used], data, length);
+	writer->used += length;
+}
+
+bool closeBufferedWriter(
+	buffered_writer_s *writer
+	) {
+
+	/**
+     * Flush and close the file and release the buffer.
+     * @see openBufferedWriter().
+     * @return bool success: true if every byte was written, otherwise 
+	 *                       writer->error holds the errno of the failure.
+     */
+
+	flushBufferedWriter(writer);
+
+	if ((close(writer->file_descriptor) != 0) && !writer->failed)
+	{
+		writer->failed = true;
+		writer->error  = errno;
+	}
+	free(writer->buffer);
+
+	writer->file_descriptor = -1;
+	writer->buffer          = NULL;
+	writer->capacity        = 0;
+
+	return !writer->failed;
+}
+
+typedef struct SourceStamp {
+
+	/**
+     * Structure to hold the modification time and size of a source file, 
+	 * stored in a sidecar derived from it to tell when the sidecar is stale.
+     */
+
+	int64_t mtime_sec;
+	int64_t mtime_nsec;
+	int64_t size;
+
+} source_stamp_s;
+
+source_stamp_s getSourceStamp(
+	const struct stat *source_stat
+	) {
+
+	return (source_stamp_s)
+	{
+		.mtime_sec  = (int64_t) source_stat->st_mtim.tv_sec,
+		.mtime_nsec = (int64_t) source_stat->st_mtim.tv_nsec,
+		.size       = (int64_t) source_stat->st_size
+	};
+}
+
+bool checkSourceStamp(
+	const source_stamp_s  stamp,
+	const struct stat    *source_stat
+	) {
+
+	/**
+     * Check a stored stamp against the current stat of its source.
+     * @see getSourceStamp().
+     * @return bool current: true if the source is unchanged since stamped.
+     */
+
+	const source_stamp_s current = getSourceStamp(source_stat);
+
+	return (stamp.mtime_sec  == current.mtime_sec ) 
+		&& (stamp.mtime_nsec == current.mtime_nsec) 
+		&& (stamp.size       == current.size      );
+}
+
+bool writeFileAtomic(
+	const char         *file_name,
+	const struct iovec *parts,
+	const int32_t       num_parts
+	) {
+
+	/**
+     * Write parts, in order, to a temporary file next to file_name and 
+	 * rename it into place, so readers never see a partial file.
+     * @param
+     *     const char         *file_name: path of file to write.
+     *     const struct iovec *parts    : bytes to write.
+     *     const int32_t       num_parts: number of parts.
+     * @see openBufferedWriter().
+     * @return bool success: true if file_name now holds every part.
+     */
+
+	char temporary_name[strlen(file_name) + 32];
+	snprintf(
+		temporary_name,
+		sizeof(temporary_name),
+		"%s.%ld.tmp",
+		file_name,
+		(long) getpid()
+	);
+
+	buffered_writer_s writer;
+	if (!openBufferedWriter(0, temporary_name, 0, &writer))
+	{
+		return false;
+	}
+
+	for (int32_t part = 0; part < num_parts; part++)
+	{
+		writeBufferedBytes(&writer, parts[part].iov_base, parts[part].iov_len);
+	}
+
+	bool pass = closeBufferedWriter(&writer);
+	pass = pass && (rename(temporary_name, file_name) == 0);
+
+	if (!pass)
+	{
+		remove(temporary_name);
+	}
+
+	return pass;
+}
+
+static inline void writeBufferedFloat(
+	      buffered_writer_s *writer,
+	const float              value,
+	const bool               scientific,
+	const int32_t            width,
+	const char              *delimeter,
+	const size_t             delimeter_length
+	) {
+
+	/**
+     * Append value, right aligned to at least width characters, followed by
+	 * the delimiter. Formats straight into the buffer.
+     */
+
+	const size_t padding = (width > 0) ? (size_t) width : 0;
+	char *output = 
+		reserveBufferedWriter(writer, padding + 64 + delimeter_length);
+
+	const size_t length = formatFloatNumber(value, scientific, output);
+
+	if (length < padding)
+	{
+		memmove(&output[padding - length], output, length);
+		memset(output, ' ', padding - length);
+		writer->used += padding;
+	}
+	else
+	{
+		writer->used += length;
+	}
+
+	memcpy(&writer->buffer[writer->used], delimeter, delimeter_length);
+	writer->used += delimeter_length;
+}
+
+bool writeFileDouble(
+	const float   *data          , 
+	const char    *file_name     , 
+	const int32_t  mode          , 
+	const int32_t  decimal_places, 
+	const char    *delimeter     , 
+	const int32_t  num_cols      , 
+	const int32_t  num_lines     , 
+	const int32_t  start_line    , 
+	const int32_t  start_col
+	) {
+
+	/**
+     * Write delimited float data to a file with the same layout as 
+	 * writeFileDoubleStream(), but each value as the shortest text that 
+	 * reads back exactly. Values are formatted straight into a user space 
+	 * buffer which is flushed with write(), so no printf format parsing or 
+	 * stdio locking happens per element.
+     * @param
+     *     const float   *data          : values to write.
+     *     const char    *file_name     : path of file to write.
+     *     const int32_t  mode          : 0 for data[line*num_cols + col] 
+	 *                                    in scientific notation, 1 for 
+	 *                                    data[col*num_lines + line] in 
+	 *                                    positional notation.
+     *     const int32_t  decimal_places: minimum width of each value in 
+	 *                                    mode 0, as with "%*e".
+     *     const char    *delimeter     : written after every value.
+     *     const int32_t  num_cols      : number of columns.
+     *     const int32_t  num_lines     : number of lines.
+     *     const int32_t  start_line    : empty lines written first.
+     *     const int32_t  start_col     : start_col - 1 delimiters begin each
+	 *                                    line.
+     * @see writeFileDoubleStream(), formatFloatNumber(), readFileDouble().
+     * @return bool success: true if every byte was written.
+     */
+
+	buffered_writer_s writer;
+	if (!openBufferedWriter(1, file_name, 0, &writer))
+	{
+		fprintf(stderr, "Warning! Failed to create file \"%s\"!\n", file_name);
+
+		return false;
+	}
+
+	const size_t  delimeter_length = strlen(delimeter);
+	const bool    scientific       = (mode == 0);
+	const int32_t width            = scientific ? decimal_places : 0;
+
+	//Skips to start line:
+	for (int32_t line_index = 0; line_index < start_line; ++line_index) 
+	{ 
+		writeBufferedBytes(&writer, "\n", 1);
+	}
+
+	for (int32_t line_index = 0; line_index < num_lines; line_index++)
+	{
+		//Skips to start column
+		for (int32_t col_index = 1; col_index < start_col; ++col_index) 
+		{ 
+			writeBufferedBytes(&writer, delimeter, delimeter_length);
+		}
+
+		for (int32_t col_index = 0; col_index < num_cols; ++col_index) 
+		{ 
+			const size_t element = scientific
+				? (size_t) line_index * (size_t) num_cols + (size_t) col_index
+				: (size_t) col_index * (size_t) num_lines + (size_t) line_index;
+
+			writeBufferedFloat(
+				&writer, data[element], scientific, width, delimeter, 
+				delimeter_length
+			);
+		}
+
+		writeBufferedBytes(&writer, "\n", 1);
+	}
+
+	const bool success = closeBufferedWriter(&writer);
+
+	if (!success)
+	{
+		fprintf(
+			stderr, 
+			"writeFileDouble: \nWarning! Failed to write file \"%s\": %s.\n", 
+			file_name,
+			strerror(writer.error)
+		);
+	}
+
+	return success;
+}
+
 bool readDirectoryContents(
 	const char      *directory_name, 
 	      char    ***strings_ret, 
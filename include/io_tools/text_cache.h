@@ -0,0 +1,346 @@
+#ifndef IO_TEXT_CACHE_H
+#define IO_TEXT_CACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <inttypes.h>
+
+#include "io_tools/text.h"
+
+#define FLOAT_CACHE_MAGIC         "F32CACH"
+#define FLOAT_CACHE_VERSION       ((uint32_t) 1)
+#define FLOAT_CACHE_ALIGNMENT     ((size_t) 64)
+#define FLOAT_CACHE_EXTENSION     ".f32cache"
+#define FLOAT_CACHE_MAX_DELIMETER 32
+
+typedef struct FloatCacheHeader {
+
+	/**
+     * Structure to hold the header at the start of a float cache sidecar.
+	 * The floats follow at data_offset in the layout readFileDouble() 
+	 * returned for the stored arguments.
+     */
+
+	char     magic[8];
+	uint32_t version;
+
+	// Arguments the data was read with:
+	int32_t  mode;
+	int32_t  num_cols;
+	int32_t  start_line;
+	int32_t  start_col;
+	char     delimeter[FLOAT_CACHE_MAX_DELIMETER];
+
+	int32_t  lines_read;
+	int32_t  num_lines;
+
+	// Validity of the cache:
+	source_stamp_s source;
+
+	uint64_t data_offset;
+	uint64_t num_elements;
+	uint64_t total_size;
+
+} float_cache_header_s;
+
+typedef struct FloatCache {
+
+	/**
+     * Structure to hold delimited float data read through a sidecar cache.
+	 * data points into the mapped sidecar on a hit, or into owned_data when
+	 * the text had to be parsed, and stays valid until freeFloatCache().
+     */
+
+	mapped_file_s  mapped;
+	const float   *data;
+	float         *owned_data;
+
+	int32_t        lines_read;
+	int32_t        num_lines;
+	bool           is_cached;
+
+} float_cache_s;
+
+size_t getFloatCacheElements(
+	const int32_t mode,
+	const int32_t num_cols,
+	const int32_t start_line,
+	const int32_t lines_read
+	) {
+
+	/**
+     * Return the number of floats that hold data in a readFileDouble() 
+	 * result. Mode 1 columns are strided by every line of the file.
+     */
+
+	if (lines_read <= 0)
+	{
+		return 0;
+	}
+
+	const size_t num_lines = (mode == 0) 
+		? (size_t) lines_read 
+		: (size_t) lines_read + (size_t) start_line;
+
+	return num_lines * (size_t) num_cols;
+}
+
+bool writeFloatCache(
+	const int32_t      verbosity,
+	const char        *cache_name,
+	const struct stat *source_stat,
+	const int32_t      mode, 
+	const char        *delimeter, 
+	const int32_t      num_cols, 
+	const int32_t      start_line, 
+	const int32_t      start_col, 
+	const float       *data,
+	const int32_t      lines_read
+	) {
+
+	/**
+     * Write the result of a readFileDouble() call to a sidecar, aligned for
+	 * SIMD loads once mapped, with writeFileAtomic().
+     * @param
+     *     const int32_t      verbosity  : verbosity level of warnings.
+     *     const char        *cache_name : path of sidecar to write.
+     *     const struct stat *source_stat: stat of the text file, taken before
+	 *                                     it was read.
+     *     const float       *data       : data read from the text file.
+     *     const int32_t      lines_read : lines read from the text file.
+	 *     see readFileDouble() for the rest.
+     * @see loadFloatCache(), readFileDoubleCached().
+     * @return bool success: true if the sidecar was written.
+     */
+
+	const size_t num_elements = 
+		getFloatCacheElements(mode, num_cols, start_line, lines_read);
+	const size_t data_offset  = 
+		(sizeof(float_cache_header_s) + FLOAT_CACHE_ALIGNMENT - 1) 
+		& ~(FLOAT_CACHE_ALIGNMENT - 1);
+
+	float_cache_header_s header =
+	{
+		.magic             = FLOAT_CACHE_MAGIC,
+		.version           = FLOAT_CACHE_VERSION,
+		.mode              = mode,
+		.num_cols          = num_cols,
+		.start_line        = start_line,
+		.start_col         = start_col,
+		.lines_read        = lines_read,
+		.num_lines         = 
+			(lines_read > 0) ? lines_read + start_line : 0,
+		.source            = getSourceStamp(source_stat),
+		.data_offset       = data_offset,
+		.num_elements      = num_elements,
+		.total_size        = data_offset + sizeof(float) * num_elements
+	};
+	strncpy(header.delimeter, delimeter, FLOAT_CACHE_MAX_DELIMETER - 1);
+
+	const uint8_t padding[FLOAT_CACHE_ALIGNMENT] = {0};
+
+	const struct iovec parts[3] =
+	{
+		{&header        , sizeof(header)               },
+		{(void*) padding, data_offset - sizeof(header) },
+		{(void*) data   , sizeof(float) * num_elements }
+	};
+
+	const bool pass = writeFileAtomic(cache_name, parts, 3);
+
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(
+			stderr,
+			"writeFloatCache: \nWarning! Could not write cache \"%s\". \n",
+			cache_name
+		);
+	}
+
+	return pass;
+}
+
+bool loadFloatCache(
+	const int32_t        verbosity,
+	const char          *cache_name,
+	const struct stat   *source_stat,
+	const int32_t        mode, 
+	const char          *delimeter, 
+	const int32_t        num_cols, 
+	const int32_t        start_line, 
+	const int32_t        start_col, 
+	      float_cache_s *ret_cache
+	) {
+
+	/**
+     * Map a sidecar written by writeFloatCache(). It is rejected if the text
+	 * file's mtime or size, or any of the read arguments, no longer match 
+	 * those it was written with.
+     * @param
+     *     const int32_t        verbosity  : verbosity level of warnings.
+     *     const char          *cache_name : path of sidecar.
+     *     const struct stat   *source_stat: current stat of the text file.
+     *           float_cache_s *ret_cache  : cache pointing into the mapping.
+	 *     see readFileDouble() for the rest.
+     * @see writeFloatCache(), freeFloatCache().
+     * @return bool success: true if the sidecar was valid and mapped.
+     */
+
+	mapped_file_s mapped;
+	if (!mapFile(verbosity > 1 ? verbosity : 0, cache_name, &mapped))
+	{
+		return false;
+	}
+
+	float_cache_header_s header;
+
+	bool valid = (mapped.length >= sizeof(header));
+	if (valid)
+	{
+		memcpy(&header, mapped.data, sizeof(header));
+
+		valid =
+			   !memcmp(header.magic, FLOAT_CACHE_MAGIC, sizeof(header.magic))
+			&& (header.version           == FLOAT_CACHE_VERSION)
+			&& (header.total_size        == mapped.length)
+			&& checkSourceStamp(header.source, source_stat)
+			&& (header.mode              == mode)
+			&& (header.num_cols          == num_cols)
+			&& (header.start_line        == start_line)
+			&& (header.start_col         == start_col)
+			&& !strncmp(
+				header.delimeter, delimeter, FLOAT_CACHE_MAX_DELIMETER
+			)
+			&& ((header.data_offset % FLOAT_CACHE_ALIGNMENT) == 0)
+			&& (header.num_elements == 
+				getFloatCacheElements(
+					mode, num_cols, start_line, header.lines_read
+				))
+			&& (header.data_offset + sizeof(float) * header.num_elements
+				== mapped.length);
+	}
+
+	if (!valid)
+	{
+		if (verbosity > 1)
+		{
+			fprintf(
+				stderr,
+				"loadFloatCache: \nCache \"%s\" is stale, text must be "
+				"re-read. \n",
+				cache_name
+			);
+		}
+		unmapFile(&mapped);
+
+		return false;
+	}
+
+	*ret_cache = (float_cache_s)
+	{
+		.mapped     = mapped,
+		.data       = 
+			(header.num_elements > 0) 
+			? (const float*) &mapped.data[header.data_offset] 
+			: NULL,
+		.owned_data = NULL,
+		.lines_read = header.lines_read,
+		.num_lines  = header.num_lines,
+		.is_cached  = true
+	};
+
+	return true;
+}
+
+bool readFileDoubleCached(
+	const int32_t         verbosity,
+	const char           *file_name, 
+	const int32_t         mode, 
+	const char           *delimeter, 
+	const int32_t         num_cols, 
+	const int32_t         start_line, 
+	const int32_t         start_col, 
+		  float_cache_s  *ret_cache
+	) {
+
+	/**
+     * Read delimited float data like readFileDouble(), through a binary 
+	 * sidecar next to the text file. A valid sidecar is mapped and used in 
+	 * place without parsing; otherwise the text is parsed and the sidecar 
+	 * written for next time.
+     * @param
+     *     const int32_t         verbosity: verbosity level of warnings.
+     *           float_cache_s  *ret_cache: read data, free with 
+	 *                                      freeFloatCache().
+	 *     see readFileDouble() for the rest.
+     * @see readFileDouble(), freeFloatCache().
+     * @return bool success: true if the data was read.
+     */
+
+	*ret_cache = (float_cache_s) {.data = NULL, .mapped = {"", 0, false}};
+
+	struct stat source_stat;
+	const bool cacheable = 
+		   (stat(file_name, &source_stat) == 0) 
+		&& S_ISREG(source_stat.st_mode)
+		&& (strlen(delimeter) < FLOAT_CACHE_MAX_DELIMETER);
+
+	char cache_name[strlen(file_name) + sizeof(FLOAT_CACHE_EXTENSION)];
+	snprintf(
+		cache_name, sizeof(cache_name), "%s%s", file_name, 
+		FLOAT_CACHE_EXTENSION
+	);
+
+	if (   cacheable 
+		&& loadFloatCache(
+			verbosity, cache_name, &source_stat, mode, delimeter, num_cols, 
+			start_line, start_col, ret_cache
+		)
+	) {
+		return true;
+	}
+
+	float   *data       = NULL;
+	int32_t  lines_read = 0;
+
+	if (!readFileDouble(
+			file_name, mode, delimeter, num_cols, start_line, start_col, 
+			&data, &lines_read
+		)
+	) {
+		return false;
+	}
+
+	if (cacheable)
+	{
+		writeFloatCache(
+			verbosity, cache_name, &source_stat, mode, delimeter, num_cols, 
+			start_line, start_col, data, lines_read
+		);
+	}
+
+	ret_cache->data       = data;
+	ret_cache->owned_data = data;
+	ret_cache->lines_read = lines_read;
+	ret_cache->num_lines  = (lines_read > 0) ? lines_read + start_line : 0;
+	ret_cache->is_cached  = false;
+
+	return true;
+}
+
+void freeFloatCache(
+	float_cache_s *cache
+	) {
+
+	free(cache->owned_data);
+	unmapFile(&cache->mapped);
+
+	*cache = (float_cache_s) {.data = NULL, .mapped = {"", 0, false}};
+}
+
+#endif
@@ -0,0 +1,425 @@
+#ifndef IO_TEXT_STREAM_H
+#define IO_TEXT_STREAM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <inttypes.h>
+
+#include "io_tools/text.h"
+#include "io_tools/async_io.h"
+
+#define DELIMITED_SEGMENT_SIZE  ((size_t) 1 << 22)
+#define DELIMITED_NUM_SEGMENTS  3
+
+typedef struct DelimitedBatch {
+
+	/**
+     * Structure to hold a batch of rows parsed from a delimited stream. In
+	 * mode 0 row r, column c is data[r*num_cols + c], in mode 1 it is
+	 * data[c*num_rows + r]. Valid until the next batch is requested.
+     */
+
+	const float *data;
+	int32_t      num_rows;
+	int32_t      num_cols;
+	int32_t      mode;
+
+	// Row of the first line in the batch, counted from start_line:
+	int64_t      first_row;
+
+} delimited_batch_s;
+
+typedef struct DelimitedStreamStats {
+
+	/**
+     * Structure to hold the progress of a delimited stream.
+     */
+
+	uint64_t bytes_read;
+	uint64_t bytes_processed;
+	int64_t  lines_processed;
+	int64_t  rows_delivered;
+	int64_t  batches_delivered;
+
+} delimited_stream_stats_s;
+
+typedef struct DelimitedStream {
+
+	/**
+     * Structure to hold a delimited file being parsed in batches with
+	 * bounded memory. Raw text passes through a ring of fixed size segments
+	 * read ahead asynchronously, so the disk is busy while a segment is
+	 * parsed, and the line left unfinished at the end of a segment is
+	 * carried over to the next.
+     */
+
+	const char               *file_name;
+
+	delimiter_set_s           set;
+	int32_t                   mode;
+	int32_t                   num_cols;
+	int32_t                   start_line;
+	int32_t                   start_col;
+
+	// Ring of raw text segments:
+	async_reader_s            reader;
+
+	// Unfinished line carried between segments:
+	char                     *carry;
+	size_t                    carry_length;
+	size_t                    carry_capacity;
+
+	uint32_t                 *index;
+	float                    *batch_data;
+	size_t                    batch_capacity;
+
+	int64_t                   line;
+	bool                      failed;
+
+	delimited_stream_stats_s  stats;
+
+} delimited_stream_s;
+
+typedef bool (*delimited_batch_callback_f)(
+	const delimited_batch_s *batch,
+	      void              *user_data
+);
+
+bool openDelimitedStream(
+	const int32_t             verbosity,
+	const char               *file_name,
+	const int32_t             mode,
+	const char               *delimeter,
+	const int32_t             num_cols,
+	const int32_t             start_line,
+	const int32_t             start_col,
+	const size_t              segment_size,
+	const int32_t             num_segments,
+	      delimited_stream_s *ret_stream
+	) {
+
+	/**
+     * Open a delimited file for reading in batches. Memory use is bounded by
+	 * the ring, the longest line and the rows of one segment, whatever the
+	 * size of the file.
+     * @param
+     *     const int32_t             verbosity   : verbosity level of warnings.
+     *     const size_t              segment_size: bytes per ring segment, 0
+	 *                                             for DELIMITED_SEGMENT_SIZE.
+     *     const int32_t             num_segments: segments in the ring, at
+	 *                                             least 2, 0 for
+	 *                                             DELIMITED_NUM_SEGMENTS.
+     *           delimited_stream_s *ret_stream  : opened stream.
+	 *     see readFileDouble() for the rest.
+     * @see nextDelimitedBatch(), closeDelimitedStream(), streamFileDouble().
+     * @return bool success: true if the file was opened.
+     */
+
+	const size_t  segment_bytes =
+		(segment_size > 0) ? segment_size : DELIMITED_SEGMENT_SIZE;
+	const int32_t segment_count =
+		(num_segments > 1) ? num_segments : DELIMITED_NUM_SEGMENTS;
+
+	async_reader_s reader;
+	if (!openAsyncReader(
+			verbosity, file_name, async_auto_e, segment_bytes, segment_count,
+			&reader
+		)
+	) {
+		return false;
+	}
+
+	*ret_stream = (delimited_stream_s)
+	{
+		.file_name       = file_name,
+		.set             = createDelimiterSet(delimeter),
+		.mode            = mode,
+		.num_cols        = num_cols,
+		.start_line      = start_line,
+		.start_col       = start_col,
+		.reader          = reader,
+		.carry           = NULL,
+		.carry_length    = 0,
+		.carry_capacity  = 0,
+		.index           = malloc(sizeof(uint32_t) * DELIMITED_CHUNK_SIZE),
+		.batch_data      = NULL,
+		.batch_capacity  = 0,
+		.line            = 0,
+		.failed          = false,
+		.stats           = {0, 0, 0, 0, 0}
+	};
+
+	return true;
+}
+
+const char *fillDelimitedSegment(
+	delimited_stream_s *stream,
+	size_t             *ret_length
+	) {
+
+	/**
+     * Take the next segment of the file from the read ahead ring. The
+	 * previous segment goes back to the ring, so must no longer be used.
+     * @return const char *text: segment contents, NULL at the end of the
+	 *                           file.
+     */
+
+	const char *text = nextAsyncBlock(&stream->reader, ret_length);
+
+	if ((text == NULL) && stream->reader.failed && !stream->failed)
+	{
+		fprintf(
+			stderr,
+			"fillDelimitedSegment: \nWarning! Could not read \"%s\".\n",
+			stream->file_name
+		);
+		stream->failed = true;
+	}
+
+	stream->stats.bytes_read += *ret_length;
+
+	return text;
+}
+
+void appendDelimitedCarry(
+	      delimited_stream_s *stream,
+	const char               *text,
+	const size_t              length
+	) {
+
+	if (stream->carry_length + length > stream->carry_capacity)
+	{
+		stream->carry_capacity = 2*(stream->carry_length + length);
+		stream->carry = realloc(stream->carry, stream->carry_capacity);
+	}
+
+	memcpy(&stream->carry[stream->carry_length], text, length);
+	stream->carry_length += length;
+}
+
+bool nextDelimitedBatch(
+	delimited_stream_s *stream,
+	delimited_batch_s  *ret_batch
+	) {
+
+	/**
+     * Pull the rows of the next ring segment. Reading runs at most the ring
+	 * ahead of parsing, so a slow consumer holds the reader back rather than
+	 * letting unread data pile up.
+     * @param
+     *     delimited_stream_s *stream   : stream to read from.
+     *     delimited_batch_s  *ret_batch: parsed rows, valid until the next
+	 *                                    call.
+     * @see openDelimitedStream(), streamFileDouble().
+     * @return bool more: false once every row has been delivered.
+     */
+
+	while (true)
+	{
+		size_t      length = 0;
+		const char *text   = fillDelimitedSegment(stream, &length);
+
+		// Whole lines are the carried line plus text up to the last '\n':
+		const char *first_new_line =
+			(length > 0) ? memchr(text, '\n', length) : NULL;
+
+		size_t body_begin = 0;
+		size_t body_end   = 0;
+
+		if (first_new_line == NULL)
+		{
+			if (length > 0)
+			{
+				appendDelimitedCarry(stream, text, length);
+				continue;
+			}
+		}
+		else
+		{
+			body_end = length;
+			while (text[body_end - 1] != '\n')
+			{
+				body_end--;
+			}
+
+			if (stream->carry_length > 0)
+			{
+				body_begin = (size_t) (first_new_line - text) + 1;
+				appendDelimitedCarry(stream, text, body_begin);
+			}
+		}
+
+		// At the end of the file an unfinished line still counts:
+		const int64_t num_carry_lines = (stream->carry_length > 0);
+		const int64_t num_lines       =
+			num_carry_lines
+			+ ((body_end > body_begin)
+				? (int64_t) countNewLines(
+					&text[body_begin], body_end - body_begin
+				)
+				: 0);
+
+		if (num_lines == 0)
+		{
+			ret_batch->num_rows = 0;
+
+			return false;
+		}
+
+		const int64_t first_line = stream->line;
+		const int64_t first_kept =
+			(first_line > stream->start_line) ? first_line : stream->start_line;
+		const int64_t num_rows   =
+			(first_line + num_lines > first_kept)
+			? first_line + num_lines - first_kept
+			: 0;
+
+		if ((size_t) num_rows > stream->batch_capacity)
+		{
+			stream->batch_capacity = (size_t) num_rows;
+			free(stream->batch_data);
+			stream->batch_data =
+				malloc(
+					sizeof(float) * stream->batch_capacity
+					* (size_t) stream->num_cols
+				);
+		}
+		if (num_rows > 0)
+		{
+			memset(
+				stream->batch_data, 0,
+				sizeof(float) * (size_t) num_rows * (size_t) stream->num_cols
+			);
+		}
+
+		const delimited_layout_s layout =
+		{
+			.data       = stream->batch_data,
+			.mode       = stream->mode,
+			.num_cols   = stream->num_cols,
+			.num_lines  = (int32_t) num_rows,
+			.start_line = (int32_t) first_kept,
+			.start_col  = stream->start_col
+		};
+
+		if (num_carry_lines > 0)
+		{
+			readDelimitedRange(
+				stream->carry, 0, stream->carry_length, first_line,
+				&stream->set, &layout, stream->index
+			);
+		}
+
+		readDelimitedRange(
+			text, body_begin, body_end, first_line + num_carry_lines,
+			&stream->set, &layout, stream->index
+		);
+
+		stream->stats.bytes_processed +=
+			stream->carry_length + (body_end - body_begin);
+		stream->stats.lines_processed += num_lines;
+
+		// Text after the last '\n' starts the next carried line:
+		stream->carry_length = 0;
+		if (body_end > 0)
+		{
+			appendDelimitedCarry(stream, &text[body_end], length - body_end);
+		}
+
+		stream->line += num_lines;
+
+		if (num_rows == 0)
+		{
+			continue;
+		}
+
+		stream->stats.rows_delivered    += num_rows;
+		stream->stats.batches_delivered++;
+
+		*ret_batch = (delimited_batch_s)
+		{
+			.data      = stream->batch_data,
+			.num_rows  = (int32_t) num_rows,
+			.num_cols  = stream->num_cols,
+			.mode      = stream->mode,
+			.first_row = first_kept - stream->start_line
+		};
+
+		return true;
+	}
+}
+
+void closeDelimitedStream(
+	delimited_stream_s *stream
+	) {
+
+	closeAsyncReader(&stream->reader);
+
+	free(stream->carry);
+	free(stream->index);
+	free(stream->batch_data);
+
+	stream->carry      = NULL;
+	stream->index      = NULL;
+	stream->batch_data = NULL;
+}
+
+bool streamFileDouble(
+	const int32_t                    verbosity,
+	const char                      *file_name,
+	const int32_t                    mode,
+	const char                      *delimeter,
+	const int32_t                    num_cols,
+	const int32_t                    start_line,
+	const int32_t                    start_col,
+	const delimited_batch_callback_f callback,
+	      void                      *user_data,
+	      delimited_stream_stats_s  *ret_stats
+	) {
+
+	/**
+     * Parse a delimited file of any size with bounded memory, handing each
+	 * batch of rows to callback before the next is read. The callback
+	 * returns false to stop early.
+     * @param
+     *     const int32_t                    verbosity: verbosity level of
+	 *                                                 warnings.
+     *     const delimited_batch_callback_f callback : called with each batch.
+     *           void                      *user_data: passed to callback.
+     *           delimited_stream_stats_s  *ret_stats: bytes and rows
+	 *                                                 processed, may be
+	 *                                                 NULL.
+	 *     see readFileDouble() for the rest.
+     * @see nextDelimitedBatch(), readFileDouble().
+     * @return bool success: true if the file was read without errors.
+     */
+
+	delimited_stream_s stream;
+	if (!openDelimitedStream(
+			verbosity, file_name, mode, delimeter, num_cols, start_line,
+			start_col, 0, 0, &stream
+		)
+	) {
+		return false;
+	}
+
+	delimited_batch_s batch;
+	while (nextDelimitedBatch(&stream, &batch) && callback(&batch, user_data))
+	{
+	}
+
+	if (ret_stats != NULL)
+	{
+		*ret_stats = stream.stats;
+	}
+
+	const bool success = !stream.failed;
+	closeDelimitedStream(&stream);
+
+	return success;
+}
+
+#endif
@@ -0,0 +1,544 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <inttypes.h>
+
+#include "config.h"
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+//
+// Allocation counting. Defining the allocator here interposes it on every
+// call in the process, including those made inside libc.
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t num, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void  __libc_free(void *pointer);
+
+static uint64_t bench_num_allocations = 0;
+static uint64_t bench_bytes_allocated = 0;
+
+void *malloc(
+	size_t size
+	) {
+
+	__atomic_fetch_add(&bench_num_allocations, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&bench_bytes_allocated, size, __ATOMIC_RELAXED);
+
+	return __libc_malloc(size);
+}
+
+void *calloc(
+	size_t num,
+	size_t size
+	) {
+
+	__atomic_fetch_add(&bench_num_allocations, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&bench_bytes_allocated, num*size, __ATOMIC_RELAXED);
+
+	return __libc_calloc(num, size);
+}
+
+void *realloc(
+	void   *pointer,
+	size_t  size
+	) {
+
+	__atomic_fetch_add(&bench_num_allocations, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&bench_bytes_allocated, size, __ATOMIC_RELAXED);
+
+	return __libc_realloc(pointer, size);
+}
+
+void free(
+	void *pointer
+	) {
+
+	__libc_free(pointer);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+//
+// Synthetic schema: every block has the same declared layout, superconfigs
+// take any number of unnamed children down to the leaf level.
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+
+#define BENCH_MAX_DEPTH 8
+
+#define BENCH_FIELDS(FIELD, STRUCT)                                        \
+	FIELD(STRUCT, string     , label  , 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float_array, values , 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, int_array  , counts , 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_0, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_1, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_2, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_3, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_4, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_5, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_6, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, float      , param_7, 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, int        , count  , 0, 1, -FLT_MAX, FLT_MAX)           \
+	FIELD(STRUCT, bool       , active , 0, 1, -FLT_MAX, FLT_MAX)
+
+DECLARE_CONFIG_STRUCT(bench_block_s, BENCH_FIELDS)
+DECLARE_CONFIG_PARAMETERS(bench, bench_block_s, BENCH_FIELDS)
+
+typedef struct BenchCase {
+
+	/**
+     * Structure to hold the shape of one synthetic config.
+     */
+
+	const char *name;
+	int32_t     num_top_blocks;
+	int32_t     depth;
+	int32_t     fan_out;
+	int32_t     num_parameters;
+	int32_t     array_length;
+	int32_t     num_extra;
+
+} bench_case_s;
+
+typedef struct BenchResult {
+
+	/**
+     * Structure to hold the measurements of one case, passed back from the
+	 * process that ran it. Times are the fastest of the repeats.
+     */
+
+	bool     success;
+	int64_t  num_blocks;
+	size_t   num_bytes;
+
+	double   compile_seconds;
+	double   map_seconds;
+	double   tokenise_seconds;
+	double   read_seconds;
+	double   read_config_seconds;
+
+	uint64_t num_allocations;
+	uint64_t bytes_allocated;
+	uint64_t arena_allocations;
+	long     peak_rss_kb;
+
+} bench_result_s;
+
+double benchSeconds(
+	void
+	) {
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double) now.tv_sec + 1.0e-9 * (double) now.tv_nsec;
+}
+
+void buildBenchSchema(
+	const int32_t          depth,
+	      loader_config_s *levels
+	) {
+
+	/**
+     * Fill levels[0] with the root and levels[1..depth] with one config per
+	 * block level, each the default of the level above.
+     */
+
+	const loader_config_s block =
+	{
+		.name                   = "bench_block",
+		.name_necessity         = optional_e,
+
+		.inherit                = false,
+		.has_parameters         = true,
+		.min                    = 0,
+		.max                    = INT32_MAX,
+		.early_exit_index       = INT32_MAX,
+
+		CONFIG_DECLARED_LAYOUT(bench, bench_block_s),
+		.min_inputed_parameters = 0,
+		.max_inputed_parameters = CONFIG_DECLARED_NUM_PARAMETERS(bench),
+
+		.min_extra_parameters   = 0,
+		.max_extra_parameters   = INT32_MAX,
+		.default_parameter      =
+			{"default_parameter", none_e, 0, 1, -FLT_MAX, FLT_MAX},
+
+		.num_defined_subconfigs = 0,
+		.min_num_subconfigs     = 0,
+		.max_num_subconfigs     = INT32_MAX,
+		.defined_subconfigs     = NULL,
+
+		.min_extra_subconfigs   = 0,
+		.max_extra_subconfigs   = INT32_MAX
+	};
+
+	for (int32_t level = 0; level <= depth; level++)
+	{
+		levels[level] = block;
+		levels[level].is_superconfig    = (level < depth);
+		levels[level].default_subconfig =
+			(level < depth) ? &levels[level + 1] : NULL;
+	}
+
+	levels[0].name                   = "bench";
+	levels[0].name_necessity         = required_e;
+	levels[0].has_parameters         = false;
+	levels[0].max_inputed_parameters = 0;
+	levels[0].max_extra_parameters   = 0;
+	levels[0].min                    = 1;
+	levels[0].max                    = 1;
+}
+
+int64_t writeBenchBlock(
+	      FILE         *file,
+	const bench_case_s  bench,
+	const int32_t       level,
+	const int64_t       block_index
+	) {
+
+	/**
+     * Write one block and its children, modelled on complex_test.cfg.
+     * @return int64_t num_blocks: blocks written, including children.
+     */
+
+	char indent[BENCH_MAX_DEPTH + 2];
+	memset(indent, '\t', sizeof(indent));
+	indent[level - 1] = '\0';
+
+	fprintf(
+		file, "%s{\n%s\t[block_%" PRId64 "]\n", indent, indent, block_index
+	);
+	fprintf(
+		file, "%s\tlabel   = \"Block %" PRId64 " at level %i\";\n",
+		indent, block_index, level
+	);
+	for (int32_t index = 0; index < bench.num_parameters; index++)
+	{
+		fprintf(
+			file, "%s\tparam_%i = %.4f;\n",
+			indent, index, 0.125 * (double) (block_index + index) - 3.0
+		);
+	}
+	fprintf(
+		file, "%s\tcount   = %" PRId64 ";\n%s\tactive  = %s;\n",
+		indent, block_index, indent, (block_index % 2) ? "true" : "false"
+	);
+
+	if (bench.array_length > 0)
+	{
+		fprintf(file, "%s\tvalues  = (", indent);
+		for (int32_t index = 0; index < bench.array_length; index++)
+		{
+			fprintf(
+				file, "%s%.3f", (index > 0) ? ", " : "",
+				1.5 * (double) index - 0.25 * (double) level
+			);
+		}
+		fprintf(file, ");\n%s\tcounts  = (", indent);
+		for (int32_t index = 0; index < bench.array_length; index++)
+		{
+			fprintf(file, "%s%i", (index > 0) ? ", " : "", index - level);
+		}
+		fprintf(file, ");\n");
+	}
+
+	for (int32_t index = 0; index < bench.num_extra; index++)
+	{
+		fprintf(
+			file, "%s\textra_%i = %i;\n",
+			indent, index, index
+		);
+	}
+
+	int64_t num_blocks = 1;
+	if (level < bench.depth)
+	{
+		for (int32_t child = 0; child < bench.fan_out; child++)
+		{
+			num_blocks +=
+				writeBenchBlock(
+					file, bench, level + 1,
+					block_index*bench.fan_out + child
+				);
+		}
+	}
+
+	fprintf(file, "%s}\n", indent);
+
+	return num_blocks;
+}
+
+int64_t writeBenchConfig(
+	const char         *file_name,
+	const bench_case_s  bench
+	) {
+
+	FILE *file = fopen(file_name, "w");
+	if (file == NULL)
+	{
+		fprintf(
+			stderr, "writeBenchConfig: \nWarning! Could not open \"%s\".\n",
+			file_name
+		);
+		return 0;
+	}
+
+	int64_t num_blocks = 0;
+	for (int32_t block = 0; block < bench.num_top_blocks; block++)
+	{
+		num_blocks += writeBenchBlock(file, bench, 1, block);
+	}
+
+	fclose(file);
+
+	return num_blocks;
+}
+
+bench_result_s runBenchCase(
+	const char         *file_name,
+	const bench_case_s  bench,
+	const int32_t       num_repeats
+	) {
+
+	/**
+     * Time each phase of a read and count its allocations. Runs in a
+	 * process of its own, so peak RSS belongs to this case alone.
+     */
+
+	bench_result_s result = {.success = true};
+
+	loader_config_s levels[BENCH_MAX_DEPTH + 1];
+	buildBenchSchema(bench.depth, levels);
+
+	// -Ofast assumes no infinities, so start from a large finite time:
+	result.compile_seconds  = DBL_MAX;
+	result.map_seconds      = DBL_MAX;
+	result.tokenise_seconds = DBL_MAX;
+	result.read_seconds     = DBL_MAX;
+
+	const char_class_table_s table = createCharClassTable(syntax);
+
+	for (int32_t repeat = 0; repeat < num_repeats; repeat++)
+	{
+		double start = benchSeconds();
+		schema_s *schema = compileSchema(levels[0]);
+		result.compile_seconds =
+			fmin(result.compile_seconds, benchSeconds() - start);
+
+		// Mapping and tokenising alone, the parse is what is left:
+		mapped_file_s mapped;
+		start = benchSeconds();
+		result.success = result.success && mapFile(0, file_name, &mapped);
+		volatile uint64_t checksum = 0;
+		for (size_t index = 0; index < mapped.length; index += 4096)
+		{
+			checksum += (uint8_t) mapped.data[index];
+		}
+		result.map_seconds = fmin(result.map_seconds, benchSeconds() - start);
+		result.num_bytes   = mapped.length;
+
+		start = benchSeconds();
+		token_stream_s stream =
+			tokeniseBuffer(mapped.data, mapped.length, &table);
+		result.tokenise_seconds =
+			fmin(result.tokenise_seconds, benchSeconds() - start);
+		freeTokenStream(&stream);
+		unmapFile(&mapped);
+
+		arena_s       *arena           = createArena(0);
+		loader_data_s  config_data;
+		int64_t        file_position[] = {0};
+
+		const uint64_t allocations = bench_num_allocations;
+		start = benchSeconds();
+		void *structs =
+			readConfigSchemaArena(
+				0, file_name, schema, arena, true, &config_data, file_position
+			);
+		result.read_seconds = fmin(result.read_seconds, benchSeconds() - start);
+		result.arena_allocations = bench_num_allocations - allocations;
+		result.success = result.success && (structs != NULL);
+
+		freeArena(arena);
+		freeSchema(schema);
+	}
+
+	// Default entry point, everything from malloc. Returned structures are
+	// left to process exit, there is no deep free:
+	const uint64_t allocations = bench_num_allocations;
+	const uint64_t bytes       = bench_bytes_allocated;
+
+	loader_data_s config_data;
+	int64_t       file_position[] = {0};
+
+	const double start = benchSeconds();
+	void *structs =
+		readConfig(0, file_name, levels[0], &config_data, file_position);
+	result.read_config_seconds = benchSeconds() - start;
+
+	result.num_allocations = bench_num_allocations - allocations;
+	result.bytes_allocated = bench_bytes_allocated - bytes;
+	result.success         = result.success && (structs != NULL);
+
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	result.peak_rss_kb = usage.ru_maxrss;
+
+	return result;
+}
+
+bool forkBenchCase(
+	const char           *file_name,
+	const bench_case_s    bench,
+	const int32_t         num_repeats,
+	      bench_result_s *ret_result
+	) {
+
+	/**
+     * Run a case in a child process. The parent never starts OpenMP, so
+	 * forking is safe, and each child's peak RSS starts from scratch.
+     */
+
+	int pipe_fds[2];
+	if (pipe(pipe_fds) != 0)
+	{
+		return false;
+	}
+
+	const pid_t pid = fork();
+	if (pid == 0)
+	{
+		close(pipe_fds[0]);
+		const bench_result_s result = 
+			runBenchCase(file_name, bench, num_repeats);
+		const bool written =
+			(write(pipe_fds[1], &result, sizeof(result))
+				== (ssize_t) sizeof(result));
+		close(pipe_fds[1]);
+		_exit(written ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	close(pipe_fds[1]);
+
+	const bool read_result = (pid > 0)
+		&& (read(pipe_fds[0], ret_result, sizeof(*ret_result))
+			== (ssize_t) sizeof(*ret_result));
+	close(pipe_fds[0]);
+
+	int status = 0;
+	if (pid > 0)
+	{
+		waitpid(pid, &status, 0);
+	}
+
+	return read_result && ret_result->success;
+}
+
+int main(
+	int    argc,
+	char **argv
+	) {
+
+	// Usage: config_io_bench [num_repeats] [csv_file] [config_file]
+	const int32_t  num_repeats = (argc > 1) ? atoi(argv[1]) : 5;
+	const char    *csv_name    = (argc > 2) ? argv[2] : NULL;
+	const char    *file_name   = (argc > 3) ? argv[3] : "./config_io_bench.cfg";
+
+	// Each row varies one dimension of the first:
+	const bench_case_s cases[] =
+	{
+		// name          , top blocks, depth, fan out, parameters, array, extra
+		{"baseline"      ,  2000, 3, 3, 8,    3, 0},
+		{"flat"          , 20000, 1, 0, 8,    3, 0},
+		{"deep"          ,   200, 6, 3, 8,    3, 0},
+		{"wide"          ,   200, 2, 30, 8,   3, 0},
+		{"few_parameters",  2000, 3, 3, 1,    3, 0},
+		{"no_arrays"     ,  2000, 3, 3, 8,    0, 0},
+		{"long_arrays"   ,   200, 3, 3, 8,  256, 0},
+		{"extra"         ,  2000, 3, 3, 8,    3, 8},
+		{"large"         , 20000, 3, 3, 8,    3, 0}
+	};
+	const int32_t num_cases = (int32_t) (sizeof(cases) / sizeof(cases[0]));
+
+	FILE *csv = (csv_name != NULL) ? fopen(csv_name, "w") : stdout;
+	if (csv == NULL)
+	{
+		fprintf(
+			stderr, "%s: \nWarning! Could not open \"%s\".\n", 
+			argv[0], csv_name
+		);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(
+		csv,
+		"case,top_blocks,depth,fan_out,parameters,array_length,extra,blocks,"
+		"bytes,compile_ms,map_ms,tokenise_ms,parse_ms,read_ms,read_config_ms,"
+		"mb_per_s,allocs_per_block,bytes_per_block,arena_allocs_per_block,"
+		"peak_rss_kb\n"
+	);
+
+	bool success = true;
+	for (int32_t index = 0; index < num_cases; index++)
+	{
+		const bench_case_s bench      = cases[index];
+		const int64_t      num_blocks = writeBenchConfig(file_name, bench);
+
+		bench_result_s result;
+		if ((num_blocks == 0)
+			|| !forkBenchCase(file_name, bench, num_repeats, &result))
+		{
+			fprintf(
+				stderr, "%s: \nWarning! Case \"%s\" failed.\n",
+				argv[0], bench.name
+			);
+			success = false;
+			continue;
+		}
+
+		const double parse_seconds =
+			fmax(
+				result.read_seconds - result.map_seconds
+				- result.tokenise_seconds,
+				0.0
+			);
+
+		fprintf(
+			csv,
+			"%s,%i,%i,%i,%i,%i,%i,%" PRId64 ",%zu,%.3f,%.3f,%.3f,%.3f,%.3f,"
+			"%.3f,%.1f,%.2f,%.1f,%.4f,%ld\n",
+			bench.name, bench.num_top_blocks, bench.depth, bench.fan_out,
+			bench.num_parameters, bench.array_length, bench.num_extra,
+			num_blocks, result.num_bytes,
+			1.0e3 * result.compile_seconds,
+			1.0e3 * result.map_seconds,
+			1.0e3 * result.tokenise_seconds,
+			1.0e3 * parse_seconds,
+			1.0e3 * result.read_seconds,
+			1.0e3 * result.read_config_seconds,
+			(double) result.num_bytes / result.read_seconds / 1.0e6,
+			(double) result.num_allocations / (double) num_blocks,
+			(double) result.bytes_allocated / (double) num_blocks,
+			(double) result.arena_allocations / (double) num_blocks,
+			result.peak_rss_kb
+		);
+		fflush(csv);
+	}
+
+	remove(file_name);
+	if (csv != stdout)
+	{
+		fclose(csv);
+	}
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,12 +6,20 @@
 #include <inttypes.h>
 
 #include "config.h"
+#include "snapshot.h"
+#include "config_watch.h"
+#include "config_index.h"
 #include "test.h"
 #include "structures.h"
 #include "console.h"
 
 #include "single_config_test.h"	
 #include "complex_test.h"	
+#include "declared_config_test.h"
+
+#include "generated/single_config_test_hash.h"
+#include "generated/complex_test_hash.h"
+#include "generated/nested_config_test_hash.h"
 
 typedef struct TestLoaderNull{
 	
@@ -234,6 +242,338 @@ bool testSingleConfig(
 	return pass;
 }
 
+bool testSchemaReuse(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Read the same file several times with one compiled schema, checking 
+	 * every read gives the same values.
+     */
+	
+	const char*   file_name = "single_config_test.cfg";
+	const int32_t num_reads = 3;
+
+	bool pass = true;
+	
+    char* config_file_path;
+	asprintf(&config_file_path, "./%s/%s", config_directory_name, file_name);
+	
+	#include "single_config_test.h"	
+	
+	const test_config_s known_results = {
+		.parameter_string = "Config Test",
+		.parameter_float  = 1.1f,
+		.parameter_int    = 1,
+		.parameter_bool   = false,
+		.parameter_char   = 'a'
+	};
+	
+	schema_s *schema = compileSchema(loader_config);
+	
+	for (int32_t index = 0; index < num_reads; index++)
+	{
+		loader_data_s config_data;
+		int64_t       file_position[] = {0};
+		
+		test_config_s** test_results = 
+			(test_config_s**) 
+				readConfigSchema(
+					verbosity,
+					config_file_path, 
+					schema,
+					&config_data,
+					file_position
+				);
+		
+		pass = pass && (test_results != NULL);
+		if (test_results != NULL)
+		{
+			pass = pass && configTestCompare(known_results, test_results[0]);
+		}
+	}
+	
+	freeSchema(schema);
+	free(config_file_path);
+	
+	printTestResult(pass, "Schema reuse test.");
+	
+	return pass;
+}
+
+bool testDeclaredConfig(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Read a config whose struct and parameters come from one declaration, 
+	 * in an order the compiler pads, checking the generated tables match
+	 * the struct and every value lands in its member.
+     */
+	
+	const char* file_name = "single_config_test.cfg";
+
+	bool pass = true;
+	
+    char* config_file_path;
+	asprintf(&config_file_path, "./%s/%s", config_directory_name, file_name);
+	
+	#include "declared_config_test.h"	
+	
+	const size_t expected_offsets[] = 
+	{
+		offsetof(declared_test_config_s, parameter_char  ),
+		offsetof(declared_test_config_s, parameter_string),
+		offsetof(declared_test_config_s, parameter_bool  ),
+		offsetof(declared_test_config_s, parameter_float ),
+		offsetof(declared_test_config_s, parameter_int   )
+	};
+	
+	const int32_t num_parameters = CONFIG_DECLARED_NUM_PARAMETERS(declared);
+	
+	pass = pass 
+		&& (num_parameters == 5)
+		&& (loader_config.struct_size == sizeof(declared_test_config_s))
+		&& (declared_parameters[2].type == bool_e);
+	for (int32_t index = 0; index < num_parameters; index++)
+	{
+		pass = pass 
+			&& (declared_offsets[index] == expected_offsets[index])
+			&& (strcmp(
+				declared_names[index], declared_parameters[index].name
+			) == 0);
+	}
+	
+	loader_data_s config_data;
+	int64_t       file_position[] = {0};
+	
+	declared_test_config_s **results = 
+		(declared_test_config_s**) 
+			readConfig(
+				verbosity,
+				config_file_path, 
+				loader_config,
+				&config_data,
+				file_position
+			);
+	
+	pass = pass && (results != NULL);
+	if (results != NULL)
+	{
+		const declared_test_config_s *result = results[0];
+		
+		pass = pass 
+			&& (result->parameter_char  == 'a')
+			&& (strcmp(result->parameter_string, "Config Test") == 0)
+			&& (result->parameter_bool  == false)
+			&& (result->parameter_float == 1.1f)
+			&& (result->parameter_int   == 1);
+	}
+	
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(
+			stderr, 
+			"testDeclaredConfig: \nWarning! Declared layout mismatch. \n"
+		);
+	}
+	
+	free(config_file_path);
+	
+	printTestResult(pass, "Declared config test.");
+	
+	return pass;
+}
+
+bool testArenaConfig(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Read a config with its parse allocated from an arena, once with the 
+	 * returned structures in the arena and once without, checking the 
+	 * latter outlive the arena.
+     */
+	
+	const char* file_name = "single_config_test.cfg";
+
+	bool pass = true;
+	
+    char* config_file_path;
+	asprintf(&config_file_path, "./%s/%s", config_directory_name, file_name);
+	
+	#include "single_config_test.h"	
+	
+	const test_config_s known_results = {
+		.parameter_string = "Config Test",
+		.parameter_float  = 1.1f,
+		.parameter_int    = 1,
+		.parameter_bool   = false,
+		.parameter_char   = 'a'
+	};
+	
+	arena_s *arena = createArena(0);
+	
+	loader_data_s config_data;
+	int64_t       file_position[] = {0};
+	
+	test_config_s** arena_results = 
+		(test_config_s**) 
+			readConfigArena(
+				verbosity,
+				config_file_path, 
+				loader_config,
+				arena,
+				true,
+				&config_data,
+				file_position
+			);
+	
+	pass = pass && (arena_results != NULL) && (arena->num_allocations > 0);
+	if (arena_results != NULL)
+	{
+		pass = pass && configTestCompare(known_results, arena_results[0]);
+	}
+	
+	file_position[0] = 0;
+	test_config_s** heap_results = 
+		(test_config_s**) 
+			readConfigArena(
+				verbosity,
+				config_file_path, 
+				loader_config,
+				arena,
+				false,
+				&config_data,
+				file_position
+			);
+	
+	freeArena(arena);
+	
+	pass = pass && (heap_results != NULL);
+	if (heap_results != NULL)
+	{
+		pass = pass && configTestCompare(known_results, heap_results[0]);
+		
+		free(heap_results[0]->parameter_string);
+		free(heap_results[0]);
+		free(heap_results);
+	}
+	
+	free(config_file_path);
+	
+	printTestResult(pass, "Arena config test.");
+	
+	return pass;
+}
+
+bool testParallelConfig(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Generate a config large enough for its top level blocks to be parsed
+	 * in parallel, then check every block, with and without an arena.
+     */
+	
+	const char* file_name = "parallel_config_test.cfg";
+
+	bool pass = true;
+	
+    char* config_file_path;
+	asprintf(&config_file_path, "./%s/%s", config_directory_name, file_name);
+	
+	#include "multi_config_test.h"	
+	
+	loader_config.max_num_subconfigs   = INT32_MAX;
+	loader_config.max_extra_subconfigs = INT32_MAX;
+	
+	FILE *file = fopen(config_file_path, "w");
+	
+	int32_t num_blocks = 0;
+	while ((size_t) ftell(file) < CONFIG_PARALLEL_MIN_BYTES)
+	{
+		if (num_blocks < num_defined_subconfigs)
+		{
+			fprintf(file, "{\n\t[multi_config_test_%i]\n", num_blocks);
+		}
+		else
+		{
+			fprintf(file, "{\n\t[extra_block_%i]\n", num_blocks);
+		}
+		
+		fprintf(
+			file,
+			"\tparameter_string = \"Block %i\";\n"
+			"\tparameter_float  = %i.5;\n"
+			"\tparameter_int    = %i;\n"
+			"\tparameter_bool   = %s;\n"
+			"\tparameter_char   = '%c';\n"
+			"}\n",
+			num_blocks, 
+			num_blocks, 
+			num_blocks, 
+			(num_blocks % 2) ? "true" : "false",
+			'a' + num_blocks % 26
+		);
+		num_blocks++;
+	}
+	fclose(file);
+	
+	arena_s *arena = createArena(0);
+	
+	for (int32_t read = 0; read < 2; read++)
+	{
+		loader_data_s config_data;
+		int64_t       file_position[] = {0};
+		
+		test_config_s** test_results = 
+			(test_config_s**) 
+				readConfigArena(
+					verbosity,
+					config_file_path, 
+					loader_config,
+					(read == 0) ? NULL : arena,
+					true,
+					&config_data,
+					file_position
+				);
+		
+		pass = pass && (test_results != NULL);
+		pass = pass && (config_data.total_num_subconfigs_read == num_blocks);
+		
+		for (int32_t index = 0; pass && (index < num_blocks); index++)
+		{
+			char parameter_string[32];
+			snprintf(
+				parameter_string, sizeof(parameter_string), "Block %i", index
+			);
+			
+			const test_config_s known_results = {
+				.parameter_string = parameter_string,
+				.parameter_float  = (float) index + 0.5f,
+				.parameter_int    = index,
+				.parameter_bool   = index % 2,
+				.parameter_char   = (char) ('a' + index % 26)
+			};
+			
+			pass = pass && configTestCompare(known_results, test_results[index]);
+		}
+	}
+	
+	freeArena(arena);
+	remove(config_file_path);
+	free(config_file_path);
+	
+	printTestResult(pass, "Parallel config test.");
+	
+	return pass;
+}
+
 bool testVariableConfig(
 	const int32_t  verbosity,
 	const char    *config_directory_name
@@ -1085,82 +1425,1122 @@ bool testComplexConfig(
     return pass;
 }
 
-int main() {
+bool testConfigSnapshot(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
 	
-	const int32_t verbosity = 3;
+	/**
+     * Snapshot a copy of the complex config, check the mapped snapshot holds
+	 * the same values as the parse, and that changing the schema or the 
+	 * config file's mtime invalidates it.
+     */
 	
-	//parameters:
-	const char *config_directory_name = "configs";	
-		 
 	bool pass = true;
 	
-	pass *= 
-		testSingleConfig(
-			verbosity,
-			config_directory_name
-		);
+	#include "complex_test.h"	
 	
-	pass *= 
-		testMultiConfig(
+	char *source_path;
+	char *config_file_path;
+	char *snapshot_path;
+	asprintf(&source_path, "./%s/complex_test.cfg", config_directory_name);
+	asprintf(
+		&config_file_path, "./%s/snapshot_test.cfg", config_directory_name
+	);
+	asprintf(
+		&snapshot_path, "./%s/snapshot_test.snapshot", config_directory_name
+	);
+	
+	mapped_file_s source;
+	mapFile(verbosity, source_path, &source);
+	FILE *file = fopen(config_file_path, "wb");
+	fwrite(source.data, 1, source.length, file);
+	fclose(file);
+	unmapFile(&source);
+	
+	loader_data_s config_data;
+	int64_t       file_position[] = {0};
+	
+	void **config_structs = 
+		readConfig(
 			verbosity,
-			config_directory_name
+			config_file_path, 
+			loader_config,
+			&config_data,
+			file_position
 		);
 	
-	pass *= 
-		testVariableConfig(
+	pass = pass && 
+		writeConfigSnapshot(
 			verbosity,
-			config_directory_name
+			snapshot_path,
+			config_file_path,
+			loader_config,
+			config_structs,
+			config_data
 		);
 	
-	pass *= 
-		testReqirementConfig(
+	config_snapshot_s snapshot;
+	void **snapshot_structs = 
+		loadConfigSnapshot(
 			verbosity,
-			config_directory_name
+			snapshot_path,
+			config_file_path,
+			loader_config,
+			&snapshot
 		);
 	
-	pass *=
-		testExtraParameterConfig(
-			verbosity,
-			config_directory_name
-		);
-        
-    pass *= 
-        testNameRequrimentConfig(
-            verbosity,
-            config_directory_name
-        ); 
-        
-    pass *= testConfigRequriment(
-            verbosity,
-            config_directory_name
-        );
-    
-    pass *=  
-        testNestedRequriments(
-            verbosity,
-            config_directory_name
-        ); 
-        
-    pass *=  
-        testConfigOrder(
-            verbosity,
-            config_directory_name
-        ); 
-        
-    pass *=  
-        testNestedConfig(
-            verbosity,
-            config_directory_name
-        ); 
-    
-    pass *=  
-        testMultiTypeConfig(
-            verbosity,
-            config_directory_name
-        ); 
+	pass = pass && (snapshot_structs != NULL);
+	pass = pass && 
+		(snapshot.num_structs == config_data.total_num_subconfigs_read);
 	
-	pass *=  
-		testComplexConfig(
+	if (pass)
+	{
+		const network_config_s *network   = config_structs[0];
+		const network_config_s *network_s = snapshot_structs[0];
+		
+		pass = pass && (network->speed_of_light == network_s->speed_of_light);
+		pass = pass && (network_s != (void*) network);
+		
+		const loader_data_s   detector_data = 
+			config_data.subconfigs[0].subconfigs[0];
+		const snapshot_node_s detector_node = 
+			snapshot.root->subconfigs[0].subconfigs[0];
+		
+		pass = pass && 
+			(detector_node.num_subconfigs 
+			 == detector_data.total_num_subconfigs_read);
+		
+		for (
+			int32_t index = 0; 
+			pass && (index < detector_node.num_subconfigs); 
+			index++
+		) {
+			const detector_s *detector   = 
+				detector_data.subconfigs[index].structure;
+			const detector_s *detector_s = 
+				detector_node.subconfigs[index].structure;
+			
+			pass = pass && 
+				((detector->name == NULL) 
+					? (detector_s->name == NULL)
+					: !strcmp(detector->name, detector_s->name));
+			pass = pass && (detector->active == detector_s->active);
+			pass = pass && 
+				!memcmp(
+					detector->latitude, 
+					detector_s->latitude, 
+					3*sizeof(int32_t)
+				);
+			pass = pass && 
+				!strcmp(
+					detector_data.subconfigs[index].name, 
+					detector_node.subconfigs[index].name
+				);
+		}
+	}
+	freeConfigSnapshot(&snapshot);
+	
+	// Any change to the schema makes the snapshot stale:
+	loader_config.max_num_subconfigs++;
+	pass = pass && 
+		(loadConfigSnapshot(
+			verbosity, snapshot_path, config_file_path, loader_config, &snapshot
+		) == NULL);
+	loader_config.max_num_subconfigs--;
+	
+	// As does touching the config file:
+	struct timespec times[2] = {{0, UTIME_NOW}, {1000000000, 0}};
+	utimensat(AT_FDCWD, config_file_path, times, 0);
+	
+	pass = pass && 
+		(loadConfigSnapshot(
+			verbosity, snapshot_path, config_file_path, loader_config, &snapshot
+		) == NULL);
+	
+	remove(snapshot_path);
+	remove(config_file_path);
+	free(snapshot_path);
+	free(config_file_path);
+	free(source_path);
+	
+	printTestResult(pass, "Config snapshot test.");
+	
+	return pass;
+}
+
+void writeWatchTestConfig(
+	const char    *file_path,
+	      char   (*blocks)[256],
+	const int32_t  num_blocks
+	) {
+	
+	FILE *file = fopen(file_path, "w");
+	for (int32_t index = 0; index < num_blocks; index++)
+	{
+		fprintf(file, "%s\n", blocks[index]);
+	}
+	fclose(file);
+}
+
+void formatWatchTestBlock(
+	      char    *block,
+	const char    *name,
+	const int32_t  value,
+	const char    *separator
+	) {
+	
+	snprintf(
+		block, 256,
+		"{%s[%s]%sparameter_string = \"%s\";%sparameter_float = %i.5;%s"
+		"parameter_int = %i;%sparameter_bool = true;%sparameter_char = 'c';"
+		"%s}",
+		separator, name, separator, name, separator, value, separator, value, 
+		separator, separator, separator
+	);
+}
+
+bool testConfigWatch(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Reload a watched config after editing some of its blocks, check only
+	 * changed blocks are parsed, unchanged structures keep their pointers 
+	 * and the change set names what changed. The last edit is picked up 
+	 * through inotify.
+     */
+	
+	bool pass = true;
+	
+	#include "multi_config_test.h"	
+	
+	loader_config.max_num_subconfigs   = INT32_MAX;
+	loader_config.max_extra_subconfigs = INT32_MAX;
+	
+	char *config_file_path;
+	char *temporary_path;
+	asprintf(&config_file_path, "./%s/watch_test.cfg", config_directory_name);
+	asprintf(&temporary_path, "./%s/watch_test.tmp", config_directory_name);
+	
+	char blocks[4][256];
+	formatWatchTestBlock(blocks[0], "multi_config_test_0", 0, " ");
+	formatWatchTestBlock(blocks[1], "multi_config_test_1", 1, " ");
+	formatWatchTestBlock(blocks[2], "multi_config_test_2", 2, " ");
+	formatWatchTestBlock(blocks[3], "extra_block_3"      , 3, " ");
+	writeWatchTestConfig(config_file_path, blocks, 4);
+	
+	config_watch_s watch;
+	const bool     opened = 
+		pass 
+		&& openConfigWatch(verbosity, config_file_path, loader_config, &watch);
+	pass = pass && opened;
+	pass = pass && (watch.config_data.total_num_subconfigs_read == 4);
+	
+	if (pass)
+	{
+		void *structures[4];
+		for (int32_t index = 0; index < 4; index++)
+		{
+			structures[index] = watch.config_data.subconfigs[index].structure;
+		}
+		
+		// Block 1 only changes layout, block 2 a value, block 3 is replaced:
+		formatWatchTestBlock(blocks[1], "multi_config_test_1", 1, "\n\t");
+		formatWatchTestBlock(blocks[2], "multi_config_test_2", 7, " ");
+		formatWatchTestBlock(blocks[3], "extra_block_4"      , 4, " ");
+		writeWatchTestConfig(config_file_path, blocks, 4);
+		
+		config_change_set_s changes;
+		pass = pass && reloadConfigWatch(&watch, &changes);
+		
+		pass = pass && (changes.num_blocks_skipped == 1);
+		pass = pass && (changes.num_unchanged      == 2);
+		pass = pass && (changes.num_modified       == 1);
+		pass = pass && (changes.num_added          == 1);
+		pass = pass && (changes.num_removed        == 1);
+		
+		for (int32_t index = 0; pass && (index < changes.num_blocks); index++)
+		{
+			const config_block_change_s block = changes.blocks[index];
+		
+			printf(
+				"Block %s: %s.\n", 
+				block.name, configChangeToString(block.change)
+			);
+		
+			if (block.change == config_modified_e)
+			{
+				pass = pass && !strcmp(block.name, "multi_config_test_2");
+				pass = pass && (block.num_changed_parameters == 2);
+			}
+		}
+		freeConfigChangeSet(&changes);
+		
+		const loader_data_s *subconfigs = watch.config_data.subconfigs;
+		
+		pass = pass && (subconfigs[0].structure == structures[0]);
+		pass = pass && (subconfigs[1].structure == structures[1]);
+		pass = pass && (subconfigs[2].structure != structures[2]);
+		pass = pass && 
+			(((test_config_s*) subconfigs[2].structure)->parameter_int == 7);
+		pass = pass && !strcmp(subconfigs[3].name, "extra_block_4");
+		
+		// Broken edits keep the previous load:
+		char broken[1][256] = {"{ [multi_config_test_0] { } }"};
+		writeWatchTestConfig(config_file_path, broken, 1);
+		
+		pass = pass && !reloadConfigWatch(&watch, &changes);
+		pass = pass && (watch.config_data.total_num_subconfigs_read == 4);
+		pass = pass && 
+			(watch.config_data.subconfigs[0].structure == structures[0]);
+		freeConfigChangeSet(&changes);
+		
+		// Replaced by rename, as editors do:
+		formatWatchTestBlock(blocks[0], "multi_config_test_0", 9, " ");
+		writeWatchTestConfig(temporary_path, blocks, 4);
+		rename(temporary_path, config_file_path);
+		
+		pass = pass && pollConfigWatch(&watch, 1000, &changes);
+		pass = pass && (changes.num_blocks_skipped == 3);
+		pass = pass && (changes.num_modified       == 1);
+		pass = pass && 
+			(((test_config_s*) watch.config_data.subconfigs[0].structure)
+				->parameter_int == 9);
+		pass = pass && (watch.generation == 3);
+		freeConfigChangeSet(&changes);
+		
+		// Nothing further to see:
+		pass = pass && !pollConfigWatch(&watch, 0, &changes);
+	}
+	
+	if (opened)
+	{
+		closeConfigWatch(&watch);
+	}
+	remove(config_file_path);
+	free(config_file_path);
+	free(temporary_path);
+	
+	printTestResult(pass, "Config watch test.");
+	
+	return pass;
+}
+
+bool testConfigIndex(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Read single detectors of the complex config through its index, check
+	 * they match a full read, and that a persisted index is reused until the
+	 * config changes.
+     */
+	
+	bool pass = true;
+	
+	#include "complex_test.h"	
+	
+	char *config_file_path;
+	char *index_path;
+	asprintf(&config_file_path, "./%s/complex_test.cfg", config_directory_name);
+	asprintf(&index_path, "%s%s", config_file_path, CONFIG_INDEX_EXTENSION);
+	remove(index_path);
+	
+	loader_data_s config_data;
+	int64_t       file_position[] = {0};
+	
+	void **config_structs = 
+		readConfig(
+			verbosity,
+			config_file_path, 
+			loader_config,
+			&config_data,
+			file_position
+		);
+	pass = pass && (config_structs != NULL);
+	
+	config_index_s index;
+	pass = pass && readConfigIndex(verbosity, config_file_path, true, &index);
+	pass = pass && !index.is_cached;
+	
+	schema_s *schema = compileSchema(loader_config);
+	
+	const char *names[] = {"hanford", "livingston", "virgo"};
+	for (int32_t detector = 0; pass && (detector < 3); detector++)
+	{
+		char path[64];
+		snprintf(path, sizeof(path), "network/detectors/%s", names[detector]);
+		
+		loader_data_s   detector_data;
+		const detector_s *detector_i = 
+			readConfigPath(
+				verbosity, config_file_path, schema, &index, path, NULL, 
+				&detector_data
+			);
+		const detector_s *detector_f = 
+			config_data.subconfigs[0].subconfigs[0].subconfigs[detector]
+				.structure;
+		
+		pass = pass && (detector_i != NULL);
+		pass = pass && !strcmp(detector_data.name, names[detector]);
+		pass = pass && (detector_i->active        == detector_f->active);
+		pass = pass && (detector_i->x_arm_bearing == detector_f->x_arm_bearing);
+		pass = pass && 
+			(detector_i->height_above_sea_level 
+			 == detector_f->height_above_sea_level);
+		pass = pass && 
+			!memcmp(detector_i->latitude, detector_f->latitude, 3*sizeof(int32_t));
+		
+		if (detector_i != NULL)
+		{
+			free(detector_i->latitude);
+			free(detector_i->longitude);
+			free((void*) detector_i);
+			freeConfigData(detector_data);
+		}
+	}
+	
+	loader_data_s missing_data;
+	pass = pass && 
+		(readConfigPath(
+			0, config_file_path, schema, &index, "network/detectors/kagra", 
+			NULL, &missing_data
+		) == NULL);
+	pass = pass && (findConfigIndexPath(&index, "waveforms/cbc") >= 0);
+	pass = pass && (findConfigIndexPath(&index, "detectors") < 0);
+	freeConfigIndex(&index);
+	
+	// Persisted index is mapped in place next time:
+	pass = pass && readConfigIndex(verbosity, config_file_path, true, &index);
+	pass = pass && index.is_cached;
+	pass = pass && (findConfigIndexPath(&index, "network/detectors/virgo") >= 0);
+	freeConfigIndex(&index);
+	
+	// Unless a link loops back, which is rejected rather than walked:
+	const int32_t  loop    = 0;
+	FILE          *corrupt = fopen(index_path, "r+b");
+	pass = pass && (corrupt != NULL);
+	if (corrupt != NULL)
+	{
+		fseek(
+			corrupt,
+			(long) (sizeof(config_index_header_s)
+				+ offsetof(config_index_entry_s, first_child)),
+			SEEK_SET
+		);
+		pass = pass && (fwrite(&loop, sizeof(loop), 1, corrupt) == 1);
+		fclose(corrupt);
+	}
+	
+	pass = pass && readConfigIndex(0, config_file_path, false, &index);
+	pass = pass && !index.is_cached;
+	pass = pass && (findConfigIndexPath(&index, "network/detectors/virgo") >= 0);
+	freeConfigIndex(&index);
+	
+	// Until the config is touched:
+	struct stat source_stat;
+	stat(config_file_path, &source_stat);
+	struct timespec times[2] = {source_stat.st_atim, {1000000000, 0}};
+	utimensat(AT_FDCWD, config_file_path, times, 0);
+	
+	pass = pass && readConfigIndex(verbosity, config_file_path, false, &index);
+	pass = pass && !index.is_cached;
+	freeConfigIndex(&index);
+	
+	times[1] = source_stat.st_mtim;
+	utimensat(AT_FDCWD, config_file_path, times, 0);
+	
+	freeSchema(schema);
+	remove(index_path);
+	free(index_path);
+	free(config_file_path);
+	
+	printTestResult(pass, "Config index test.");
+	
+	return pass;
+}
+
+bool testNumberParsing(
+	const int32_t verbosity
+	) {
+	
+	/**
+     * Check the number parsing kernel against strtof and a table of edge
+	 * cases, including trailing garbage and out of range values.
+     */
+	
+	bool pass = true;
+	
+	typedef struct NumberCase {
+		const char      *string;
+		number_status_e  status;
+	} number_case_s;
+	
+	const number_case_s float_cases[] = 
+	{
+		{"1.1"            , number_ok_e      },
+		{"  -10.0 "       , number_ok_e      },
+		{".5"             , number_ok_e      },
+		{"6356752.3"      , number_ok_e      },
+		{"3.4028235e38"   , number_ok_e      },
+		{"1.4e-45"        , number_ok_e      },
+		{"0.1000000000000000000000000000001", number_ok_e},
+		{"1e400"          , number_range_e   },
+		{"1.5f"           , number_trailing_e},
+		{"1e"             , number_trailing_e},
+		{"error"          , number_empty_e   },
+		{"-"              , number_empty_e   }
+	};
+	
+	for (size_t index = 0; index < sizeof(float_cases)/sizeof(float_cases[0]); 
+		index++
+	) {
+		float value = 0.0f;
+		const number_status_e status = 
+			parseFloatNumber(float_cases[index].string, NULL, &value, NULL);
+		const float expected = strtof(float_cases[index].string, NULL);
+		
+		pass = pass && (status == float_cases[index].status);
+		pass = pass && 
+			(   (status == number_empty_e) 
+			 || !memcmp(&value, &expected, sizeof(value)));
+	}
+	
+	const number_case_s int_cases[] = 
+	{
+		{"0"          , number_ok_e      },
+		{"-2147483648", number_ok_e      },
+		{"123456789"  , number_ok_e      },
+		{"2147483648" , number_range_e   },
+		{"12abc"      , number_trailing_e},
+		{"abc"        , number_empty_e   }
+	};
+	
+	for (size_t index = 0; index < sizeof(int_cases)/sizeof(int_cases[0]); 
+		index++
+	) {
+		int32_t value = 0;
+		const number_status_e status = 
+			parseInt32Number(int_cases[index].string, NULL, &value, NULL);
+		
+		pass = pass && (status == int_cases[index].status);
+		pass = pass && 
+			(   (status != number_ok_e) 
+			 || (value == (int32_t) strtol(int_cases[index].string, NULL, 10)));
+	}
+	
+	// Every normal float printed at full precision must parse back exactly,
+	// bits are checked directly since -Ofast flushes subnormals to zero:
+	uint32_t bits = 0x3F800000;
+	for (int32_t index = 0; index < 100000; index++)
+	{
+		bits = bits * 1664525u + 1013904223u;
+		if (   ((bits & 0x7F800000u) == 0x7F800000u) 
+			|| ((bits & 0x7F800000u) == 0)
+		) {
+			continue;
+		}
+		
+		float number;
+		memcpy(&number, &bits, sizeof(number));
+		
+		char string[64];
+		snprintf(string, sizeof(string), "%.9g", number);
+		
+		float value = 0.0f;
+		parseFloatNumber(string, NULL, &value, NULL);
+		
+		pass = pass && !memcmp(&value, &number, sizeof(value));
+		
+		// Shortest text must also parse back exactly, in both notations:
+		for (int32_t scientific = 0; scientific < 2; scientific++)
+		{
+			const size_t length = 
+				formatFloatNumber(number, scientific, string);
+			
+			value = 0.0f;
+			parseFloatNumber(string, &string[length], &value, NULL);
+			
+			pass = pass && !memcmp(&value, &number, sizeof(value));
+		}
+	}
+	
+	pass = pass && (stringToInt(verbosity, "12abc") == 0);
+	pass = pass && (stringToFloat(verbosity, "1.5.5") == 0.0f);
+	
+	printTestResult(pass, "Number parsing test.");
+	
+	return pass;
+}
+
+bool testArrayParsing(
+	const int32_t verbosity
+	) {
+	
+	/**
+     * Check the bulk array parser reads whitespace, parentheses and empty 
+	 * elements as the element-wise path does, and sizes long arrays exactly.
+     */
+	
+	bool pass = true;
+	
+	const char *float_text = " ( 1.5, -2 ,3e2,, 4 ) ";
+	const float expected_floats[] = {1.5f, -2.0f, 300.0f, 4.0f};
+	
+	array_s floats = 
+		parseArrayArena(
+			verbosity, float_text, strlen(float_text), float_array_e, NULL
+		);
+	pass = pass && (floats.data.ff.num_elements == 4);
+	for (int32_t index = 0; pass && (index < 4); index++)
+	{
+		pass = pass 
+			&& (floats.data.ff.elements[index] == expected_floats[index]);
+	}
+	free(floats.data.ff.elements);
+	
+	// Not null terminated, the view ends before "9":
+	const char *int_text = "(46, 27,\t19)9";
+	array_s ints = 
+		parseArrayArena(
+			verbosity, int_text, strlen(int_text) - 1, int_array_e, NULL
+		);
+	pass = pass 
+		&& (ints.data.ii.num_elements == 3)
+		&& (ints.data.ii.elements[0] == 46)
+		&& (ints.data.ii.elements[1] == 27)
+		&& (ints.data.ii.elements[2] == 19);
+	free(ints.data.ii.elements);
+	
+	// Decimals keep their integer part, as element-wise:
+	const char *decimal_text = "1.5, 2.7, -3.25";
+	array_s decimals = 
+		parseArrayArena(
+			0, decimal_text, strlen(decimal_text), int_array_e, NULL
+		);
+	array_s decimals_s = stringToArrayS(0, decimal_text, int_array_e);
+	pass = pass 
+		&& (decimals.data.ii.num_elements == 3)
+		&& (decimals_s.data.ii.num_elements == 3)
+		&& (decimals.data.ii.elements[0] == 1)
+		&& (memcmp(
+			decimals.data.ii.elements, decimals_s.data.ii.elements, 
+			3*sizeof(int32_t)
+		) == 0);
+	free(decimals.data.ii.elements);
+	free(decimals_s.data.ii.elements);
+	
+	const char *bool_text = "true, 0,1 ,false";
+	array_s bools = 
+		parseArrayArena(
+			verbosity, bool_text, strlen(bool_text), bool_array_e, NULL
+		);
+	pass = pass 
+		&& (bools.data.bb.num_elements == 4)
+		&& bools.data.bb.elements[0] && !bools.data.bb.elements[1]
+		&& bools.data.bb.elements[2] && !bools.data.bb.elements[3];
+	free(bools.data.bb.elements);
+	
+	// Long arrays cross the vector width and match the element-wise path:
+	const int32_t num_values = 1000;
+	char *long_text = malloc((size_t) num_values * 16);
+	size_t length = 0;
+	for (int32_t index = 0; index < num_values; index++)
+	{
+		length += (size_t) 
+			sprintf(
+				&long_text[length], "%s%.3f", (index > 0) ? "," : "", 
+				0.25f*(float) index - 7.0f
+			);
+	}
+	
+	array_s bulk    = 
+		parseArrayArena(verbosity, long_text, length, float_array_e, NULL);
+	array_s element = stringToArrayS(verbosity, long_text, float_array_e);
+	
+	pass = pass 
+		&& (bulk.data.ff.num_elements    == num_values)
+		&& (element.data.ff.num_elements == num_values)
+		&& (memcmp(
+			bulk.data.ff.elements, element.data.ff.elements, 
+			sizeof(float) * (size_t) num_values
+		) == 0);
+	
+	free(bulk.data.ff.elements);
+	free(element.data.ff.elements);
+	free(long_text);
+	
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(stderr, "testArrayParsing: \nWarning! Array mismatch. \n");
+	}
+	
+	printTestResult(pass, "Array parsing test.");
+	
+	return pass;
+}
+
+bool testDictionary(
+	const int32_t verbosity
+	) {
+	
+	/**
+     * Fill a dictionary well past its initial length, delete every other 
+     * entry, and check the remaining entries are still found in order.
+     */
+	
+	const int32_t num_keys = 1000;
+	
+	bool pass = true;
+	
+	dict_s *dict = makeDictionary(1);
+	
+	for (int32_t index = 0; index < num_keys; index++)
+	{
+		char key[32];
+		snprintf(key, sizeof(key), "key_%i", index);
+		
+		multi_s data;
+		data.value.i = index;
+		data.type    = int_e;
+		
+		pass = pass && (insertDictEntry(dict, data, key) == 0);
+	}
+	
+	for (int32_t index = 0; index < num_keys; index += 2)
+	{
+		char key[32];
+		snprintf(key, sizeof(key), "key_%i", index);
+		
+		deleteDictEntry(dict, key);
+	}
+	
+	for (int32_t index = 0; index < num_keys; index++)
+	{
+		char key[32];
+		snprintf(key, sizeof(key), "key_%i", index);
+		
+		const dict_entry_s *entry = findDictEntry_(dict, key);
+		
+		if ((index % 2) == 0)
+		{
+			pass = pass && (entry == NULL);
+		}
+		else
+		{
+			pass = pass && ((entry != NULL) && (entry->data.value.i == index));
+		}
+	}
+	
+	dict_entry_s **entries = returnAllEntries(dict);
+	
+	pass = pass && (dict->num_entries == num_keys/2);
+	for (int32_t index = 0; index < dict->num_entries; index++)
+	{
+		pass = pass && (entries[index]->data.value.i == 2*index + 1);
+	}
+	
+	free(entries);
+	freeDictionary(dict);
+	
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(stderr, "testDictionary: \nWarning! Dictionary mismatch. \n");
+	}
+	
+	printTestResult(pass, "Dictionary test.");
+	
+	return pass;
+}
+
+bool testParameterOffsets(
+	const int32_t verbosity
+	) {
+	
+	/**
+     * Check computed offsets match the compiler's layout for a struct that
+     * is not ordered by member size, so needs padding.
+     */
+	
+	typedef struct PaddedTest {
+		char     parameter_char;
+		float   *parameter_float_array;
+		bool     parameter_bool;
+		int32_t  parameter_int;
+		char    *parameter_string;
+	} padded_test_s;
+	
+	const int32_t num_parameters = 5;
+	parameter_s parameters[] = 
+	{
+		{"parameter_char"       , char_e       , 0, 1, -FLT_MAX, FLT_MAX},
+		{"parameter_float_array", float_array_e, 0, 1, -FLT_MAX, FLT_MAX},
+		{"parameter_bool"       , bool_e       , 0, 1, -FLT_MAX, FLT_MAX},
+		{"parameter_int"        , int_e        , 0, 1, -FLT_MAX, FLT_MAX},
+		{"parameter_string"     , string_e     , 0, 1, -FLT_MAX, FLT_MAX}
+	};
+	
+	const size_t expected_offsets[] = 
+	{
+		offsetof(padded_test_s, parameter_char       ),
+		offsetof(padded_test_s, parameter_float_array),
+		offsetof(padded_test_s, parameter_bool       ),
+		offsetof(padded_test_s, parameter_int        ),
+		offsetof(padded_test_s, parameter_string     )
+	};
+	
+	size_t offsets[num_parameters];
+	const size_t struct_size = 
+		getParameterOffsets(parameters, NULL, num_parameters, offsets);
+	
+	bool pass = (struct_size == sizeof(padded_test_s));
+	for (int32_t index = 0; index < num_parameters; index++)
+	{
+		pass = pass && (offsets[index] == expected_offsets[index]);
+	}
+	
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(
+			stderr, 
+			"testParameterOffsets: \nWarning! Computed layout does not match"
+			" compiled struct. \n"
+		);
+	}
+	
+	printTestResult(pass, "Parameter offset test.");
+	
+	return pass;
+}
+
+bool checkNameMap(
+	const map_s  map,
+	const bool   expect_perfect
+	) {
+	
+	/**
+     * Check every key of a map is found at its index, also from a view 
+     * into a longer string, and that near misses are not found.
+     */
+	
+	bool pass = 
+		((map.perfect != NULL) == expect_perfect) 
+		&& ((map.dict == NULL) == expect_perfect);
+	
+	for (int32_t index = 0; index < map.length; index++)
+	{
+		const char *key    = getMapKey(map, index);
+		const size_t length = strlen(key);
+		
+		char view[256];
+		snprintf(view, sizeof(view), "%s = 1;", key);
+		
+		pass = pass 
+			&& (getMapIndex(map, key) == index)
+			&& (getMapIndexN(map, view, length) == index)
+			&& (getMapIndexN(map, view, length - 1) == -1)
+			&& (getMapIndexN(map, view, length + 1) == -1);
+	}
+	
+	return pass && (getMapIndex(map, "not_a_defined_name") == -1);
+}
+
+bool checkSchemaNameMaps(
+	const schema_s *schema,
+	const bool      expect_perfect
+	) {
+	
+	bool pass = 
+		checkNameMap(
+			schema->parameter_name_map, 
+			expect_perfect && (schema->parameter_name_map.length > 0)
+		)
+		&& checkNameMap(
+			schema->subconfig_name_map, 
+			expect_perfect && (schema->subconfig_name_map.length > 0)
+		);
+	
+	if (schema->default_subconfig != NULL)
+	{
+		pass = pass 
+			&& checkSchemaNameMaps(schema->default_subconfig, expect_perfect);
+	}
+	for (int32_t index = 0; index < schema->num_subconfigs; index++)
+	{
+		pass = pass 
+			&& checkSchemaNameMaps(&schema->subconfigs[index], expect_perfect);
+	}
+	
+	return pass;
+}
+
+bool testPerfectHash(
+	const int32_t verbosity
+	) {
+	
+	/**
+     * Check a static schema resolves every name through its generated 
+     * tables, and that names built at runtime fall back to the dictionary.
+     */
+	
+	bool pass = true;
+	
+	{
+		#include "complex_test.h"
+		
+		schema_s *schema = compileSchema(loader_config);
+		pass = pass && checkSchemaNameMaps(schema, true);
+		freeSchema(schema);
+	}
+	
+	{
+		#include "variable_config_test.h"
+		
+		schema_s *schema = compileSchema(loader_config);
+		pass = pass 
+			&& checkNameMap(schema->parameter_name_map, true)
+			&& checkNameMap(schema->subconfig_name_map, false);
+		freeSchema(schema);
+	}
+	
+	if (!pass && (verbosity > 0))
+	{
+		fprintf(
+			stderr, 
+			"testPerfectHash: \nWarning! Name lookup mismatch. \n"
+		);
+	}
+	
+	printTestResult(pass, "Perfect hash test.");
+	
+	return pass;
+}
+
+bool testConfigStats(
+	const int32_t  verbosity,
+	const char    *config_directory_name
+	) {
+	
+	/**
+     * Read a config with the stats reset, checking the hooks filled every 
+	 * phase and count when built with CONFIG_STATS, and left them at zero 
+	 * otherwise.
+     */
+	
+	const char* file_name = "single_config_test.cfg";
+	
+	bool pass = true;
+	
+    char* config_file_path;
+	asprintf(&config_file_path, "./%s/%s", config_directory_name, file_name);
+	
+	#include "single_config_test.h"	
+	
+	loader_data_s config_data;
+	int64_t       file_position[] = {0};
+	
+	resetConfigStats();
+	
+	pass = 
+		(readConfig(
+			verbosity,
+			config_file_path, 
+			loader_config,
+			&config_data,
+			file_position
+		) != NULL);
+	
+	const config_stats_s stats = getConfigStats();
+	
+	#ifdef CONFIG_STATS
+	pass = pass 
+		&& (stats.counts[config_count_reads_e      ] == 1)
+		&& (stats.counts[config_count_bytes_e      ] == *file_position)
+		&& (stats.counts[config_count_lines_e      ] >  0)
+		&& (stats.counts[config_count_tokens_e     ] >  0)
+		&& (stats.counts[config_count_lookups_e    ] >= 5)
+		&& (stats.counts[config_count_probes_e     ] >= 5)
+		&& (stats.counts[config_count_allocations_e] >  0)
+		&& (stats.counts[config_count_conversions_e] == 5)
+		&& (stats.phase_calls[config_phase_requirements_e] > 0)
+		&& (stats.phase_calls[config_phase_set_structs_e ] == 1)
+		&& (stats.phase_ns[config_phase_total_e] 
+			>= stats.phase_ns[config_phase_tokenise_e]);
+	#else
+	for (int32_t counter = 0; counter < config_num_counters_e; counter++)
+	{
+		pass = pass && (stats.counts[counter] == 0);
+	}
+	for (int32_t phase = 0; phase < config_num_phases_e; phase++)
+	{
+		pass = pass && (stats.phase_calls[phase] == 0);
+	}
+	#endif
+	
+	if (verbosity > 2)
+	{
+		printConfigStats(stats);
+	}
+	
+	free(config_file_path);
+	
+	printTestResult(pass, "Config stats test.");
+	
+	return pass;
+}
+
+int main() {
+	
+	const int32_t verbosity = 3;
+	
+	//parameters:
+	const char *config_directory_name = "configs";	
+		 
+	bool pass = true;
+	
+	pass *= 
+		testDictionary(
+			verbosity
+		);
+	
+	pass *= 
+		testNumberParsing(
+			verbosity
+		);
+	
+	pass *= 
+		testArrayParsing(
+			verbosity
+		);
+	
+	pass *= 
+		testParameterOffsets(
+			verbosity
+		);
+	
+	pass *= 
+		testPerfectHash(
+			verbosity
+		);
+	
+	pass *= 
+		testConfigStats(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testSingleConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testSchemaReuse(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testDeclaredConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testArenaConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testParallelConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testMultiConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testVariableConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *= 
+		testReqirementConfig(
+			verbosity,
+			config_directory_name
+		);
+	
+	pass *=
+		testExtraParameterConfig(
+			verbosity,
+			config_directory_name
+		);
+        
+    pass *= 
+        testNameRequrimentConfig(
+            verbosity,
+            config_directory_name
+        ); 
+        
+    pass *= testConfigRequriment(
+            verbosity,
+            config_directory_name
+        );
+    
+    pass *=  
+        testNestedRequriments(
+            verbosity,
+            config_directory_name
+        ); 
+        
+    pass *=  
+        testConfigOrder(
+            verbosity,
+            config_directory_name
+        ); 
+        
+    pass *=  
+        testNestedConfig(
+            verbosity,
+            config_directory_name
+        ); 
+    
+    pass *=  
+        testMultiTypeConfig(
+            verbosity,
+            config_directory_name
+        ); 
+	
+	pass *=  
+		testComplexConfig(
+			verbosity,
+			config_directory_name
+		); 
+	
+	pass *=  
+		testConfigSnapshot(
+			verbosity,
+			config_directory_name
+		); 
+	
+	pass *=  
+		testConfigWatch(
+			verbosity,
+			config_directory_name
+		); 
+	
+	pass *=  
+		testConfigIndex(
 			verbosity,
 			config_directory_name
 		); 
@@ -0,0 +1,453 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <inttypes.h>
+
+#include "config.h"
+
+#ifndef SCHEMA_HEADER
+#error "Build with -DSCHEMA_HEADER='\"schema.h\"' -DSCHEMA_NAME=schema."
+#endif
+
+#include SCHEMA_HEADER
+
+#define STRINGIFY_(name) #name
+#define STRINGIFY(name)  STRINGIFY_(name)
+
+#define PERFECT_HASH_MAX_DISPLACEMENT (1u << 24)
+
+typedef struct PerfectHashBuild {
+
+	/**
+     * Structure to hold a perfect hash while it is searched for.
+     */
+
+	char     **keys;
+	int32_t    num_keys;
+	int32_t    num_buckets;
+	uint64_t   fingerprint;
+
+	uint32_t  *displacements;
+	int32_t   *slot_indices;
+
+} perfect_hash_build_s;
+
+bool buildPerfectHash(
+	      char                 **keys,
+	const int32_t                num_keys,
+	      perfect_hash_build_s  *ret_build
+	) {
+
+	/**
+     * Search a displacement for each bucket, largest bucket first, such that
+	 * every key lands in its own slot.
+     * @param
+     *           char                 **keys     : keys in index order.
+     *     const int32_t                num_keys : number of keys.
+     *           perfect_hash_build_s  *ret_build: built table.
+     * @see findPerfectHashIndex().
+     * @return bool success: false if keys repeat or no displacement fits.
+     */
+
+	const int32_t num_buckets = (num_keys + 1) / 2;
+
+	uint64_t *hashes        = malloc(sizeof(uint64_t) * (size_t) num_keys);
+	int32_t  *bucket_sizes  = calloc((size_t) num_buckets, sizeof(int32_t));
+	int32_t  *order         = malloc(sizeof(int32_t) * (size_t) num_buckets);
+	uint32_t *displacements = calloc((size_t) num_buckets, sizeof(uint32_t));
+	int32_t  *slot_indices  = malloc(sizeof(int32_t) * (size_t) num_keys);
+	uint32_t *trial_slots   = malloc(sizeof(uint32_t) * (size_t) num_keys);
+
+	bool success =
+		getPerfectHashFingerprint(keys, num_keys, &ret_build->fingerprint);
+
+	for (int32_t index = 0; (index < num_keys) && success; index++)
+	{
+		hashes[index] = hashString(keys[index], strlen(keys[index]));
+		bucket_sizes[getPerfectHashBucket(hashes[index], num_buckets)]++;
+		slot_indices[index] = -1;
+
+		for (int32_t other = 0; other < index; other++)
+		{
+			if (strcmp(keys[index], keys[other]) == 0)
+			{
+				fprintf(
+					stderr,
+					"buildPerfectHash: \nWarning! Key \"%s\" repeats.\n",
+					keys[index]
+				);
+				success = false;
+			}
+		}
+	}
+
+	for (int32_t bucket = 0; bucket < num_buckets; bucket++)
+	{
+		order[bucket] = bucket;
+	}
+	for (int32_t index = 1; index < num_buckets; index++)
+	{
+		const int32_t bucket = order[index];
+		int32_t       place  = index;
+		while ((place > 0)
+			&& (bucket_sizes[order[place - 1]] < bucket_sizes[bucket]))
+		{
+			order[place] = order[place - 1];
+			place--;
+		}
+		order[place] = bucket;
+	}
+
+	// Bucket of each key:
+	int32_t *key_buckets = malloc(sizeof(int32_t) * (size_t) num_keys);
+	for (int32_t index = 0; index < num_keys; index++)
+	{
+		key_buckets[index] =
+			(int32_t) getPerfectHashBucket(hashes[index], num_buckets);
+	}
+
+	for (int32_t rank = 0; (rank < num_buckets) && success; rank++)
+	{
+		const int32_t bucket = order[rank];
+		if (bucket_sizes[bucket] == 0)
+		{
+			break;
+		}
+
+		bool placed = false;
+		for (uint32_t displacement = 0;
+			(displacement < PERFECT_HASH_MAX_DISPLACEMENT) && !placed;
+			displacement++)
+		{
+			int32_t num_trial = 0;
+			placed = true;
+
+			for (int32_t index = 0; (index < num_keys) && placed; index++)
+			{
+				if (key_buckets[index] != bucket)
+				{
+					continue;
+				}
+
+				const uint32_t slot =
+					getPerfectHashSlot(hashes[index], displacement, num_keys);
+
+				placed = (slot_indices[slot] == -1);
+				for (int32_t trial = 0; (trial < num_trial) && placed; trial++)
+				{
+					placed = (trial_slots[trial] != slot);
+				}
+				trial_slots[num_trial++] = slot;
+			}
+
+			if (placed)
+			{
+				displacements[bucket] = displacement;
+				for (int32_t index = 0; index < num_keys; index++)
+				{
+					if (key_buckets[index] == bucket)
+					{
+						slot_indices[
+							getPerfectHashSlot(
+								hashes[index], displacement, num_keys
+							)
+						] = index;
+					}
+				}
+			}
+		}
+
+		success = placed;
+	}
+
+	free(hashes);
+	free(key_buckets);
+	free(bucket_sizes);
+	free(order);
+	free(trial_slots);
+
+	ret_build->keys          = keys;
+	ret_build->num_keys      = num_keys;
+	ret_build->num_buckets   = num_buckets;
+	ret_build->displacements = displacements;
+	ret_build->slot_indices  = slot_indices;
+
+	return success;
+}
+
+void printKeyArray(
+	      FILE    *file,
+	const char    *table_name,
+	const char    *suffix,
+	      char   **keys,
+	const int32_t *order,
+	const int32_t  num_keys
+	) {
+
+	fprintf(file, "static const char *%s_%s[] =\n{\n", table_name, suffix);
+	for (int32_t index = 0; index < num_keys; index++)
+	{
+		const char *key = keys[(order != NULL) ? order[index] : index];
+		fprintf(file, "\t\"");
+		for (const char *character = key; *character != '\0'; character++)
+		{
+			if ((*character == '"') || (*character == '\\'))
+			{
+				fputc('\\', file);
+			}
+			fputc(*character, file);
+		}
+		fprintf(file, "\"%s\n", (index + 1 < num_keys) ? "," : "");
+	}
+	fprintf(file, "};\n\n");
+}
+
+void printPerfectHash(
+	      FILE                 *file,
+	const char                 *table_name,
+	const perfect_hash_build_s  build
+	) {
+
+	printKeyArray(
+		file, table_name, "slot_keys", build.keys, build.slot_indices,
+		build.num_keys
+	);
+	printKeyArray(file, table_name, "keys", build.keys, NULL, build.num_keys);
+
+	fprintf(
+		file, "static const uint32_t %s_slot_lengths[] =\n{\n\t", table_name
+	);
+	for (int32_t slot = 0; slot < build.num_keys; slot++)
+	{
+		fprintf(
+			file, "%zu%s", strlen(build.keys[build.slot_indices[slot]]),
+			(slot + 1 < build.num_keys) ? ", " : "\n"
+		);
+	}
+	fprintf(
+		file, "};\n\nstatic const int32_t %s_slot_indices[] =\n{\n\t",
+		table_name
+	);
+	for (int32_t slot = 0; slot < build.num_keys; slot++)
+	{
+		fprintf(
+			file, "%i%s", build.slot_indices[slot],
+			(slot + 1 < build.num_keys) ? ", " : "\n"
+		);
+	}
+	fprintf(
+		file, "};\n\nstatic const uint32_t %s_displacements[] =\n{\n\t",
+		table_name
+	);
+	for (int32_t bucket = 0; bucket < build.num_buckets; bucket++)
+	{
+		fprintf(
+			file, "%" PRIu32 "%s", build.displacements[bucket],
+			(bucket + 1 < build.num_buckets) ? ", " : "\n"
+		);
+	}
+	fprintf(file, "};\n\n");
+}
+
+int32_t collectKeySets(
+	const schema_s  *schema,
+	      map_s     *maps,
+	      int32_t    num_maps
+	) {
+
+	/**
+     * Gather the name maps of every node of a compiled schema, so the keys
+	 * are exactly the ones createMapArena() will be given when parsing.
+     * @return int32_t num_maps: number of maps gathered so far.
+     */
+
+	maps[num_maps++] = schema->parameter_name_map;
+	maps[num_maps++] = schema->subconfig_name_map;
+
+	if (schema->default_subconfig != NULL)
+	{
+		num_maps = collectKeySets(schema->default_subconfig, maps, num_maps);
+	}
+	for (int32_t index = 0; index < schema->num_subconfigs; index++)
+	{
+		num_maps = collectKeySets(&schema->subconfigs[index], maps, num_maps);
+	}
+
+	return num_maps;
+}
+
+int32_t countSchemaNodes(
+	const schema_s *schema
+	) {
+
+	int32_t num_nodes = 1;
+
+	if (schema->default_subconfig != NULL)
+	{
+		num_nodes += countSchemaNodes(schema->default_subconfig);
+	}
+	for (int32_t index = 0; index < schema->num_subconfigs; index++)
+	{
+		num_nodes += countSchemaNodes(&schema->subconfigs[index]);
+	}
+
+	return num_nodes;
+}
+
+int main(
+	int    argc,
+	char **argv
+	) {
+
+	/**
+     * Emit a header of perfect hash tables for every name set of one schema
+	 * header. Usage: perfect_hash_generator <output header>.
+     */
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "Usage: %s <output header>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	#include SCHEMA_HEADER
+
+	const char *schema_name = STRINGIFY(SCHEMA_NAME);
+
+	arena_s  *arena  = createArena(0);
+	schema_s *schema = compileSchemaArena(loader_config, arena);
+
+	const int32_t num_slots = 2*countSchemaNodes(schema);
+	map_s        *maps      = malloc(sizeof(map_s) * (size_t) num_slots);
+	const int32_t num_maps  = collectKeySets(schema, maps, 0);
+
+	FILE *file = fopen(argv[1], "w");
+	if (file == NULL)
+	{
+		fprintf(
+			stderr, "%s: \nWarning! Could not open \"%s\".\n",
+			argv[0], argv[1]
+		);
+		return EXIT_FAILURE;
+	}
+
+	char guard[256];
+	snprintf(guard, sizeof(guard), "%s_HASH_H", schema_name);
+	for (char *character = guard; *character != '\0'; character++)
+	{
+		*character = (char) toupper(*character);
+	}
+
+	fprintf(
+		file,
+		"#ifndef %s\n#define %s\n\n"
+		"// Generated by src/perfect_hash_generator.c from %s, do not edit,\n"
+		"// rerun make perfect_hash after changing the schema.\n\n"
+		"#include \"io_tools/custom_types.h\"\n\n",
+		guard, guard, SCHEMA_HEADER
+	);
+
+	uint64_t *written     = malloc(sizeof(uint64_t) * (size_t) num_maps);
+	int32_t   num_written = 0;
+
+	for (int32_t index = 0; index < num_maps; index++)
+	{
+		perfect_hash_build_s build;
+		uint64_t             fingerprint = 0;
+
+		// Nodes sharing a name set share a table:
+		bool repeated = (maps[index].length == 0)
+			|| !getPerfectHashFingerprint(
+				maps[index].keys, maps[index].length, &fingerprint
+			);
+		for (int32_t other = 0; (other < num_written) && !repeated; other++)
+		{
+			repeated = (written[other] == fingerprint);
+		}
+		if (repeated)
+		{
+			continue;
+		}
+
+		if (!buildPerfectHash(maps[index].keys, maps[index].length, &build))
+		{
+			fprintf(
+				stderr,
+				"%s: \nWarning! No perfect hash for name set %i of %s, left to"
+				" the dynamic map.\n",
+				argv[0], index, schema_name
+			);
+		}
+		else
+		{
+			char table_name[256];
+			snprintf(
+				table_name, sizeof(table_name), "%s_hash_%i",
+				schema_name, num_written
+			);
+			printPerfectHash(file, table_name, build);
+			written[num_written++] = build.fingerprint;
+		}
+
+		free(build.displacements);
+		free(build.slot_indices);
+	}
+
+	if (num_written == 0)
+	{
+		fprintf(file, "#endif\n");
+		fclose(file);
+
+		free(written);
+		free(maps);
+		freeArena(arena);
+
+		return EXIT_SUCCESS;
+	}
+
+	fprintf(
+		file, "static const perfect_hash_s %s_hashes[] =\n{\n", schema_name
+	);
+	for (int32_t table = 0; table < num_written; table++)
+	{
+		fprintf(
+			file,
+			"\t{\n"
+			"\t\t.num_keys      = (int32_t) (sizeof(%s_hash_%i_keys)\n"
+			"\t\t\t/ sizeof(char*)),\n"
+			"\t\t.num_buckets   = (int32_t) (sizeof(%s_hash_%i_displacements)\n"
+			"\t\t\t/ sizeof(uint32_t)),\n"
+			"\t\t.fingerprint   = 0x%016" PRIx64 "ull,\n"
+			"\t\t.displacements = %s_hash_%i_displacements,\n"
+			"\t\t.slot_keys     = %s_hash_%i_slot_keys,\n"
+			"\t\t.slot_lengths  = %s_hash_%i_slot_lengths,\n"
+			"\t\t.slot_indices  = %s_hash_%i_slot_indices,\n"
+			"\t\t.keys          = %s_hash_%i_keys\n"
+			"\t}%s\n",
+			schema_name, table, schema_name, table, written[table],
+			schema_name, table, schema_name, table, schema_name, table,
+			schema_name, table, schema_name, table,
+			(table + 1 < num_written) ? "," : ""
+		);
+	}
+	fprintf(
+		file,
+		"};\n\n"
+		"__attribute__((constructor)) static void %s_registerHashes(void)\n{\n"
+		"\tregisterPerfectHashes(\n"
+		"\t\t%s_hashes,\n"
+		"\t\t(int32_t) (sizeof(%s_hashes) / sizeof(perfect_hash_s))\n"
+		"\t);\n}\n\n#endif\n",
+		schema_name, schema_name, schema_name
+	);
+
+	fclose(file);
+
+	free(written);
+	free(maps);
+	freeArena(arena);
+
+	return EXIT_SUCCESS;
+}
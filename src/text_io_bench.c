@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <inttypes.h>
+
+#include "text.h"
+
+double benchmarkWrite(
+	const char    *name,
+	const bool     buffered,
+	const float   *data,
+	const char    *file_name,
+	const int32_t  mode,
+	const int32_t  num_cols,
+	const int32_t  num_lines
+	) {
+	
+	/**
+     * Time one write of the entered matrix and print its throughput.
+     * @return double seconds: wall time of the write.
+     */
+	
+	const double start = omp_get_wtime();
+	
+	const bool success = buffered
+		? writeFileDouble(
+			data, file_name, mode, 0, ",", num_cols, num_lines, 0, 0
+		)
+		: writeFileDoubleStream(
+			data, file_name, mode, 0, ",", num_cols, num_lines, 0, 0
+		);
+	
+	const double seconds = omp_get_wtime() - start;
+	
+	struct stat file_stat;
+	const double bytes = 
+		(success && (stat(file_name, &file_stat) == 0)) 
+		? (double) file_stat.st_size 
+		: 0.0;
+	
+	printf(
+		"%-24s mode %i: %9.1f MB in %7.3f s, %6.3f GB/s, %7.1f M values/s\n",
+		name, 
+		mode, 
+		bytes / 1.0e6, 
+		seconds, 
+		bytes / seconds / 1.0e9,
+		(double) num_cols * num_lines / seconds / 1.0e6
+	);
+	
+	remove(file_name);
+	
+	return seconds;
+}
+
+int main(
+	int    argc,
+	char **argv
+	) {
+	
+	// Usage: text_io_bench [num_lines] [num_cols] [file_name]
+	const int32_t  num_lines = (argc > 1) ? atoi(argv[1]) : 1000000;
+	const int32_t  num_cols  = (argc > 2) ? atoi(argv[2]) : 10;
+	const char    *file_name = (argc > 3) ? argv[3] : "./text_io_bench.txt";
+	
+	const size_t num_elements = (size_t) num_lines * (size_t) num_cols;
+	
+	// Detector like values over several decades:
+	float *data = malloc(sizeof(float) * num_elements);
+	uint32_t state = 12345;
+	for (size_t index = 0; index < num_elements; index++)
+	{
+		state = state * 1664525u + 1013904223u;
+		data[index] = 
+			(float) (state >> 8) * 1.0e-4f * ((index % 3 == 0) ? -1.0f : 1.0f);
+	}
+	
+	printf(
+		"Writing %i x %i matrix, %zu values: \n", 
+		num_lines, num_cols, num_elements
+	);
+	
+	for (int32_t mode = 0; mode < 2; mode++)
+	{
+		const double stream_seconds = 
+			benchmarkWrite(
+				"fprintf", false, data, file_name, mode, num_cols, num_lines
+			);
+		const double buffered_seconds = 
+			benchmarkWrite(
+				"buffered shortest", true, data, file_name, mode, num_cols, 
+				num_lines
+			);
+		
+		printf(
+			"Speed up mode %i: %.2fx \n", 
+			mode, 
+			stream_seconds / buffered_seconds
+		);
+	}
+	
+	free(data);
+	
+	return 0;
+}
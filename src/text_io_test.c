@@ -6,8 +6,21 @@
 
 #include "test.h"
 #include "text.h"
+#include "text_cache.h"
+#include "text_stream.h"
+#include "async_io.h"
 #include "console.h"
 
+bool countStreamRows(
+	const delimited_batch_s *batch,
+	      void              *user_data
+	) {
+	
+	(void) user_data;
+	
+	return batch->num_rows > 0;
+}
+
 int main() {
 	
 	const int32_t verbosity = 3;
@@ -37,5 +50,669 @@ int main() {
 	remove(directory);
 	remove(newPath(directory).directory);
 	
+	// Mapped reader must match the line by line reader, across chunk
+	// boundaries, short lines, repeated delimiters and a missing final
+	// new line:
+	const char *delimited_path = "./delimited_test.txt";
+	
+	FILE *delimited_file = fopen(delimited_path, "w");
+	fprintf(delimited_file, "header line\n");
+	for (int32_t line = 0; line < 40000; line++)
+	{
+		if (line % 997 == 0)
+		{
+			fprintf(delimited_file, "%d\n", line);
+		}
+		else
+		{
+			fprintf(
+				delimited_file, "%d, %.7g,,%.3e\t%d,\r\n", 
+				line, (float) line*0.1f, (float) line*-3.5e-7f, line % 7
+			);
+		}
+	}
+	fprintf(delimited_file, "1,2,3,4,5");
+	fclose(delimited_file);
+	
+	bool delimited_pass = true;
+	for (int32_t start_col = 0; start_col < 3; start_col++)
+	{
+		const int32_t num_cols = 3;
+		
+		float   *row_data    = NULL, *column_data  = NULL, *stream_data  = NULL;
+		int32_t  row_lines   = 0   ,  column_lines = 0   ,  stream_lines = 0;
+		
+		delimited_pass = delimited_pass &&
+			readFileDouble(
+				delimited_path, 0, ", \t", num_cols, 1, start_col, 
+				&row_data, &row_lines
+			);
+		delimited_pass = delimited_pass &&
+			readFileDouble(
+				delimited_path, 1, ", \t", num_cols, 1, start_col, 
+				&column_data, &column_lines
+			);
+		delimited_pass = delimited_pass &&
+			readFileDoubleStream(
+				delimited_path, 0, ", \t", num_cols, 1, start_col, 
+				&stream_data, &stream_lines
+			);
+		
+		delimited_pass = delimited_pass && (row_lines == 40001);
+		delimited_pass = delimited_pass && (row_lines == stream_lines);
+		delimited_pass = delimited_pass && (row_lines == column_lines);
+		
+		// Column first output is strided by every line of the file:
+		for (int32_t line = 0; line < row_lines; line++)
+		{
+			for (int32_t col = 0; col < num_cols; col++)
+			{
+				const float value = row_data[line*num_cols + col];
+				
+				delimited_pass = delimited_pass && 
+					(value == stream_data[line*num_cols + col]);
+				delimited_pass = delimited_pass && 
+					(value == column_data[col*(row_lines + 1) + line]);
+			}
+		}
+		
+		// Line aligned ranges on several threads must give the same output:
+		for (int32_t mode = 0; mode < 2; mode++)
+		{
+			float   *serial_data    = NULL, *parallel_data  = NULL;
+			int32_t  serial_lines   = 0   ,  parallel_lines = 0;
+			
+			delimited_pass = delimited_pass &&
+				readFileDouble(
+					delimited_path, mode, ", \t", num_cols, 1, start_col, 
+					&serial_data, &serial_lines
+				);
+			delimited_pass = delimited_pass &&
+				readFileDoubleParallel(
+					delimited_path, mode, ", \t", num_cols, 1, start_col, 3,
+					&parallel_data, &parallel_lines
+				);
+			
+			delimited_pass = delimited_pass && (serial_lines == parallel_lines);
+			delimited_pass = delimited_pass && 
+				!memcmp(
+					serial_data, parallel_data, 
+					sizeof(float) * (size_t) ((serial_lines + 1)*num_cols)
+				);
+			
+			free(serial_data);
+			free(parallel_data);
+		}
+		
+		free(row_data);
+		free(column_data);
+		free(stream_data);
+	}
+	remove(delimited_path);
+	
+	pass *= delimited_pass;
+	
+	printTestResult(pass, "Delimited read test");
+	
+	// Shortest float text must read back exactly, through either layout:
+	const int32_t write_lines = 5000;
+	const int32_t write_cols  = 4;
+	
+	float *written = malloc(sizeof(float) * (size_t) (write_lines*write_cols));
+	uint32_t bits = 0x3F800000;
+	for (int32_t index = 0; index < write_lines*write_cols; index++)
+	{
+		do
+		{
+			bits = bits * 1664525u + 1013904223u;
+		}
+		while (((bits & 0x7F800000u) == 0x7F800000u) || !(bits & 0x7F800000u));
+		
+		memcpy(&written[index], &bits, sizeof(float));
+	}
+	
+	bool write_pass = true;
+	for (int32_t mode = 0; mode < 2; mode++)
+	{
+		write_pass = write_pass &&
+			writeFileDouble(
+				written, delimited_path, mode, 20, ",", write_cols, write_lines,
+				2, 3
+			);
+		
+		float   *read_data  = NULL;
+		int32_t  read_lines = 0;
+		
+		write_pass = write_pass &&
+			readFileDouble(
+				delimited_path, 0, ", ", write_cols, 2, 0, &read_data, 
+				&read_lines
+			);
+		write_pass = write_pass && (read_lines == write_lines);
+		
+		for (int32_t line = 0; write_pass && (line < write_lines); line++)
+		{
+			for (int32_t col = 0; col < write_cols; col++)
+			{
+				const float expected = (mode == 0)
+					? written[line*write_cols + col]
+					: written[col*write_lines + line];
+				
+				write_pass = write_pass && 
+					!memcmp(
+						&read_data[line*write_cols + col], &expected, 
+						sizeof(float)
+					);
+			}
+		}
+		
+		free(read_data);
+	}
+	remove(delimited_path);
+	free(written);
+	
+	// A failed write must report its own errno, not a later one:
+	buffered_writer_s full_writer;
+	if (openBufferedWriter(0, "/dev/full", 16, &full_writer))
+	{
+		writeBufferedBytes(&full_writer, "0123456789abcdefghij", 20);
+		errno = 0;
+		write_pass = write_pass && !closeBufferedWriter(&full_writer);
+		write_pass = write_pass && (full_writer.error == ENOSPC);
+	}
+	
+	pass *= write_pass;
+	
+	printTestResult(pass, "Delimited write test");
+	
+	// Second read must come from the sidecar, and match the parsed data:
+	const char *cache_path = "./cache_test.txt";
+	
+	FILE *cache_file = fopen(cache_path, "w");
+	for (int32_t line = 0; line < 1000; line++)
+	{
+		fprintf(cache_file, "%d\t%d.5\t%de-3\n", line, -line, line*7);
+	}
+	fclose(cache_file);
+	
+	char cache_sidecar[256];
+	snprintf(
+		cache_sidecar, sizeof(cache_sidecar), "%s%s", cache_path, 
+		FLOAT_CACHE_EXTENSION
+	);
+	remove(cache_sidecar);
+	
+	bool cache_pass = true;
+	for (int32_t mode = 0; mode < 2; mode++)
+	{
+		float_cache_s parsed, cached;
+		
+		cache_pass = cache_pass &&
+			readFileDoubleCached(
+				verbosity, cache_path, mode, "\t", 2, 3, 1, &parsed
+			);
+		cache_pass = cache_pass &&
+			readFileDoubleCached(
+				verbosity, cache_path, mode, "\t", 2, 3, 1, &cached
+			);
+		
+		const size_t num_elements = 
+			getFloatCacheElements(mode, 2, 3, parsed.lines_read);
+		
+		cache_pass = cache_pass && !parsed.is_cached && cached.is_cached;
+		cache_pass = cache_pass && (parsed.lines_read == 997);
+		cache_pass = cache_pass && (cached.lines_read == parsed.lines_read);
+		cache_pass = cache_pass && (cached.num_lines  == parsed.num_lines);
+		cache_pass = cache_pass && 
+			((uintptr_t) cached.data % FLOAT_CACHE_ALIGNMENT == 0);
+		cache_pass = cache_pass && 
+			!memcmp(parsed.data, cached.data, sizeof(float) * num_elements);
+		
+		freeFloatCache(&parsed);
+		freeFloatCache(&cached);
+	}
+	
+	// Changing the arguments or touching the text invalidates the sidecar:
+	float_cache_s stale;
+	cache_pass = cache_pass &&
+		readFileDoubleCached(verbosity, cache_path, 1, "\t", 3, 3, 1, &stale);
+	cache_pass = cache_pass && !stale.is_cached;
+	freeFloatCache(&stale);
+	
+	const struct timespec times[2] = {{0, UTIME_OMIT}, {12345, 0}};
+	utimensat(AT_FDCWD, cache_path, times, 0);
+	
+	cache_pass = cache_pass &&
+		readFileDoubleCached(verbosity, cache_path, 1, "\t", 3, 3, 1, &stale);
+	cache_pass = cache_pass && !stale.is_cached;
+	freeFloatCache(&stale);
+	
+	remove(cache_path);
+	remove(cache_sidecar);
+	
+	pass *= cache_pass;
+	
+	printTestResult(pass, "Float cache test");
+	
+	// Rows streamed through a small ring, with lines longer than a segment,
+	// must match a whole file read:
+	const char *stream_path = "./stream_test.txt";
+	
+	FILE *stream_file = fopen(stream_path, "w");
+	fprintf(stream_file, "skipped\n");
+	for (int32_t line = 0; line < 20000; line++)
+	{
+		fprintf(stream_file, "%d,%g,%d", line, (float) line*0.25f, -line);
+		if (line % 5000 == 0)
+		{
+			for (int32_t pad = 0; pad < 3000; pad++)
+			{
+				fprintf(stream_file, ",%d", pad);
+			}
+		}
+		fprintf(stream_file, "\n");
+	}
+	fprintf(stream_file, "7,8,9");
+	fclose(stream_file);
+	
+	bool stream_pass = true;
+	
+	float   *whole_data  = NULL;
+	int32_t  whole_lines = 0;
+	stream_pass = stream_pass && 
+		readFileDouble(stream_path, 0, ",", 3, 1, 0, &whole_data, &whole_lines);
+	
+	for (int32_t mode = 0; mode < 2; mode++)
+	{
+		delimited_stream_s stream;
+		stream_pass = stream_pass &&
+			openDelimitedStream(
+				verbosity, stream_path, mode, ",", 3, 1, 0, 4096, 3, &stream
+			);
+		
+		int64_t           next_row = 0;
+		delimited_batch_s batch;
+		while (stream_pass && nextDelimitedBatch(&stream, &batch))
+		{
+			stream_pass = stream_pass && (batch.first_row == next_row);
+			
+			for (int32_t row = 0; row < batch.num_rows; row++)
+			{
+				for (int32_t col = 0; col < 3; col++)
+				{
+					const float value = (mode == 0)
+						? batch.data[row*3 + col]
+						: batch.data[col*batch.num_rows + row];
+					
+					stream_pass = stream_pass && 
+						(value == whole_data[(next_row + row)*3 + col]);
+				}
+			}
+			next_row += batch.num_rows;
+		}
+		
+		stream_pass = stream_pass && (next_row == whole_lines);
+		stream_pass = stream_pass && (stream.stats.lines_processed == 20002);
+		stream_pass = stream_pass && 
+			(stream.stats.bytes_processed == stream.stats.bytes_read);
+		
+		closeDelimitedStream(&stream);
+	}
+	
+	delimited_stream_stats_s stream_stats;
+	stream_pass = stream_pass &&
+		streamFileDouble(
+			verbosity, stream_path, 0, ",", 3, 1, 0, countStreamRows, 
+			NULL, &stream_stats
+		);
+	stream_pass = stream_pass && (stream_stats.rows_delivered == whole_lines);
+	
+	free(whole_data);
+	remove(stream_path);
+	
+	// Every line carried over is longer than the two segment ring:
+	stream_file = fopen(stream_path, "w");
+	for (int32_t line = 0; line < 50; line++)
+	{
+		fprintf(stream_file, "%d", line);
+		for (int32_t col = 1; col < 400; col++)
+		{
+			fprintf(stream_file, ",%d", line + col);
+		}
+		fprintf(stream_file, "\n");
+	}
+	fclose(stream_file);
+	
+	delimited_stream_s long_stream;
+	stream_pass = stream_pass &&
+		openDelimitedStream(
+			verbosity, stream_path, 0, ",", 3, 0, 0, 256, 2, &long_stream
+		);
+	
+	int64_t           long_rows = 0;
+	delimited_batch_s long_batch;
+	while (stream_pass && nextDelimitedBatch(&long_stream, &long_batch))
+	{
+		for (int32_t row = 0; row < long_batch.num_rows; row++)
+		{
+			for (int32_t col = 0; col < 3; col++)
+			{
+				stream_pass = stream_pass && 
+					(long_batch.data[row*3 + col] 
+					 == (float) (long_rows + row + col));
+			}
+		}
+		long_rows += long_batch.num_rows;
+	}
+	stream_pass = stream_pass && (long_rows == 50);
+	
+	closeDelimitedStream(&long_stream);
+	remove(stream_path);
+	
+	pass *= stream_pass;
+	
+	printTestResult(pass, "Delimited stream test");
+	
+	// Blocks read ahead by either backend must reassemble the file, with a 
+	// short final block:
+	const char   *async_path   = "./async_test.bin";
+	const size_t  async_length = 100000;
+	
+	char *async_expected = malloc(async_length);
+	for (size_t byte = 0; byte < async_length; byte++)
+	{
+		async_expected[byte] = (char) ((byte*7919) % 251);
+	}
+	
+	FILE *async_file = fopen(async_path, "wb");
+	fwrite(async_expected, 1, async_length, async_file);
+	fclose(async_file);
+	
+	bool async_pass = true;
+	
+	const async_backend_e backends[2] = {async_uring_e, async_thread_e};
+	for (int32_t backend = 0; backend < 2; backend++)
+	{
+		async_reader_s reader;
+		async_pass = async_pass &&
+			openAsyncReader(
+				verbosity, async_path, backends[backend], 4096, 3, &reader
+			);
+		
+		size_t      total = 0;
+		size_t      block_length;
+		const char *block;
+		while (
+			   async_pass 
+			&& ((block = nextAsyncBlock(&reader, &block_length)) != NULL)
+		) {
+			async_pass = async_pass && (total + block_length <= async_length);
+			async_pass = async_pass && 
+				!memcmp(block, &async_expected[total], block_length);
+			total += block_length;
+		}
+		
+		printf(
+			"Async backend %s: %" PRIu64 " bytes, %" PRId64 " stalls.\n", 
+			asyncBackendToString(reader.backend), reader.bytes_read, 
+			reader.num_stalls
+		);
+		
+		async_pass = async_pass && (total == async_length) && !reader.failed;
+		closeAsyncReader(&reader);
+	}
+	
+	size_t  whole_length   = 0;
+	char   *whole_contents = readFileAsync(verbosity, async_path, &whole_length);
+	async_pass = async_pass && (whole_contents != NULL);
+	async_pass = async_pass && (whole_length == async_length);
+	async_pass = async_pass && 
+		!memcmp(whole_contents, async_expected, async_length);
+	
+	free(whole_contents);
+	free(async_expected);
+	remove(async_path);
+	
+	// Files reporting no size still have contents:
+	size_t  proc_length   = 0;
+	char   *proc_contents = 
+		readFileAsync(verbosity, "/proc/self/status", &proc_length);
+	async_pass = async_pass && (proc_contents != NULL);
+	async_pass = async_pass && (proc_length > 5);
+	async_pass = async_pass && !strncmp(proc_contents, "Name:", 5);
+	free(proc_contents);
+	
+	pass *= async_pass;
+	
+	printTestResult(pass, "Async read test");
+	
+	// Histogram buckets must stay within a sub-bucket of the value:
+	bool timer_pass = true;
+	
+	for (int64_t value = 1; value < ((int64_t) 1 << 40); value = value*3 + 1)
+	{
+		const int64_t estimate = getTimerBucketValue(getTimerBucket(value));
+		const int64_t error    = (estimate > value) 
+			? estimate - value 
+			: value - estimate;
+		
+		timer_pass = timer_pass && (error*TIMER_SUB_BUCKETS <= value);
+	}
+	
+	// Known laps of 1 to 1000 us, in a scrambled order:
+	timer_profile_s profile = createTimerProfile();
+	
+	const int32_t known_scope = getTimerScope(&profile, "known laps");
+	for (int64_t lap = 0; lap < 1000; lap++)
+	{
+		addTimerSample(&profile, known_scope, ((lap*7) % 1000 + 1)*1000);
+	}
+	
+	const timer_scope_s *known = &profile.scopes[known_scope];
+	const int64_t        p50   = getTimerPercentile(known, 50.0);
+	const int64_t        p99   = getTimerPercentile(known, 99.0);
+	
+	timer_pass = timer_pass && (known->count    == 1000);
+	timer_pass = timer_pass && (known->min_ns   == 1000);
+	timer_pass = timer_pass && (known->max_ns   == 1000000);
+	timer_pass = timer_pass && (known->total_ns == 500500000);
+	timer_pass = timer_pass && 
+		(llabs(p50 - 500000)*TIMER_SUB_BUCKETS <= 500000);
+	timer_pass = timer_pass && 
+		(llabs(p99 - 990000)*TIMER_SUB_BUCKETS <= 990000);
+	
+	// Nested scopes, with the inner one lapped each iteration:
+	const int32_t outer_scope = getTimerScope(&profile, "outer");
+	const int32_t inner_scope = getTimerScope(&profile, "inner");
+	
+	for (int32_t repeat = 0; repeat < 3; repeat++)
+	{
+		beginTimerScope(&profile, outer_scope);
+		beginTimerScope(&profile, inner_scope);
+		
+		volatile double sum = 0.0;
+		for (int32_t index = 0; index < 10; index++)
+		{
+			for (int32_t step = 0; step < 1000; step++)
+			{
+				sum += (double) step;
+			}
+			lapTimerScope(&profile);
+		}
+		
+		timer_pass = timer_pass && (endTimerScope(&profile) >= 0);
+		timer_pass = timer_pass && (endTimerScope(&profile) >  0);
+	}
+	
+	const timer_scope_s *outer = &profile.scopes[outer_scope];
+	const timer_scope_s *inner = &profile.scopes[inner_scope];
+	
+	timer_pass = timer_pass && (profile.depth  == 0);
+	timer_pass = timer_pass && (outer->count   == 3);
+	timer_pass = timer_pass && (outer->depth   == 0);
+	timer_pass = timer_pass && (inner->count   == 33);
+	timer_pass = timer_pass && (inner->depth   == 1);
+	timer_pass = timer_pass && (inner->parent  == outer_scope);
+	timer_pass = timer_pass && (inner->total_ns <= outer->total_ns);
+	timer_pass = timer_pass && (getTimerScope(&profile, "inner") == inner_scope);
+	
+	printTimerProfile(&profile, "Timer Profile");
+	freeTimerProfile(&profile);
+	
+	timer_s timer;
+	start_timer("test", &timer);
+	timer_pass = timer_pass && (stop_timer_ns(&timer) >= 0);
+	timer_pass = timer_pass && (stop_timer(&timer) >= 0.0f);
+	
+	pass *= timer_pass;
+	
+	printTestResult(pass, "Timer profile test");
+	
+	// Ticks from every thread must all count, with whole lines drawn:
+	const int64_t num_progress_ticks = 200000;
+	
+	progress_s progress;
+	setupProgress(&progress, num_progress_ticks, 40, 64, 0);
+	progress.stream = tmpfile();
+	
+	#pragma omp parallel for
+	for (int64_t tick = 0; tick < num_progress_ticks; tick++)
+	{
+		tickProgress(&progress);
+	}
+	
+	finishProgress(&progress);
+	
+	bool progress_pass = 
+		   (progress.ticks == num_progress_ticks)
+		&& (progress.num_renders >= 1)
+		&& (progress.num_renders <= num_progress_ticks/64 + 1);
+	
+	const long progress_length = ftell(progress.stream);
+	char      *progress_output = calloc((size_t) progress_length + 1, 1);
+	
+	rewind(progress.stream);
+	progress_pass = progress_pass && 
+		(fread(progress_output, 1, (size_t) progress_length, progress.stream)
+			== (size_t) progress_length);
+	fclose(progress.stream);
+	
+	int32_t num_lines = 0;
+	for (char *line = strchr(progress_output, '\r'); line != NULL; 
+		line = strchr(line + 1, '\r')
+	) {
+		progress_pass = progress_pass && 
+			!strncmp(line + 1, "Progress: [", 11);
+		num_lines++;
+	}
+	
+	progress_pass = progress_pass && (num_lines == progress.num_renders);
+	progress_pass = progress_pass && 
+		(strstr(progress_output, "] 100.00%.") != NULL);
+	
+	free(progress_output);
+	
+	pass *= progress_pass;
+	
+	printTestResult(pass, "Parallel progress test");
+	
+	// Streamed table sized from every row must match the whole table, and 
+	// a fixed width table must keep over long cells whole:
+	const int32_t table_rows    = 50000;
+	const int32_t table_columns = 4;
+	
+	const table_column_s table_headers[] = {
+		{"Name" , 0, 1},
+		{"Index", 0, 1},
+		{"Value", 3, 0},
+		{"Flag" , 0, 0}
+	};
+	
+	uni_s *table_cells = 
+		malloc(sizeof(uni_s) * (size_t) (table_rows*table_columns));
+	
+	for (int32_t row = 0; row < table_rows; row++)
+	{
+		uni_s *cell = &table_cells[row*table_columns];
+		
+		cell[0].value.s = (row % 7) ? "row" : "";
+		cell[0].type    = string_e;
+		cell[1].value.i = row*7;
+		cell[1].type    = int_e;
+		cell[2].value.f = (float) row * 0.5f;
+		cell[2].type    = float_e;
+		cell[3].value.b = (row % 2);
+		cell[3].type    = bool_e;
+	}
+	
+	FILE *whole_table = tmpfile();
+	fprintTable(whole_table, (table_s) {
+		table_rows, table_columns, "Table", table_cells, table_headers
+	});
+	
+	FILE *streamed_table = tmpfile();
+	table_stream_s table_stream = 
+		startTableStream(
+			"Table", table_columns, table_headers, NULL, 
+			table_cells, table_rows, streamed_table
+		);
+	for (int32_t row = 0; row < table_rows; row++)
+	{
+		streamTableRow(&table_stream, &table_cells[row*table_columns]);
+	}
+	endTableStream(&table_stream);
+	
+	const long whole_table_length    = ftell(whole_table);
+	const long streamed_table_length = ftell(streamed_table);
+	
+	bool table_pass = 
+		   (whole_table_length > 0) 
+		&& (whole_table_length == streamed_table_length);
+	
+	char *whole_text    = calloc((size_t) whole_table_length + 1, 1);
+	char *streamed_text = calloc((size_t) streamed_table_length + 1, 1);
+	rewind(whole_table);
+	rewind(streamed_table);
+	table_pass = table_pass && 
+		(fread(whole_text, 1, (size_t) whole_table_length, whole_table) 
+			== (size_t) whole_table_length);
+	table_pass = table_pass && 
+		(fread(
+			streamed_text, 1, (size_t) streamed_table_length, streamed_table
+		) == (size_t) streamed_table_length);
+	table_pass = table_pass && !strcmp(whole_text, streamed_text);
+	table_pass = table_pass && (strstr(whole_text, "│ 24999.500 │") != NULL);
+	
+	fclose(whole_table);
+	fclose(streamed_table);
+	free(whole_text);
+	free(streamed_text);
+	
+	const int32_t fixed_widths[] = {6, 2, 4, 1};
+	char         *fixed_text     = NULL;
+	size_t        fixed_length   = 0;
+	FILE         *fixed_table    = open_memstream(&fixed_text, &fixed_length);
+	
+	table_stream = 
+		startTableStream(
+			"Fixed", table_columns, table_headers, fixed_widths, 
+			NULL, 0, fixed_table
+		);
+	streamTableRow(
+		&table_stream, &table_cells[(table_rows - 1)*table_columns]
+	);
+	endTableStream(&table_stream);
+	fclose(fixed_table);
+	
+	table_pass = table_pass && (strstr(fixed_text, "║    row ║") != NULL);
+	table_pass = table_pass && (strstr(fixed_text, " 349993 ") != NULL);
+	
+	free(fixed_text);
+	free(table_cells);
+	
+	pass *= table_pass;
+	
+	printTestResult(pass, "Table render test");
+	
     return 0;
 }
\ No newline at end of file